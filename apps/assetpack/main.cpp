@@ -0,0 +1,45 @@
+#include "tria/asset/archive.hpp"
+#include <cstdio>
+#include <exception>
+#include <string_view>
+
+/*
+ * Tool for packing a directory of assets into a single archive file.
+ *
+ * Usage: tria_assetpack <input-dir> <output> [--lz]
+ * - '--lz' compresses the entries that benefit from it, compressed entries cannot be memory mapped
+ *   so they trade load time for a smaller archive.
+ * - Use the archive as the root path of the database instead of the directory, for example:
+ *   $ tria_assetpack sandbox_data sandbox_data.tpak
+ */
+
+using namespace std::literals;
+using namespace tria;
+
+namespace {
+
+auto printUsage() { std::fprintf(stderr, "Usage: tria_assetpack <input-dir> <output> [--lz]\n"); }
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 3 || argc > 4 || (argc == 4 && argv[3] != "--lz"sv)) {
+    printUsage();
+    return 1;
+  }
+  const auto compression =
+      argc == 4 ? asset::ArchiveCompression::Lz : asset::ArchiveCompression::None;
+  try {
+    const auto stats = asset::packArchive(argv[1], argv[2], compression);
+    std::printf(
+        "Packed %u assets (%u compressed): %llu bytes -> %llu bytes\n",
+        stats.entryCount,
+        stats.compressedCount,
+        static_cast<unsigned long long>(stats.srcSize),
+        static_cast<unsigned long long>(stats.archiveSize));
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
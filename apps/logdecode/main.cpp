@@ -0,0 +1,109 @@
+#include "tria/log/bin_reader.hpp"
+#include "tria/log/ring_reader.hpp"
+#include "tria/log/sink.hpp"
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <string_view>
+#include <thread>
+
+/*
+ * Tool for decoding binary logs (as written by the binary log sink).
+ *
+ * Usage: tria_logdecode <input> [--json | --pretty] [--ring [--follow]] [output]
+ * - Defaults to pretty printing.
+ * - Without an output path the decoded log is written to the console.
+ * - '--ring' reads a shared ring log (as written by the shared ring sink), with '--follow' new
+ *   messages keep being decoded until the writer is closed.
+ */
+
+using namespace std::literals;
+using namespace tria;
+
+namespace {
+
+enum class OutputFormat {
+  Pretty,
+  Json,
+};
+
+auto printUsage() {
+  std::fprintf(
+      stderr, "Usage: tria_logdecode <input> [--json | --pretty] [--ring [--follow]] [output]\n");
+}
+
+// Interval at which a followed ring log is checked for new messages.
+constexpr auto g_followInterval = std::chrono::milliseconds{10};
+
+auto readRingLog(const char* inputPath, log::Sink* sink, bool follow) {
+  auto reader = log::RingReader{inputPath};
+  while (true) {
+    // Check if the writer was closed before polling, so no messages are missed.
+    const auto closed = reader.isWriterClosed();
+    reader.poll(sink);
+    if (!follow || closed) {
+      break;
+    }
+    std::this_thread::sleep_for(g_followInterval);
+  }
+  if (reader.getLostCount() != 0U) {
+    std::fprintf(
+        stderr, "Lost messages: %llu\n", static_cast<unsigned long long>(reader.getLostCount()));
+  }
+}
+
+[[nodiscard]] auto makeSink(OutputFormat format, const char* outputPath) -> log::SinkUnique {
+  switch (format) {
+  case OutputFormat::Json:
+    return outputPath ? log::makeFileJsonSink(outputPath) : log::makeConsoleJsonSink();
+  case OutputFormat::Pretty:
+    break;
+  }
+  return outputPath ? log::makeFilePrettySink(outputPath) : log::makeConsolePrettySink();
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  const char* inputPath  = nullptr;
+  const char* outputPath = nullptr;
+  auto format            = OutputFormat::Pretty;
+  auto ring              = false;
+  auto follow            = false;
+  for (auto i = 1; i < argc; ++i) {
+    const auto arg = std::string_view{argv[i]};
+    if (arg == "--json"sv) {
+      format = OutputFormat::Json;
+    } else if (arg == "--pretty"sv) {
+      format = OutputFormat::Pretty;
+    } else if (arg == "--ring"sv) {
+      ring = true;
+    } else if (arg == "--follow"sv) {
+      follow = true;
+    } else if (!inputPath) {
+      inputPath = argv[i];
+    } else if (!outputPath) {
+      outputPath = argv[i];
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+  if (!inputPath || (follow && !ring)) {
+    printUsage();
+    return 1;
+  }
+
+  try {
+    auto sink = makeSink(format, outputPath);
+    if (ring) {
+      readRingLog(inputPath, sink.get(), follow);
+    } else {
+      log::readBinaryLog(inputPath, sink.get());
+    }
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include "tria/log/decompress.hpp"
+#include <cstdio>
+#include <exception>
+
+/*
+ * Tool for decompressing logs (as written by file sinks with 'Compression::Lz').
+ *
+ * Usage: tria_logdecompress <input> [output]
+ * - Without an output path the decompressed log is written to the console, so existing tools can
+ *   be used on compressed logs, for example:
+ *   $ tria_logdecompress app.log.tlz | jq '.message'
+ */
+
+using namespace tria;
+
+namespace {
+
+auto printUsage() { std::fprintf(stderr, "Usage: tria_logdecompress <input> [output]\n"); }
+
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 2 || argc > 3) {
+    printUsage();
+    return 1;
+  }
+  const char* inputPath  = argv[1];
+  const char* outputPath = argc == 3 ? argv[2] : nullptr;
+
+  std::FILE* output = stdout;
+  if (outputPath) {
+    output = std::fopen(outputPath, "wb");
+    if (!output) {
+      std::fprintf(stderr, "Failed to open output file: %s\n", outputPath);
+      return 1;
+    }
+  }
+
+  auto result = 0;
+  try {
+    log::decompressLog(inputPath, output);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    result = 1;
+  }
+  if (outputPath) {
+    std::fclose(output);
+  } else {
+    std::fflush(output);
+  }
+  return result;
+}
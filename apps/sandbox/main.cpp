@@ -18,14 +18,14 @@ using namespace tria::math;
 using namespace std::chrono;
 
 struct Obj final {
-  const asset::Graphic* graphic;
+  asset::AssetHandle graphic;
   Vec3f pos;
   Quatf orient;
   float scale;
   float rotSpeed;
 
-  Obj(const asset::Graphic* graphic, Vec3f pos, Quatf orient, float scale, float rotSpeed) :
-      graphic{graphic}, pos{pos}, orient{orient}, scale{scale}, rotSpeed{rotSpeed} {}
+  Obj(asset::AssetHandle graphic, Vec3f pos, Quatf orient, float scale, float rotSpeed) :
+      graphic{std::move(graphic)}, pos{pos}, orient{orient}, scale{scale}, rotSpeed{rotSpeed} {}
 };
 
 [[nodiscard]] auto trsMat4f(Vec3f trans, Quatf rot, float scale) noexcept {
@@ -42,33 +42,27 @@ auto runApp(pal::Platform& platform, asset::Database& db, gfx::Context& gfx) {
       gfx::DepthMode::Enable,
       gfx::noneClearMask());
 
+  // Load the graphics (and the assets they depend on) in parallel.
+  auto graphics = db.preload({
+      "graphics/corset.gfx",
+      "graphics/bunny.gfx",
+      "graphics/cube.gfx",
+      "graphics/wirecube.gfx",
+      "graphics/head.gfx",
+  });
+  const auto getGraphic = [&graphics](size_t index) { return graphics[index].get(); };
+
   auto objs = std::vector<Obj>{
-      {db.get("graphics/corset.gfx")->downcast<asset::Graphic>(),
-       Vec3f{-5.0, 0.f, 0},
-       identityQuatf(),
-       1.f,
-       .2f},
-      {db.get("graphics/bunny.gfx")->downcast<asset::Graphic>(),
-       Vec3f{-2.5, 0, 0},
-       angleAxisQuatf(dir3d::up(), math::pi<float>),
-       1.f,
-       0.f},
-      {db.get("graphics/cube.gfx")->downcast<asset::Graphic>(),
-       Vec3f{0.0, .5f, 0},
-       identityQuatf(),
-       1.f,
-       0.f},
-      {db.get("graphics/wirecube.gfx")->downcast<asset::Graphic>(),
-       Vec3f{2.5, .5f, 0},
-       identityQuatf(),
-       1.f,
-       .5f},
-      {db.get("graphics/head.gfx")->downcast<asset::Graphic>(),
-       Vec3f{5.0, 1.2f, 0},
-       identityQuatf(),
-       4.f,
-       1.f},
+      {getGraphic(0), Vec3f{-5.0, 0.f, 0}, identityQuatf(), 1.f, .2f},
+      {getGraphic(1), Vec3f{-2.5, 0, 0}, angleAxisQuatf(dir3d::up(), math::pi<float>), 1.f, 0.f},
+      {getGraphic(2), Vec3f{0.0, .5f, 0}, identityQuatf(), 1.f, 0.f},
+      {getGraphic(3), Vec3f{2.5, .5f, 0}, identityQuatf(), 1.f, .5f},
+      {getGraphic(4), Vec3f{5.0, 1.2f, 0}, identityQuatf(), 4.f, 1.f},
   };
+  graphics.clear(); // The objects keep their graphics loaded.
+
+  auto skyGraphic  = db.acquire("graphics/sky.gfx");
+  auto gridGraphic = db.acquire("graphics/grid.gfx");
 
   constexpr auto camVerFov         = 60.f;
   constexpr auto camZNear          = .1f;
@@ -82,6 +76,21 @@ auto runApp(pal::Platform& platform, asset::Database& db, gfx::Context& gfx) {
   while (!win.getIsCloseRequested() && !pal::isInterruptRequested()) {
     platform.handleEvents();
 
+    // Switch to the new versions of assets that were changed on disk.
+    for (const auto& reload : db.update()) {
+      canvas.releaseAsset(reload.oldAsset.get());
+      const auto replace = [&reload](asset::AssetHandle& handle) {
+        if (handle == reload.oldAsset) {
+          handle = reload.newAsset;
+        }
+      };
+      replace(skyGraphic);
+      replace(gridGraphic);
+      for (auto& obj : objs) {
+        replace(obj.graphic);
+      }
+    }
+
     ++frameNum;
     const auto newTime   = high_resolution_clock::now();
     const auto deltaTime = duration<float>(newTime - frameStartTime);
@@ -136,11 +145,12 @@ auto runApp(pal::Platform& platform, asset::Database& db, gfx::Context& gfx) {
       canvas.bindGlobalData(cam.getViewProjMat(win.getAspect()));
 
       // Draw sky (note also 'clears' the depth).
-      canvas.draw(db.get("graphics/sky.gfx")->downcast<asset::Graphic>());
+      canvas.draw(skyGraphic->downcast<asset::Graphic>());
 
       // Draw objects.
       for (const auto& obj : objs) {
-        canvas.draw(obj.graphic, trsMat4f(obj.pos, obj.orient, obj.scale));
+        canvas.draw(
+            obj.graphic->downcast<asset::Graphic>(), trsMat4f(obj.pos, obj.orient, obj.scale));
       }
 
       // Draw grid.
@@ -150,7 +160,7 @@ auto runApp(pal::Platform& platform, asset::Database& db, gfx::Context& gfx) {
       } grid;
       grid.camPos   = cam.pos();
       grid.segments = 250; // Times 4, 2 verts per line and 1 horizontal and 1 vertical line.
-      canvas.draw(db.get("graphics/grid.gfx")->downcast<asset::Graphic>(), grid.segments * 4, grid);
+      canvas.draw(gridGraphic->downcast<asset::Graphic>(), grid.segments * 4, grid);
 
       canvas.drawEnd();
     } else {
@@ -174,8 +184,10 @@ auto main(int /*unused*/, char* * /*unused*/) -> int {
   int ret;
   try {
     auto platform = pal::Platform{&logger};
-    auto db  = asset::Database{&logger, pal::getCurExecutablePath().parent_path() / "sandbox_data"};
-    auto gfx = gfx::Context{&logger};
+    auto exeDir   = pal::getCurExecutablePath().parent_path();
+    auto db       = asset::Database{&logger, exeDir / "sandbox_data", 0U, exeDir / "sandbox_cache"};
+    auto gfx      = gfx::Context{&logger};
+    db.enableHotReload();
 
     LOG_I(&logger, "Sandbox startup");
 
@@ -0,0 +1,36 @@
+#pragma once
+#include "tria/fs.hpp"
+#include <cstdint>
+
+namespace tria::asset {
+
+enum class ArchiveCompression : uint8_t {
+  None, // Entries are stored as-is and are memory mapped when loaded.
+  Lz,   // Entries are compressed when that makes them significantly smaller.
+};
+
+/* Statistics of a created archive.
+ */
+struct ArchiveStats final {
+  uint32_t entryCount;      // Files that were packed.
+  uint32_t compressedCount; // Entries that are stored compressed.
+  uint64_t srcSize;         // Total size of the packed files.
+  uint64_t archiveSize;     // Size of the archive file.
+};
+
+/* Pack all files in a directory (including its sub-directories) into a single archive file.
+ * A 'Database' created with the archive path as its root path loads the assets from the archive,
+ * asset ids are the file paths relative to the directory (same as when loading from the
+ * directory itself).
+ *
+ * Archives use the native byte order, they are not meant to be shared between machines with a
+ * different architecture. An existing archive is replaced (instead of overwritten), so databases
+ * that are using it are unaffected.
+ *
+ * Throws an 'ArchiveErr' if a file cannot be read or the archive cannot be written.
+ */
+auto packArchive(
+    const fs::path& srcDir, const fs::path& archivePath, ArchiveCompression compression)
+    -> ArchiveStats;
+
+} // namespace tria::asset
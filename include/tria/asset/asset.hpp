@@ -1,6 +1,7 @@
 #pragma once
 #include "tria/asset/asset_kind.hpp"
 #include "tria/asset/err/asset_type_err.hpp"
+#include <memory>
 #include <string>
 
 namespace tria::asset {
@@ -9,8 +10,10 @@ using AssetId = std::string;
 
 /*
  * Abstract base class for asset implementations.
+ * Assets loaded by a database are owned by shared pointers, 'weak_from_this()' can be used to
+ * create a handle that keeps such an asset loaded.
  */
-class Asset {
+class Asset : public std::enable_shared_from_this<Asset> {
 public:
   Asset()                     = delete;
   Asset(const Asset& rhs)     = delete;
@@ -12,6 +12,8 @@ enum class AssetKind : uint8_t {
   Graphic = 5,
 };
 
+constexpr auto g_assetKindCount = 5U;
+
 [[nodiscard]] constexpr auto getName(AssetKind kind) noexcept -> std::string_view {
   switch (kind) {
   case AssetKind::Raw:
@@ -1,24 +1,93 @@
 #pragma once
 #include "tria/asset/asset.hpp"
+#include "tria/asset/handle.hpp"
 #include "tria/fs.hpp"
 #include "tria/log/api.hpp"
+#include <array>
+#include <cstdint>
+#include <future>
+#include <vector>
 
 namespace tria::asset {
 
 class DatabaseImpl;
 
+/* Result of an asynchronous asset load.
+ * 'get()' waits for the load to finish and returns a handle to the asset or rethrows the load
+ * error. The future keeps the asset loaded as long as it (or a copy of it) exists.
+ * Can be copied and waited on from multiple threads.
+ */
+using AssetFuture = std::shared_future<AssetHandle>;
+
+/* Asset that was replaced by a newer version because its file (or the file of an asset it depends
+ * on) changed, see 'Database::update()'.
+ */
+struct AssetReload final {
+  AssetId id;
+  AssetHandle oldAsset;
+  AssetHandle newAsset;
+};
+
+/* Runtime statistics of a database.
+ */
+struct DatabaseStats final {
+  uint64_t loadCount;     // Assets that were loaded (successfully).
+  uint64_t dedupCount;    // Requests that waited for an in-progress load instead of loading again.
+  uint64_t cacheHitCount; // Assets that were loaded from the cache instead of being processed.
+  uint64_t evictCount;    // Assets that were unloaded to stay within the memory budget.
+  uint64_t reloadCount;   // Assets that were replaced by a newer version (hot reload).
+  uint64_t memoryUsage;   // Bytes used by the loaded assets.
+  std::array<uint64_t, g_assetKindCount> memoryUsagePerKind;
+
+  [[nodiscard]] auto getMemoryUsage(AssetKind kind) const noexcept {
+    return memoryUsagePerKind[static_cast<size_t>(kind) - 1U];
+  }
+};
+
 /*
  * Database for loading assets from.
- * Assets are loaded lazily but cached for future requests.
- * Currently assets cannot be unloaded, in the future some ref-counting smart-pointer-like handle
- * should be returned to track asset usage.
+ * Assets are loaded lazily but cached for future requests. Concurrent requests for an asset that
+ * is still loading wait for that load, every asset is only loaded once.
+ * Assets can also be loaded asynchronously on a pool of worker threads (see 'getAsync()' and
+ * 'preload()'), independent assets are then loaded in parallel.
+ * Optionally processed assets are cached on disk, cache entries are invalidated automatically when
+ * the source file changes.
+ * Assets are either loaded from separate files in a directory or from a single archive (see
+ * 'packArchive()'), archives avoid the file system overhead per asset.
+ *
+ * Asset lifetime:
+ * - Assets returned by 'get()' are never unloaded (they are 'pinned').
+ * - Assets referenced by a handle ('acquire()' or an 'AssetFuture') stay loaded as long as the
+ *   handle exists.
+ * - Assets keep the assets they depend on loaded, for example a graphic keeps its mesh alive.
+ * When a memory budget is set the least recently used assets that are not pinned or referenced are
+ * unloaded when the budget is exceeded.
+ *
+ * Hot reload:
+ * When enabled the root directory is watched for changes, changed assets and the assets that
+ * depend on them (for example the graphics that use a changed shader) are reloaded on the worker
+ * threads. The old versions stay valid (pinned ones for the lifetime of the database), users
+ * switch to the new versions when 'update()' reports them.
  *
  * Api is threadsafe.
  */
 class Database final {
 public:
   Database() = delete;
-  Database(log::Logger* logger, fs::path rootPath);
+
+  /* 'rootPath' is either a directory to load the assets from or an archive file created with
+   * 'packArchive()'. Throws an 'ArchiveErr' if the archive cannot be opened.
+   * 'workerCount' is the amount of threads used for asynchronous loading, 0 uses the amount of
+   * hardware threads. Threads are only started when first needed: on the first asynchronous load
+   * or when loading a graphic (its dependencies are loaded in parallel).
+   * 'cachePath' is a directory to store processed assets in (for example parsed meshes), so they
+   * load faster the next time. An empty path disables caching.
+   */
+  Database(
+      log::Logger* logger,
+      fs::path rootPath,
+      uint32_t workerCount = 0U,
+      fs::path cachePath   = {});
   Database(const Database& rhs)     = delete;
   Database(Database&& rhs) noexcept = default;
   ~Database();
@@ -27,11 +96,63 @@ public:
   auto operator=(Database&& rhs) noexcept -> Database& = default;
 
   /* Load an asset with a given id.
+   * The asset is pinned, it stays loaded for the lifetime of the database.
    * Throws if asset loading fails.
    * Is thread-safe.
    */
   auto get(const AssetId& id) -> const Asset*;
 
+  /* Load an asset with a given id and return a handle to it.
+   * The asset can be unloaded once all handles to it are destroyed (and the database exceeds its
+   * memory budget).
+   * Throws if asset loading fails.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto acquire(const AssetId& id) -> AssetHandle;
+
+  /* Load an asset with a given id on a worker thread.
+   * Returns a ready future if the asset was already loaded.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto getAsync(const AssetId& id) -> AssetFuture;
+
+  /* Start loading a batch of assets on the worker threads.
+   * Returns a future per asset, in the same order as the ids. Futures do not need to be waited on,
+   * loading continues in the background either way.
+   * Is thread-safe.
+   */
+  auto preload(const std::vector<AssetId>& ids) -> std::vector<AssetFuture>;
+
+  /* Set the maximum amount of bytes the loaded assets should use, 0 means unlimited (the default).
+   * When exceeded, unreferenced assets are unloaded in least recently used order. Note that the
+   * budget can still be exceeded if all assets are referenced.
+   * Is thread-safe.
+   */
+  auto setMemoryBudget(uint64_t bytes) -> void;
+
+  /* Start watching the root directory for changes to loaded assets.
+   * Files are not memory mapped while hot reload is enabled (editors rewrite files in place, which
+   * would corrupt the old versions), so enable it before loading any assets.
+   * Throws a 'PlatformErr' if the directory cannot be watched. Archives cannot be watched, for
+   * archives a warning is logged instead.
+   * Is thread-safe.
+   */
+  auto enableHotReload() -> void;
+
+  /* Start reloading the assets that changed and return the reloads that have finished since the
+   * last call. New versions of pinned assets are pinned as well. When a reload fails (for example
+   * because a file is only partially saved) the error is logged and the old version is kept.
+   * Should be called regularly (for example once per frame), does nothing unless hot reload is
+   * enabled.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto update() -> std::vector<AssetReload>;
+
+  /* Snapshot of the database statistics.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto getStats() const noexcept -> DatabaseStats;
+
 private:
   std::unique_ptr<DatabaseImpl> m_impl;
 };
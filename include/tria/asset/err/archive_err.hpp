@@ -0,0 +1,28 @@
+#pragma once
+#include "tria/fs.hpp"
+#include <exception>
+#include <string>
+#include <string_view>
+
+namespace tria::asset::err {
+
+/*
+ * Exception that is thrown when an asset archive cannot be created or opened.
+ */
+class ArchiveErr final : public std::exception {
+public:
+  ArchiveErr() = delete;
+  ArchiveErr(const fs::path& path, std::string_view msg) :
+      m_path{path},
+      m_msg{std::string{"Asset archive error: "} + std::string{msg} + ": " + m_path.string()} {}
+
+  [[nodiscard]] auto what() const noexcept -> const char* override { return m_msg.c_str(); }
+
+  [[nodiscard]] auto getPath() const noexcept -> const fs::path& { return m_path; }
+
+private:
+  fs::path m_path;
+  std::string m_msg;
+};
+
+} // namespace tria::asset::err
@@ -0,0 +1,58 @@
+#pragma once
+#include "tria/math/pod_vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace tria::asset {
+
+/* Amount of zero bytes that can be read past the end of a 'FileData'.
+ */
+constexpr size_t g_fileDataPadding = 64U;
+
+/*
+ * Read-only contents of an asset file.
+ * Either references a memory mapping of the file or owns a heap buffer, users do not need to care
+ * which. Atleast 'g_fileDataPadding' zero bytes can be read past the end of the data, parsers rely
+ * on this to skip bounds checks.
+ * Cheap to copy, copies share the same underlying memory (which stays alive as long as any of the
+ * copies do).
+ */
+class FileData final {
+public:
+  FileData() noexcept : m_data{nullptr}, m_size{0U}, m_mapped{false} {}
+
+  /* Reference memory that is kept alive by 'owner'.
+   * Note: Caller is responsible for providing the zero padding past the end.
+   */
+  FileData(
+      std::shared_ptr<const void> owner, const uint8_t* data, size_t size, bool mapped) noexcept :
+      m_owner{std::move(owner)}, m_data{data}, m_size{size}, m_mapped{mapped} {}
+
+  /* Copy of the given bytes, with the zero padding added.
+   */
+  [[nodiscard]] static auto copy(const uint8_t* data, size_t size) -> FileData {
+    auto buffer = std::make_shared<math::RawData>(size + g_fileDataPadding);
+    std::copy(data, data + size, buffer->begin());
+    std::fill(buffer->begin() + size, buffer->end(), 0U);
+    const auto* begin = buffer->begin();
+    return FileData{std::move(buffer), begin, size, false};
+  }
+
+  [[nodiscard]] auto getSize() const noexcept { return m_size; }
+  [[nodiscard]] auto getBegin() const noexcept { return m_data; }
+  [[nodiscard]] auto getEnd() const noexcept { return m_data + m_size; }
+
+  /* Is the data a view into a memory mapped file (instead of a heap copy).
+   */
+  [[nodiscard]] auto isMapped() const noexcept { return m_mapped; }
+
+private:
+  std::shared_ptr<const void> m_owner;
+  const uint8_t* m_data;
+  size_t m_size;
+  bool m_mapped;
+};
+
+} // namespace tria::asset
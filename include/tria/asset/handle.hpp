@@ -0,0 +1,54 @@
+#pragma once
+#include "tria/asset/asset.hpp"
+#include <cassert>
+#include <memory>
+
+namespace tria::asset {
+
+/*
+ * Reference counted handle to an asset.
+ * The asset (and the assets it depends on) stay loaded as long as a handle to it exists, assets
+ * without handles can be unloaded by the database when it exceeds its memory budget.
+ * Cheap to copy, copies reference the same asset. Handles can outlive the database.
+ * Is thread-safe.
+ */
+class AssetHandle final {
+public:
+  AssetHandle() noexcept = default;
+  explicit AssetHandle(std::shared_ptr<const Asset> asset) noexcept : m_asset{std::move(asset)} {}
+
+  [[nodiscard]] explicit operator bool() const noexcept { return m_asset != nullptr; }
+
+  [[nodiscard]] auto operator==(const AssetHandle& rhs) const noexcept {
+    return m_asset == rhs.m_asset;
+  }
+  [[nodiscard]] auto operator!=(const AssetHandle& rhs) const noexcept {
+    return m_asset != rhs.m_asset;
+  }
+  [[nodiscard]] auto operator==(const Asset* rhs) const noexcept { return m_asset.get() == rhs; }
+  [[nodiscard]] auto operator!=(const Asset* rhs) const noexcept { return m_asset.get() != rhs; }
+
+  [[nodiscard]] auto operator*() const noexcept -> const Asset& {
+    assert(m_asset);
+    return *m_asset;
+  }
+  [[nodiscard]] auto operator->() const noexcept -> const Asset* {
+    assert(m_asset);
+    return m_asset.get();
+  }
+
+  [[nodiscard]] auto get() const noexcept -> const Asset* { return m_asset.get(); }
+
+private:
+  std::shared_ptr<const Asset> m_asset;
+};
+
+[[nodiscard]] inline auto operator==(const Asset* lhs, const AssetHandle& rhs) noexcept {
+  return rhs == lhs;
+}
+
+[[nodiscard]] inline auto operator!=(const Asset* lhs, const AssetHandle& rhs) noexcept {
+  return rhs != lhs;
+}
+
+} // namespace tria::asset
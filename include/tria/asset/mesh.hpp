@@ -1,5 +1,6 @@
 #pragma once
 #include "tria/asset/asset.hpp"
+#include "tria/asset/file_data.hpp"
 #include "tria/math/box.hpp"
 #include "tria/math/pod_vector.hpp"
 #include "tria/math/vec.hpp"
@@ -36,6 +37,7 @@ struct Vertex final {
 /*
  * Asset containing geometry data.
  * Contains a set of vertices and indices that form primitives from the vertices.
+ * The vertices and indices are either owned by the mesh or are a view into (mapped) file data.
  */
 class Mesh final : public Asset {
 public:
@@ -49,7 +51,32 @@ public:
       m_posBounds{posBounds},
       m_texBounds{texBounds},
       m_vertices{std::move(vertices)},
-      m_indices{std::move(indices)} {}
+      m_indices{std::move(indices)},
+      m_vertexBegin{m_vertices.begin()},
+      m_vertexCount{m_vertices.size()},
+      m_indexBegin{m_indices.begin()},
+      m_indexCount{m_indices.size()} {}
+
+  /* Mesh that references vertices and indices in the given file data, the mesh keeps the data
+   * alive.
+   */
+  Mesh(
+      AssetId id,
+      const math::Box3f& posBounds,
+      const math::Box2f& texBounds,
+      FileData data,
+      const Vertex* vertexBegin,
+      size_t vertexCount,
+      const IndexType* indexBegin,
+      size_t indexCount) :
+      Asset{std::move(id), getKind()},
+      m_posBounds{posBounds},
+      m_texBounds{texBounds},
+      m_data{std::move(data)},
+      m_vertexBegin{vertexBegin},
+      m_vertexCount{vertexCount},
+      m_indexBegin{indexBegin},
+      m_indexCount{indexCount} {}
   Mesh(const Mesh& rhs) = delete;
   Mesh(Mesh&& rhs)      = delete;
   ~Mesh() noexcept      = default;
@@ -62,19 +89,28 @@ public:
   [[nodiscard]] auto getPosBounds() const noexcept -> const math::Box3f& { return m_posBounds; }
   [[nodiscard]] auto getTexBounds() const noexcept -> const math::Box2f& { return m_texBounds; }
 
-  [[nodiscard]] auto getVertexCount() const noexcept { return m_vertices.size(); }
-  [[nodiscard]] auto getVertexBegin() const noexcept { return m_vertices.begin(); }
-  [[nodiscard]] auto getVertexEnd() const noexcept { return m_vertices.end(); }
+  [[nodiscard]] auto getVertexCount() const noexcept { return m_vertexCount; }
+  [[nodiscard]] auto getVertexBegin() const noexcept { return m_vertexBegin; }
+  [[nodiscard]] auto getVertexEnd() const noexcept { return m_vertexBegin + m_vertexCount; }
+
+  [[nodiscard]] auto getIndexCount() const noexcept { return m_indexCount; }
+  [[nodiscard]] auto getIndexBegin() const noexcept { return m_indexBegin; }
+  [[nodiscard]] auto getIndexEnd() const noexcept { return m_indexBegin + m_indexCount; }
 
-  [[nodiscard]] auto getIndexCount() const noexcept { return m_indices.size(); }
-  [[nodiscard]] auto getIndexBegin() const noexcept { return m_indices.begin(); }
-  [[nodiscard]] auto getIndexEnd() const noexcept { return m_indices.end(); }
+  /* Is the mesh a view into file data (instead of owning its vertices and indices).
+   */
+  [[nodiscard]] auto isFileBacked() const noexcept { return m_data.getBegin() != nullptr; }
 
 private:
   math::Box3f m_posBounds;
   math::Box2f m_texBounds;
   math::PodVector<Vertex> m_vertices;
   math::PodVector<IndexType> m_indices;
+  FileData m_data;
+  const Vertex* m_vertexBegin;
+  size_t m_vertexCount;
+  const IndexType* m_indexBegin;
+  size_t m_indexCount;
 };
 
 /* Check if two vertices are approximately equal.
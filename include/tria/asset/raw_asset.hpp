@@ -1,6 +1,6 @@
 #pragma once
 #include "tria/asset/asset.hpp"
-#include "tria/math/pod_vector.hpp"
+#include "tria/asset/file_data.hpp"
 
 namespace tria::asset {
 
@@ -9,7 +9,7 @@ namespace tria::asset {
  */
 class RawAsset final : public Asset {
 public:
-  RawAsset(AssetId id, math::RawData data) :
+  RawAsset(AssetId id, FileData data) :
       Asset{std::move(id), getKind()}, m_data{std::move(data)} {}
   RawAsset(const RawAsset& rhs) = delete;
   RawAsset(RawAsset&& rhs)      = delete;
@@ -20,12 +20,13 @@ public:
 
   [[nodiscard]] constexpr static auto getKind() -> AssetKind { return AssetKind::Raw; }
 
-  [[nodiscard]] auto getSize() const noexcept { return m_data.size(); }
-  [[nodiscard]] auto getBegin() const noexcept { return m_data.begin(); }
-  [[nodiscard]] auto getEnd() const noexcept { return m_data.end(); }
+  [[nodiscard]] auto getSize() const noexcept { return m_data.getSize(); }
+  [[nodiscard]] auto getBegin() const noexcept { return m_data.getBegin(); }
+  [[nodiscard]] auto getEnd() const noexcept { return m_data.getEnd(); }
+  [[nodiscard]] auto getData() const noexcept -> const FileData& { return m_data; }
 
 private:
-  math::RawData m_data;
+  FileData m_data;
 };
 
 } // namespace tria::asset
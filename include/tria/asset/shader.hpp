@@ -1,6 +1,6 @@
 #pragma once
 #include "tria/asset/asset.hpp"
-#include "tria/math/pod_vector.hpp"
+#include "tria/asset/file_data.hpp"
 #include <string_view>
 #include <vector>
 
@@ -64,7 +64,7 @@ public:
       ShaderKind shaderKind,
       std::string entryPointName,
       std::vector<ShaderResource> resources,
-      math::RawData data) :
+      FileData data) :
       Asset{std::move(id), getKind()},
       m_shaderKind{shaderKind},
       m_entryPointName{std::move(entryPointName)},
@@ -92,15 +92,16 @@ public:
     return m_resources.data() + m_resources.size();
   }
 
-  [[nodiscard]] auto getSize() const noexcept { return m_data.size(); }
-  [[nodiscard]] auto getBegin() const noexcept { return m_data.begin(); }
-  [[nodiscard]] auto getEnd() const noexcept { return m_data.end(); }
+  [[nodiscard]] auto getSize() const noexcept { return m_data.getSize(); }
+  [[nodiscard]] auto getBegin() const noexcept { return m_data.getBegin(); }
+  [[nodiscard]] auto getEnd() const noexcept { return m_data.getEnd(); }
+  [[nodiscard]] auto getData() const noexcept -> const FileData& { return m_data; }
 
 private:
   ShaderKind m_shaderKind;
   std::string m_entryPointName;
   std::vector<ShaderResource> m_resources;
-  math::RawData m_data;
+  FileData m_data;
 };
 
 } // namespace tria::asset
@@ -0,0 +1,11 @@
+#pragma once
+
+// Template for the 'config.hpp' header, will be generated by cmake.
+
+// clang-format off
+#define ENGINE_NAME "Tria"
+#define ENGINE_VER "0.1.0"
+#define ENGINE_VER_MAJOR 0
+#define ENGINE_VER_MINOR 1
+#define ENGINE_VER_PATCH 0
+// clang-format on
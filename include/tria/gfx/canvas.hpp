@@ -132,6 +132,15 @@ public:
       size_t instDataSize,
       uint32_t count) -> void;
 
+  /* Destroy the gpu resources that were created for the given asset, for example because a newer
+   * version of the asset was loaded. Graphics that use the asset have their resources destroyed as
+   * well, resources are recreated when the asset is drawn again.
+   * Gpu resources keep their asset loaded, so assets that are drawn are not unloaded by the memory
+   * budget of the database until they are released.
+   * Note: Cannot be called while drawing, waits for the gpu to finish using the resources.
+   */
+  auto releaseAsset(const asset::Asset* asset) -> void;
+
   /* End drawing and present the result to the window.
    * Note: Has to be preceeded by a call to 'drawBegin'
    */
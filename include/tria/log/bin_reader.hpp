@@ -0,0 +1,17 @@
+#pragma once
+#include "tria/fs.hpp"
+#include "tria/log/sink.hpp"
+
+namespace tria::log {
+
+/* Decode a binary log (as written by the binary sink) and write the messages to the given sink.
+ * Messages that are not in the mask of the sink are skipped.
+ * Compressed binary logs (see 'Compression') are decompressed transparently.
+ * Returns the amount of messages that were written to the sink.
+ *
+ * Throws a 'LogDecodeErr' if the file cannot be read or contains invalid or truncated data, all
+ * messages that were decoded before the error have already been written to the sink.
+ */
+auto readBinaryLog(const fs::path& path, Sink* sink) -> size_t;
+
+} // namespace tria::log
@@ -0,0 +1,17 @@
+#pragma once
+#include "tria/fs.hpp"
+#include <cstdint>
+#include <cstdio>
+
+namespace tria::log {
+
+/* Decompress a log that was written by a file sink with 'Compression::Lz' and write the original
+ * log data to the given file.
+ * Returns the amount of (decompressed) bytes that were written.
+ *
+ * Throws a 'LogDecodeErr' if the file cannot be read or contains invalid or truncated data, all
+ * data that was decompressed before the error has already been written to the output.
+ */
+auto decompressLog(const fs::path& path, std::FILE* output) -> uint64_t;
+
+} // namespace tria::log
@@ -0,0 +1,23 @@
+#pragma once
+#include <exception>
+#include <string>
+#include <string_view>
+
+namespace tria::log::err {
+
+/*
+ * Exception that is thrown when an error occurs while decoding a binary log.
+ */
+class LogDecodeErr final : public std::exception {
+public:
+  LogDecodeErr() = delete;
+  LogDecodeErr(std::string_view msg) :
+      m_msg{std::string{"Failed to decode log: "} + std::string{msg}} {}
+
+  [[nodiscard]] auto what() const noexcept -> const char* override { return m_msg.c_str(); }
+
+private:
+  std::string m_msg;
+};
+
+} // namespace tria::log::err
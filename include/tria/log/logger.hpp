@@ -1,12 +1,118 @@
 #pragma once
 #include "tria/log/sink.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace tria::log {
 
+class RateLimiter;
+
+/* Policy for publishing messages while the logger queue is full.
+ */
+enum class OverflowPolicy : uint8_t {
+  Block,      // Wait for the log thread to make room, no messages are lost.
+  DropNewest, // Drop the message that is being published.
+  DropOldest, // Drop the oldest message in the queue to make room.
+};
+
+/* How the log thread hands messages to the sinks.
+ * With 'Parallel' the log thread shares each (immutable) batch with all the sink threads. Sinks
+ * still receive the messages in order and from a single thread, but a slow sink no longer holds
+ * back the other sinks. A sink can fall a few queue capacities behind, after that the
+ * 'OverflowPolicy' applies to it: 'Block' makes the log thread wait for the sink (holding back the
+ * other sinks and eventually the publishers), the drop policies drop messages for that sink only
+ * (see 'LoggerSinkStats::dropped').
+ */
+enum class SinkDispatch : uint8_t {
+  Sequential, // The log thread invokes all sinks one after the other.
+  Parallel,   // Every sink gets its own thread, a slow sink only delays itself.
+};
+
+/* Configuration of a logger.
+ */
+struct LoggerConfig final {
+  size_t queueCapacity          = 4096U;                    // Rounded up to a power of two.
+  OverflowPolicy overflowPolicy = OverflowPolicy::Block;    // What to do when the queue is full.
+  SinkDispatch sinkDispatch     = SinkDispatch::Sequential; // Which threads invoke the sinks.
+  TimeSource timeSource         = TimeSource::SystemClock;  // Timestamps of the log macros.
+
+  // Interval at which the logger logs its own statistics (as an info message that is written to
+  // the sinks directly), zero disables it. Nothing is logged while no messages are being logged.
+  std::chrono::milliseconds statsLogInterval = std::chrono::milliseconds{0};
+
+  // Interval at which messages suppressed by rate limited call-sites ('LOG_RATE') are reported,
+  // also when the call-site does not log anymore. Zero only reports them before the next allowed
+  // message of the call-site.
+  std::chrono::milliseconds rateSummaryInterval = std::chrono::milliseconds{1000};
+};
+
+/* Distribution of recorded values, bucketed by powers of two.
+ * Bucket 'i' contains the values in the range [2^(i - 1), 2^i), bucket 0 only contains zeroes and
+ * the last bucket also contains all larger values.
+ */
+struct LoggerHistogram final {
+  constexpr static size_t s_bucketCount = 48U;
+
+  std::array<uint64_t, s_bucketCount> buckets;
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+
+  [[nodiscard]] auto getMean() const noexcept -> double {
+    return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+  }
+
+  /* Approximate value that the given fraction (0 - 1) of the recorded values does not exceed.
+   * Returns the upper bound of the bucket, so can overestimate by up to a factor of two.
+   */
+  [[nodiscard]] auto getPercentile(double fraction) const noexcept -> uint64_t;
+};
+
+/* Runtime statistics of a single sink.
+ */
+struct LoggerSinkStats final {
+  LoggerHistogram writeTime; // Nanoseconds spent writing, per batch.
+  LoggerHistogram latency;   // Nanoseconds from the message timestamp until the sink writes it.
+  uint64_t dropped;          // Messages dropped because the sink fell behind (parallel dispatch).
+};
+
+/* Runtime statistics of a logger, can be used to size the queue and to spot logging becoming a
+ * bottleneck.
+ * Every published message is either processed, dropped or still in the queue.
+ */
+struct LoggerStats final {
+  size_t queueCapacity;
+  size_t queueDepth;         // Approximate amount of messages currently in the queue.
+  size_t queueHighWaterMark; // Highest observed queue depth.
+  uint64_t droppedDebug;     // Messages dropped because the queue was full, per level.
+  uint64_t droppedInfo;
+  uint64_t droppedWarn;
+  uint64_t droppedError;
+  uint64_t processedDebug; // Messages handed to the sinks, per level.
+  uint64_t processedInfo;
+  uint64_t processedWarn;
+  uint64_t processedError;
+  LoggerHistogram batchSize;          // Messages per batch that the log thread processed.
+  std::vector<LoggerSinkStats> sinks; // In the order the sinks were given to the logger.
+
+  [[nodiscard]] auto getTotalDropped() const noexcept {
+    return droppedDebug + droppedInfo + droppedWarn + droppedError;
+  }
+
+  [[nodiscard]] auto getTotalProcessed() const noexcept {
+    return processedDebug + processedInfo + processedWarn + processedError;
+  }
+};
+
 /*
  * Logger is responsable for receiving messages to log and forwarding them to its sinks.
- * Publishing log messages is thread-safe and can be performed in parallel.
+ * Publishing log messages is thread-safe and can be performed in parallel, messages are pushed into
+ * a bounded lock-free queue so publishers never wait on each other (only on the log thread when the
+ * queue is full).
  * The logger uses a dedicated thread to process log messages and to invoke the sinks, because of
  * this the sinks themselves do not need to be threadsafe.
  */
@@ -19,21 +125,63 @@ public:
   template <typename... Sinks>
   explicit Logger(Sinks&&... sinks) : Logger(makeSinkVector(std::forward<Sinks>(sinks)...)) {}
 
+  template <typename... Sinks>
+  explicit Logger(LoggerConfig config, Sinks&&... sinks) :
+      Logger(config, makeSinkVector(std::forward<Sinks>(sinks)...)) {}
+
   explicit Logger(std::vector<SinkUnique> sinks);
+  Logger(LoggerConfig config, std::vector<SinkUnique> sinks);
 
-  Logger(const Logger& rhs)     = delete;
-  Logger(Logger&& rhs) noexcept = default;
+  Logger(const Logger& rhs) = delete;
+  Logger(Logger&& rhs) noexcept;
   ~Logger();
 
   auto operator=(const Logger& rhs) -> Logger& = delete;
-  auto operator=(Logger&& rhs) noexcept -> Logger& = default;
+  auto operator=(Logger&& rhs) noexcept -> Logger&;
+
+  /* Mask of the levels that at least one of the sinks is interested in (union of the sink masks).
+   * The log macros check it before constructing a message, so logging a disabled level is cheap.
+   * Is thread-safe, costs a single relaxed atomic load.
+   */
+  [[nodiscard]] auto getMask() const noexcept -> LevelMask {
+    return m_mask.load(std::memory_order_relaxed);
+  }
+
+  /* Source the log macros should use for the message timestamps.
+   */
+  [[nodiscard]] auto getTimeSource() const noexcept { return m_timeSource; }
+
+  /* Does the logger periodically report the messages suppressed by rate limited call-sites, see
+   * 'LoggerConfig::rateSummaryInterval'.
+   */
+  [[nodiscard]] auto hasRateSummaries() const noexcept { return m_rateSummaries; }
 
   /* Publish a new log message.
    * Is thread-safe.
    */
   auto publish(Message msg) noexcept -> void;
 
+  /* Periodically report the messages that the given rate limiter suppressed, see 'LOG_RATE'.
+   * 'meta' is the metadata of the rate limited call-site and 'summaryMeta' the metadata to use for
+   * the summary messages. The limiter has to be claimed first ('RateLimiter::claimTracking()'), so
+   * it is tracked by a single logger at a time, tracking is released again when the logger is
+   * destroyed.
+   * Note: The limiter and the metadata have to outlive the logger.
+   * Is thread-safe.
+   */
+  auto trackRateLimiter(RateLimiter* limiter, const MetaData* meta, const MetaData* summaryMeta)
+      -> void;
+
+  /* Snapshot of the logger statistics.
+   * Statistics are only written by the log (and sink) threads, so publishing does not pay for them.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto getStats() const noexcept -> LoggerStats;
+
 private:
+  std::atomic<LevelMask> m_mask;
+  TimeSource m_timeSource;
+  bool m_rateSummaries;
   std::unique_ptr<Impl> m_impl;
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "tria/log/logger.hpp"
 #include "tria/log/metadata.hpp"
+#include "tria/log/rate_limiter.hpp"
 
 // If 'SRC_PATH_LENGTH' is defined we strip that part of the path of.
 #if defined(SRC_PATH_LENGTH)
@@ -14,6 +15,9 @@
 #define __PRETTY_FUNCTION__ __FUNCSIG__
 #endif
 
+/* Log a message with the given level.
+ * Parameters are only evaluated if the logger has a sink that is interested in the level.
+ */
 #define LOG(logger, lvl, txt, ...)                                                                 \
   do {                                                                                             \
     constexpr static auto meta = log::MetaData{lvl,                                                \
@@ -22,19 +26,73 @@
                                                std::string_view{__PRETTY_FUNCTION__},              \
                                                __LINE__};                                          \
     auto* loggerPtr            = (logger);                                                         \
-    if (loggerPtr) {                                                                               \
-      loggerPtr->publish(log::Message{&meta, {__VA_ARGS__}});                                      \
+    if (loggerPtr && log::isInMask(loggerPtr->getMask(), lvl)) {                                   \
+      loggerPtr->publish(log::Message{&meta, loggerPtr->getTimeSource(), {__VA_ARGS__}});          \
     }                                                                                              \
   } while (false)
 
+/* Log a message with the given level, rate limited per call-site (see 'RateLimit').
+ * Suppressed messages are reported in a summary message (containing the suppressed count), either
+ * before the next allowed message or periodically by the log thread when the call-site stays quiet
+ * (see 'LoggerConfig::rateSummaryInterval').
+ * The limit and the suppressed count are per call-site, so they are shared by all loggers that log
+ * from it. Periodic summaries go to a single logger at a time (the first to suppress a message).
+ *
+ * Example usage:
+ * LOG_RATE(logger, log::perSecond(1), log::Level::Warn, "Frame took too long");
+ * LOG_RATE(logger, log::oneIn(100), log::Level::Info, "Draw", {"count", count});
+ */
+#define LOG_RATE(logger, rate, lvl, txt, ...)                                                      \
+  do {                                                                                             \
+    constexpr static auto meta = log::MetaData{lvl,                                                \
+                                               std::string_view{txt},                              \
+                                               std::string_view{__FILENAME__},                     \
+                                               std::string_view{__PRETTY_FUNCTION__},              \
+                                               __LINE__};                                          \
+    constexpr static auto suppressedMeta =                                                         \
+        log::MetaData{lvl,                                                                         \
+                      std::string_view{"Suppressed log messages"},                                 \
+                      std::string_view{__FILENAME__},                                              \
+                      std::string_view{__PRETTY_FUNCTION__},                                       \
+                      __LINE__};                                                                   \
+    static auto rateLimiter = log::RateLimiter{rate};                                              \
+    auto* loggerPtr         = (logger);                                                            \
+    uint64_t suppressed;                                                                           \
+    if (!loggerPtr || !log::isInMask(loggerPtr->getMask(), lvl)) {                                 \
+      break;                                                                                       \
+    }                                                                                              \
+    if (!rateLimiter.tryAcquire(&suppressed)) {                                                    \
+      if (loggerPtr->hasRateSummaries() && rateLimiter.claimTracking()) {                          \
+        loggerPtr->trackRateLimiter(&rateLimiter, &meta, &suppressedMeta);                         \
+      }                                                                                            \
+      break;                                                                                       \
+    }                                                                                              \
+    if (suppressed) {                                                                              \
+      loggerPtr->publish(log::Message{                                                             \
+          &suppressedMeta,                                                                         \
+          loggerPtr->getTimeSource(),                                                              \
+          {{"message", meta.getTxt()}, {"suppressed", suppressed}}});                              \
+    }                                                                                              \
+    loggerPtr->publish(log::Message{&meta, loggerPtr->getTimeSource(), {__VA_ARGS__}});            \
+  } while (false)
+
 #if defined(NDEBUG)
 /* Log a debug message.
  */
 #define LOG_D(logger, txt, ...) (void)logger
+
+/* Log a rate limited debug message.
+ */
+#define LOG_D_RATE(logger, rate, txt, ...) (void)logger
 #else
 /* Log a debug message.
  */
 #define LOG_D(logger, txt, ...) LOG(logger, log::Level::Debug, txt, __VA_ARGS__)
+
+/* Log a rate limited debug message.
+ */
+#define LOG_D_RATE(logger, rate, txt, ...)                                                         \
+  LOG_RATE(logger, rate, log::Level::Debug, txt, __VA_ARGS__)
 #endif
 
 /* Log a info message.
@@ -48,3 +106,18 @@
 /* Log a error message.
  */
 #define LOG_E(logger, txt, ...) LOG(logger, log::Level::Error, txt, __VA_ARGS__)
+
+/* Log a rate limited info message.
+ */
+#define LOG_I_RATE(logger, rate, txt, ...)                                                         \
+  LOG_RATE(logger, rate, log::Level::Info, txt, __VA_ARGS__)
+
+/* Log a rate limited warning message.
+ */
+#define LOG_W_RATE(logger, rate, txt, ...)                                                         \
+  LOG_RATE(logger, rate, log::Level::Warn, txt, __VA_ARGS__)
+
+/* Log a rate limited error message.
+ */
+#define LOG_E_RATE(logger, rate, txt, ...)                                                         \
+  LOG_RATE(logger, rate, log::Level::Error, txt, __VA_ARGS__)
@@ -1,7 +1,12 @@
 #pragma once
 #include "tria/log/param.hpp"
+#include "tria/log/ticks.hpp"
 #include <cassert>
 #include <chrono>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
 #include <vector>
 
 namespace tria::log {
@@ -11,36 +16,156 @@ class MetaData;
 /*
  * Log message. Consists of three parts:
  * - Metadata (constant data that can be stored statically at the construction site).
- * - Timestamp (automatically collected in the constructor).
+ * - Timestamp (automatically collected in the constructor, unless explicitly provided).
+ *   Can also be collected as raw ticks (see 'TimeSource'), which are cheaper to read but have to
+ *   be converted to wall-clock time (using 'setTime()') before the message reaches the sinks.
  * - Parameters (runtime parameters to include with the message).
- * Note: At this time the parameters are a heap allocation on every log with parameters, in the
- * future we could considering using some form of a thread-static ring buffer. Or alternatively some
- * small vector optimization.
+ * Note: Up to 's_inlineParamCount' parameters are stored inline in the message, only messages with
+ * more parameters use a heap allocation for their parameters.
  */
 class Message final {
 public:
-  Message() noexcept = default;
-  Message(const MetaData* meta, std::vector<Param> params) noexcept :
-      m_meta{meta}, m_time{std::chrono::system_clock::now()}, m_params{std::move(params)} {
+  constexpr static size_t s_inlineParamCount = 4U;
+
+  Message() noexcept : m_meta{nullptr}, m_inlineParamCount{0U}, m_tickTime{false} {}
+  Message(const MetaData* meta, std::initializer_list<Param> params) noexcept :
+      Message{meta, TimeSource::SystemClock, params} {}
+  Message(
+      const MetaData* meta, TimeSource timeSource, std::initializer_list<Param> params) noexcept :
+      m_meta{meta}, m_inlineParamCount{0U}, m_tickTime{timeSource == TimeSource::Ticks} {
+    assert(meta);
+    if (m_tickTime) {
+      m_time = TimePoint{TimePoint::duration{static_cast<TimePoint::rep>(readTicks())}};
+    } else {
+      m_time = std::chrono::system_clock::now();
+    }
+    if (params.size() <= s_inlineParamCount) {
+      pushInlineParams(params.begin(), params.end());
+    } else {
+      m_heapParams = params;
+    }
+  }
+  Message(const MetaData* meta, TimePoint time, std::vector<Param> params) noexcept :
+      m_meta{meta}, m_time{time}, m_inlineParamCount{0U}, m_tickTime{false} {
     assert(meta);
+    if (params.size() <= s_inlineParamCount) {
+      pushInlineParams(
+          std::make_move_iterator(params.begin()), std::make_move_iterator(params.end()));
+    } else {
+      m_heapParams = std::move(params);
+    }
+  }
+  Message(const Message& rhs) :
+      m_meta{rhs.m_meta},
+      m_time{rhs.m_time},
+      m_heapParams{rhs.m_heapParams},
+      m_inlineParamCount{0U},
+      m_tickTime{rhs.m_tickTime} {
+    pushInlineParams(rhs.getInlineBegin(), rhs.getInlineEnd());
   }
-  Message(const Message& rhs)     = default;
-  Message(Message&& rhs) noexcept = default;
+  Message(Message&& rhs) noexcept :
+      m_meta{rhs.m_meta},
+      m_time{rhs.m_time},
+      m_heapParams{std::move(rhs.m_heapParams)},
+      m_inlineParamCount{0U},
+      m_tickTime{rhs.m_tickTime} {
+    pushInlineParams(
+        std::make_move_iterator(rhs.getInlineBegin()), std::make_move_iterator(rhs.getInlineEnd()));
+  }
+  ~Message() { clearInlineParams(); }
 
-  auto operator=(const Message& rhs) -> Message& = default;
-  auto operator=(Message&& rhs) noexcept -> Message& = default;
+  auto operator=(const Message& rhs) -> Message& {
+    if (this != &rhs) {
+      clearInlineParams();
+      m_meta       = rhs.m_meta;
+      m_time       = rhs.m_time;
+      m_heapParams = rhs.m_heapParams;
+      m_tickTime   = rhs.m_tickTime;
+      pushInlineParams(rhs.getInlineBegin(), rhs.getInlineEnd());
+    }
+    return *this;
+  }
+
+  auto operator=(Message&& rhs) noexcept -> Message& {
+    if (this != &rhs) {
+      clearInlineParams();
+      m_meta       = rhs.m_meta;
+      m_time       = rhs.m_time;
+      m_heapParams = std::move(rhs.m_heapParams);
+      m_tickTime   = rhs.m_tickTime;
+      pushInlineParams(
+          std::make_move_iterator(rhs.getInlineBegin()),
+          std::make_move_iterator(rhs.getInlineEnd()));
+    }
+    return *this;
+  }
 
   [[nodiscard]] auto getMeta() const noexcept { return m_meta; }
-  [[nodiscard]] auto getTime() const noexcept { return m_time; }
-  [[nodiscard]] auto hasParams() const noexcept { return !m_params.empty(); }
+  [[nodiscard]] auto getTime() const noexcept {
+    assert(!m_tickTime);
+    return m_time;
+  }
+
+  /* Does this message still have a raw tick timestamp that needs converting.
+   */
+  [[nodiscard]] auto hasTickTime() const noexcept { return m_tickTime; }
+
+  [[nodiscard]] auto getTicks() const noexcept {
+    assert(m_tickTime);
+    return static_cast<uint64_t>(m_time.time_since_epoch().count());
+  }
+
+  /* Replace the (tick) timestamp of the message with a wall-clock time.
+   */
+  auto setTime(TimePoint time) noexcept {
+    m_time     = time;
+    m_tickTime = false;
+  }
+
+  [[nodiscard]] auto hasParams() const noexcept { return begin() != end(); }
 
-  [[nodiscard]] auto begin() const noexcept { return m_params.begin(); }
-  [[nodiscard]] auto end() const noexcept { return m_params.end(); }
+  [[nodiscard]] auto begin() const noexcept -> const Param* {
+    return m_inlineParamCount ? getInlineBegin() : m_heapParams.data();
+  }
+  [[nodiscard]] auto end() const noexcept -> const Param* {
+    return m_inlineParamCount ? getInlineEnd() : m_heapParams.data() + m_heapParams.size();
+  }
 
 private:
   const MetaData* m_meta;
-  TimePoint m_time;
-  std::vector<Param> m_params;
+  TimePoint m_time; // Holds the raw ticks when 'm_tickTime' is set.
+  std::vector<Param> m_heapParams;
+  uint32_t m_inlineParamCount;
+  bool m_tickTime;
+  std::aligned_storage_t<sizeof(Param) * s_inlineParamCount, alignof(Param)> m_inlineParams;
+
+  [[nodiscard]] auto getInlineBegin() noexcept -> Param* {
+    return std::launder(reinterpret_cast<Param*>(&m_inlineParams));
+  }
+  [[nodiscard]] auto getInlineBegin() const noexcept -> const Param* {
+    return std::launder(reinterpret_cast<const Param*>(&m_inlineParams));
+  }
+  [[nodiscard]] auto getInlineEnd() noexcept -> Param* {
+    return getInlineBegin() + m_inlineParamCount;
+  }
+  [[nodiscard]] auto getInlineEnd() const noexcept -> const Param* {
+    return getInlineBegin() + m_inlineParamCount;
+  }
+
+  template <typename Itr>
+  auto pushInlineParams(Itr first, Itr last) -> void {
+    for (; first != last; ++first) {
+      assert(m_inlineParamCount < s_inlineParamCount);
+      new (getInlineBegin() + m_inlineParamCount++) Param(*first);
+    }
+  }
+
+  auto clearInlineParams() noexcept -> void {
+    for (auto* itr = getInlineBegin(); itr != getInlineEnd(); ++itr) {
+      itr->~Param();
+    }
+    m_inlineParamCount = 0U;
+  }
 };
 
 } // namespace tria::log
@@ -7,6 +7,7 @@ namespace tria::log {
 /*
  * Static metadata about a log message. Can be constructed at compile-time (constexpr) and stored
  * in static memory in the binary.
+ * Note: Metadata has to outlive the sinks, sinks cache pre-formatted call-site data by address.
  */
 class MetaData final {
 public:
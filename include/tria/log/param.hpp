@@ -1,6 +1,8 @@
 #pragma once
 #include "tria/fs.hpp"
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -32,24 +34,174 @@ private:
   size_t m_size;
 };
 
+/* String storage that keeps short strings inline, only longer strings are heap allocated.
+ * Avoids a heap allocation for the common case of logging short strings.
+ * Can also reference (borrow) a string that outlives it, see 'borrow()'.
+ */
+class InlineStr final {
+  constexpr static uint8_t s_heapTag     = UINT8_MAX;
+  constexpr static uint8_t s_borrowedTag = UINT8_MAX - 1U;
+
+public:
+  constexpr static size_t s_inlineCapacity = 24U;
+
+  InlineStr() noexcept : m_inlineSize{0U} {}
+  InlineStr(std::string_view str) noexcept { assign(str); }
+  InlineStr(const InlineStr& rhs) noexcept { copy(rhs); }
+  InlineStr(InlineStr&& rhs) noexcept : m_data{rhs.m_data}, m_inlineSize{rhs.m_inlineSize} {
+    rhs.m_inlineSize = 0U;
+  }
+  ~InlineStr() { release(); }
+
+  auto operator=(const InlineStr& rhs) noexcept -> InlineStr& {
+    if (this != &rhs) {
+      release();
+      copy(rhs);
+    }
+    return *this;
+  }
+
+  auto operator=(InlineStr&& rhs) noexcept -> InlineStr& {
+    if (this != &rhs) {
+      release();
+      m_data           = rhs.m_data;
+      m_inlineSize     = rhs.m_inlineSize;
+      rhs.m_inlineSize = 0U;
+    }
+    return *this;
+  }
+
+  /* Reference the string without copying it, copies of the result reference it as well.
+   * Note: The string has to outlive the result and all its copies.
+   */
+  [[nodiscard]] static auto borrow(std::string_view str) noexcept -> InlineStr {
+    auto result                 = InlineStr{};
+    result.m_data.borrowed.ptr  = str.data();
+    result.m_data.borrowed.size = str.size();
+    result.m_inlineSize         = s_borrowedTag;
+    return result;
+  }
+
+  auto operator==(const InlineStr& rhs) const noexcept -> bool { return view() == rhs.view(); }
+
+  [[nodiscard]] auto isInline() const noexcept {
+    return m_inlineSize != s_heapTag && m_inlineSize != s_borrowedTag;
+  }
+
+  [[nodiscard]] auto isBorrowed() const noexcept { return m_inlineSize == s_borrowedTag; }
+
+  [[nodiscard]] auto view() const noexcept -> std::string_view {
+    switch (m_inlineSize) {
+    case s_heapTag:
+      return {m_data.heap.ptr, m_data.heap.size};
+    case s_borrowedTag:
+      return {m_data.borrowed.ptr, m_data.borrowed.size};
+    default:
+      return {m_data.chars, m_inlineSize};
+    }
+  }
+
+private:
+  union Data {
+    char chars[s_inlineCapacity];
+    struct {
+      char* ptr;
+      size_t size;
+    } heap;
+    struct {
+      const char* ptr;
+      size_t size;
+    } borrowed;
+  } m_data;
+  uint8_t m_inlineSize; // 's_heapTag' / 's_borrowedTag' indicate the string is not stored inline.
+
+  auto assign(std::string_view str) noexcept -> void {
+    if (str.size() <= s_inlineCapacity) {
+      std::memcpy(m_data.chars, str.data(), str.size());
+      m_inlineSize = static_cast<uint8_t>(str.size());
+    } else {
+      m_data.heap.ptr  = new char[str.size()];
+      m_data.heap.size = str.size();
+      std::memcpy(m_data.heap.ptr, str.data(), str.size());
+      m_inlineSize = s_heapTag;
+    }
+  }
+
+  auto copy(const InlineStr& rhs) noexcept -> void {
+    if (rhs.isBorrowed()) {
+      m_data       = rhs.m_data;
+      m_inlineSize = s_borrowedTag;
+    } else {
+      assign(rhs.view());
+    }
+  }
+
+  auto release() noexcept -> void {
+    if (m_inlineSize == s_heapTag) {
+      delete[] m_data.heap.ptr;
+    }
+  }
+};
+
+/* String that is logged without copying it, only a pointer and a size are stored.
+ * Meant for string literals and other strings with static storage duration (for example names
+ * from a constant lookup table), not for strings owned by objects that can be destroyed.
+ * Note: The string has to outlive the logger and its sinks.
+ *
+ * Example usage:
+ * LOG_I(logger, "Swapchain created", {"presentMode", log::StaticStr{"mailbox"}});
+ */
+class StaticStr final {
+public:
+  constexpr explicit StaticStr(std::string_view str) noexcept : m_str{str} {}
+
+  [[nodiscard]] constexpr auto view() const noexcept { return m_str; }
+
+private:
+  std::string_view m_str;
+};
+
+/* File-system path, stored as a string in the narrow platform format.
+ * Short paths are stored inline, longer paths are interned in a global pool and only referenced,
+ * so logging the same path again does not allocate. The pool is bounded, when it is full paths are
+ * copied instead.
+ * Separators are normalized when the path is written.
+ */
+class PathStr final {
+public:
+  explicit PathStr(const fs::path& path) noexcept;
+
+  auto operator==(const PathStr& rhs) const noexcept -> bool { return m_str == rhs.m_str; }
+
+  [[nodiscard]] auto isInterned() const noexcept { return m_str.isBorrowed(); }
+
+  [[nodiscard]] auto view() const noexcept { return m_str.view(); }
+
+private:
+  InlineStr m_str;
+};
+
 /* Supported output mode for writing a value.
  */
 enum class ParamWriteMode {
   Pretty,
   Json,
+  Binary, // Compact binary encoding, used by the binary sink.
 };
 
 /* Value of a log parameter.
  * Supported types:
  * - Integer types (stored in a signed/unsigned 64 bit integer).
- * - Floating point types (float and double, stored as a double).
+ * - Floating point types (float and double, written with their own precision).
  * - Bool.
- * - String (stored as a copy).
+ * - String (stored as a copy, short strings are stored inline without a heap allocation).
+ * - StaticStr (string that outlives the logger, stored as a reference without copying).
+ * - Path (stored as the narrow string representation, long paths are interned).
  * - Duration (std::chrono::duration<double>).
  * - TimePoint (std::chrono::system_clock::time_point).
  * - MemSize (wrapper around size_t).
  *
- * Note: Because it can store std::string it should be moved whenever possible.
+ * Note: Because it can store (heap allocated) long strings it should be moved whenever possible.
  */
 class Value final {
 public:
@@ -67,15 +219,19 @@ public:
 
   Value(bool value) noexcept : m_val{value} {}
 
+  Value(float value) noexcept : m_val{value} {}
+
   Value(double value) noexcept : m_val{value} {}
 
-  Value(const char* value) noexcept : Value(std::string(value)) {}
+  Value(const char* value) noexcept : m_val{InlineStr{value}} {}
+
+  Value(std::string_view value) noexcept : m_val{InlineStr{value}} {}
 
-  Value(std::string_view value) noexcept : Value(std::string(value)) {}
+  Value(const std::string& value) noexcept : m_val{InlineStr{value}} {}
 
-  Value(std::string value) noexcept : m_val{std::move(value)} {}
+  Value(StaticStr value) noexcept : m_val{InlineStr::borrow(value.view())} {}
 
-  Value(fs::path value) noexcept : m_val{std::move(value)} {}
+  Value(const fs::path& value) noexcept : m_val{PathStr{value}} {}
 
   Value(Duration value) noexcept : m_val{value} {}
 
@@ -95,10 +251,21 @@ public:
   auto write(std::string* tgtStr, ParamWriteMode mode) const noexcept -> void;
 
 private:
-  using ValueType = std::
-      variant<int64_t, uint64_t, double, bool, std::string, fs::path, Duration, TimePoint, MemSize>;
+  using ValueType = std::variant<
+      int64_t,
+      uint64_t,
+      double,
+      float,
+      bool,
+      InlineStr,
+      PathStr,
+      Duration,
+      TimePoint,
+      MemSize>;
 
   ValueType m_val;
+
+  auto writeBinary(std::string* tgtStr) const noexcept -> void;
 };
 
 /* Factory that constructs a Value (or a std::vector<Value>) from an arbitrary type.
@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+
+namespace tria::log {
+
+/* Configuration for rate limiting a log call-site.
+ */
+struct RateLimit final {
+  enum class Kind : uint8_t {
+    PerSecond, // Allow up to 'amount' messages every second.
+    Sample,    // Allow one in every 'amount' messages.
+  };
+
+  Kind kind;
+  uint32_t amount;
+};
+
+/* Allow up to 'amount' messages per second.
+ */
+[[nodiscard]] constexpr auto perSecond(uint32_t amount) noexcept -> RateLimit {
+  return {RateLimit::Kind::PerSecond, amount};
+}
+
+/* Allow one in every 'amount' messages.
+ */
+[[nodiscard]] constexpr auto oneIn(uint32_t amount) noexcept -> RateLimit {
+  return {RateLimit::Kind::Sample, amount};
+}
+
+/*
+ * Rate limiter for a single log call-site, see the 'LOG_RATE' macro.
+ * Only uses (relaxed) atomic counters so it is thread-safe and cheap enough to check on the calling
+ * thread, suppressed messages are counted but never constructed.
+ * Note: Has a constexpr constructor and a trivial destructor so function-local statics are constant
+ * initialized and stay usable until the end of the program (loggers keep pointers to them).
+ */
+class RateLimiter final {
+public:
+  constexpr explicit RateLimiter(RateLimit limit) noexcept :
+      m_limit{limit}, m_window{-1}, m_count{0U}, m_suppressed{0U}, m_tracked{false} {
+    assert(limit.kind != RateLimit::Kind::Sample || limit.amount != 0U);
+  }
+
+  RateLimiter(const RateLimiter& rhs)     = delete;
+  RateLimiter(RateLimiter&& rhs) noexcept = delete;
+
+  auto operator=(const RateLimiter& rhs) -> RateLimiter& = delete;
+  auto operator=(RateLimiter&& rhs) noexcept -> RateLimiter& = delete;
+
+  /* Check if a message is allowed to be logged.
+   * When allowed, 'suppressed' is set to the amount of messages that have been suppressed since the
+   * previous allowed message.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto tryAcquire(uint64_t* suppressed) noexcept -> bool {
+    if (!isAllowed()) {
+      m_suppressed.fetch_add(1U, std::memory_order_relaxed);
+      return false;
+    }
+    *suppressed = m_suppressed.exchange(0U, std::memory_order_relaxed);
+    return true;
+  }
+
+  /* Take the amount of messages that have been suppressed since they were last reported.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto takeSuppressed() noexcept -> uint64_t {
+    return m_suppressed.exchange(0U, std::memory_order_relaxed);
+  }
+
+  /* Returns true if no logger is tracking the limiter yet, the caller then has to register it with
+   * the logger that periodically reports its suppressed messages.
+   * The suppressed count belongs to the call-site, so it is reported by the tracking logger even
+   * when the call-site is shared between loggers.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto claimTracking() noexcept -> bool {
+    return !m_tracked.load(std::memory_order_relaxed) &&
+        !m_tracked.exchange(true, std::memory_order_relaxed);
+  }
+
+  /* Called by the tracking logger when it stops tracking, allows another logger to claim it.
+   * Is thread-safe.
+   */
+  auto releaseTracking() noexcept -> void { m_tracked.store(false, std::memory_order_relaxed); }
+
+private:
+  RateLimit m_limit;
+  std::atomic<int64_t> m_window; // Second that the current count applies to.
+  std::atomic<uint64_t> m_count; // 64 bit so sampling stays exact, it never wraps in practice.
+  std::atomic<uint64_t> m_suppressed;
+  std::atomic<bool> m_tracked;
+
+  [[nodiscard]] auto isAllowed() noexcept -> bool {
+    switch (m_limit.kind) {
+    case RateLimit::Kind::PerSecond: {
+      using namespace std::chrono;
+      const auto now = duration_cast<seconds>(steady_clock::now().time_since_epoch()).count();
+      auto window    = m_window.load(std::memory_order_relaxed);
+      if (now != window && m_window.compare_exchange_strong(window, now)) {
+        // First message of a new second: reset the count.
+        // Note: Racing callers can still count towards the previous second, this is acceptable as
+        // the limit does not have to be exact.
+        m_count.store(0U, std::memory_order_relaxed);
+      }
+      return m_count.fetch_add(1U, std::memory_order_relaxed) < m_limit.amount;
+    }
+    case RateLimit::Kind::Sample:
+      return m_count.fetch_add(1U, std::memory_order_relaxed) % m_limit.amount == 0U;
+    }
+    return true;
+  }
+};
+
+} // namespace tria::log
@@ -0,0 +1,53 @@
+#pragma once
+#include "tria/fs.hpp"
+#include "tria/log/sink.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace tria::log {
+
+/*
+ * Reader that follows a shared ring log (as written by the shared ring sink).
+ * Messages are decoded directly from the memory-mapped file, the reader never blocks the writer.
+ * When the reader falls behind (more than the capacity of the ring) the overwritten messages are
+ * skipped, they are counted as lost.
+ *
+ * Note: Not thread-safe.
+ */
+class RingReader final {
+  class Impl;
+
+public:
+  /* Open a shared ring log, reading starts at the oldest message that is still in the ring.
+   * Throws a 'LogDecodeErr' if the file cannot be opened or is not a shared ring log.
+   */
+  explicit RingReader(const fs::path& path);
+  RingReader(const RingReader& rhs)     = delete;
+  RingReader(RingReader&& rhs) noexcept = delete;
+  ~RingReader();
+
+  auto operator=(const RingReader& rhs) -> RingReader& = delete;
+  auto operator=(RingReader&& rhs) noexcept -> RingReader& = delete;
+
+  /* Decode the messages that have been published since the last poll and write them to the sink.
+   * Messages that are not in the mask of the sink are skipped.
+   * Returns the amount of messages that were written to the sink.
+   *
+   * Throws a 'LogDecodeErr' if the log contains invalid data.
+   */
+  auto poll(Sink* sink) -> size_t;
+
+  /* Amount of messages that were lost, either because they were overwritten before they were read
+   * or because the writer could not store them.
+   */
+  [[nodiscard]] auto getLostCount() const noexcept -> uint64_t;
+
+  /* Has the writer been closed, no new messages will be published.
+   */
+  [[nodiscard]] auto isWriterClosed() const noexcept -> bool;
+
+private:
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace tria::log
@@ -2,6 +2,8 @@
 #include "tria/fs.hpp"
 #include "tria/log/level.hpp"
 #include "tria/log/message.hpp"
+#include "tria/log/metadata.hpp"
+#include <chrono>
 #include <memory>
 
 namespace tria::log {
@@ -31,6 +33,32 @@ public:
    */
   virtual auto write(const Message& msg) noexcept -> void = 0;
 
+  /* Write a batch of messages to the sink, messages are in publish order.
+   * Batch can contain messages that are not in the mask of the sink, the default implementation
+   * skips those and calls 'write' for the others.
+   * Sinks can override this to handle a whole batch at once.
+   * Note: Does not need to be reentrant as will not be called in parallel.
+   */
+  virtual auto writeBatch(const Message* begin, const Message* end) noexcept -> void {
+    for (auto* itr = begin; itr != end; ++itr) {
+      if (isInMask(m_mask, itr->getMeta()->getLevel())) {
+        write(*itr);
+      }
+    }
+  }
+
+  /* Called by the logger in between batches, also while no messages are being logged (at the
+   * latest at the returned time). Sinks can use it to finish work they deferred, for example
+   * flushing data that was held back by 'FlushPolicy::Interval'.
+   * Returns the time the sink wants to be called again at, 'time_point::max()' if it has no
+   * deferred work.
+   * Note: Does not need to be reentrant as will not be called in parallel.
+   */
+  virtual auto idle(std::chrono::steady_clock::time_point /*unused*/) noexcept
+      -> std::chrono::steady_clock::time_point {
+    return std::chrono::steady_clock::time_point::max();
+  }
+
 protected:
   Sink(LevelMask mask) noexcept : m_mask{mask} {}
 
@@ -40,6 +68,78 @@ private:
 
 using SinkUnique = std::unique_ptr<Sink>;
 
+/* Policy that controls when file sinks flush their data to the operating system.
+ */
+struct FlushPolicy final {
+  enum class Kind : uint8_t {
+    Batch,    // Flush after every batch of messages.
+    Interval, // Flush at most once every 'interval', data is flushed at the latest 'interval' after
+              // it was written (also when no more messages are logged).
+    Error,    // Flush after a batch that contains an error message.
+  };
+
+  Kind kind;
+  std::chrono::milliseconds interval;
+};
+
+[[nodiscard]] constexpr auto flushPerBatch() noexcept -> FlushPolicy {
+  return {FlushPolicy::Kind::Batch, std::chrono::milliseconds{0}};
+}
+
+[[nodiscard]] constexpr auto flushInterval(std::chrono::milliseconds interval) noexcept
+    -> FlushPolicy {
+  return {FlushPolicy::Kind::Interval, interval};
+}
+
+[[nodiscard]] constexpr auto flushOnError() noexcept -> FlushPolicy {
+  return {FlushPolicy::Kind::Error, std::chrono::milliseconds{0}};
+}
+
+/* Policy that controls when file sinks switch to a new file.
+ * The active file is always written at the given path, on rotation it is renamed to 'path.1' and
+ * the previously rotated files shift up ('path.1' becomes 'path.2' etc), files beyond 'maxFiles'
+ * are deleted.
+ * Rotating only costs the log thread renaming the old file and a file that was prepared in advance
+ * (at 'path.next'), closing the old file, preparing (and preallocating) the next file and deleting
+ * old files are done on a background thread.
+ */
+struct RotationPolicy final {
+  uint64_t maxSize;                 // Rotate once the file reaches this size (0 = no limit).
+  std::chrono::milliseconds maxAge; // Rotate once the file is this old (0 = no limit).
+  uint32_t maxFiles;                // Amount of rotated files to keep, besides the active file.
+  uint64_t preallocateSize;         // Reserve disk space for every new file (0 = disabled).
+
+  [[nodiscard]] constexpr auto isEnabled() const noexcept {
+    return maxSize != 0U || maxAge.count() != 0;
+  }
+};
+
+[[nodiscard]] constexpr auto noRotation() noexcept -> RotationPolicy {
+  return {0U, std::chrono::milliseconds{0}, 0U, 0U};
+}
+
+[[nodiscard]] constexpr auto
+rotateBySize(uint64_t maxSize, uint32_t maxFiles, uint64_t preallocateSize = 0U) noexcept
+    -> RotationPolicy {
+  return {maxSize, std::chrono::milliseconds{0}, maxFiles, preallocateSize};
+}
+
+[[nodiscard]] constexpr auto rotateByAge(
+    std::chrono::milliseconds maxAge, uint32_t maxFiles, uint64_t preallocateSize = 0U) noexcept
+    -> RotationPolicy {
+  return {0U, maxAge, maxFiles, preallocateSize};
+}
+
+/* Compression of the data written by file sinks.
+ * Compressed logs can be decompressed using the 'decompressLog' api ('tria/log/decompress.hpp') or
+ * the 'tria_logdecompress' tool, for example:
+ * $ tria_logdecompress app.log.tlz | jq '.message'
+ */
+enum class Compression : uint8_t {
+  None,
+  Lz, // Fast LZ4 style compression, every batch is compressed as a block (see 'tria/math/lz.hpp').
+};
+
 template <typename T>
 auto sinkVectorPush(std::vector<T>&) noexcept -> void {}
 
@@ -84,7 +184,12 @@ template <typename... Sinks>
  */
 
 [[nodiscard]] auto makeConsoleJsonSink(LevelMask mask = allLevelMask()) -> SinkUnique;
-[[nodiscard]] auto makeFileJsonSink(fs::path path, LevelMask mask = allLevelMask()) -> SinkUnique;
+[[nodiscard]] auto makeFileJsonSink(
+    fs::path path,
+    LevelMask mask                = allLevelMask(),
+    FlushPolicy flushPolicy       = flushPerBatch(),
+    RotationPolicy rotationPolicy = noRotation(),
+    Compression compression       = Compression::None) -> SinkUnique;
 
 /* PrettySink
  * Log sink that outputs every log as a (styled) pretty printed line.
@@ -97,6 +202,53 @@ template <typename... Sinks>
  */
 
 [[nodiscard]] auto makeConsolePrettySink(LevelMask mask = allLevelMask()) -> SinkUnique;
-[[nodiscard]] auto makeFilePrettySink(fs::path path, LevelMask mask = allLevelMask()) -> SinkUnique;
+[[nodiscard]] auto makeFilePrettySink(
+    fs::path path,
+    LevelMask mask                = allLevelMask(),
+    FlushPolicy flushPolicy       = flushPerBatch(),
+    RotationPolicy rotationPolicy = noRotation(),
+    Compression compression       = Compression::None) -> SinkUnique;
+
+/* BinarySink
+ * Log sink that outputs every log in a compact binary format.
+ * Formatting is deferred: messages are written as raw parameter values and the metadata of a
+ * call-site and the parameter keys are only written once, this makes it considerably cheaper to
+ * write than the json or pretty sinks and produces smaller files.
+ *
+ * Binary logs can be decoded using the 'readBinaryLog' api ('tria/log/bin_reader.hpp') or the
+ * 'tria_logdecode' tool, for example:
+ * $ tria_logdecode app.tlog --json | jq '.message'
+ */
+
+[[nodiscard]] auto makeFileBinarySink(
+    fs::path path,
+    LevelMask mask                = allLevelMask(),
+    FlushPolicy flushPolicy       = flushPerBatch(),
+    RotationPolicy rotationPolicy = noRotation(),
+    Compression compression       = Compression::None) -> SinkUnique;
+
+/* SharedRingSink
+ * Log sink that publishes messages into a ring buffer in a memory-mapped file, meant for local
+ * processes (like a log viewer) that follow the log live.
+ * Messages are stored in the binary log format (the call-site metadata and parameter keys in a
+ * separate table) and published by bumping a sequence counter, writing does not touch the file
+ * system write path and readers decode the messages directly from the mapping. When the ring is
+ * full the oldest messages are overwritten, readers that fall behind skip the overwritten messages.
+ *
+ * Shared ring logs can be followed using the 'RingReader' api ('tria/log/ring_reader.hpp') or the
+ * 'tria_logdecode' tool, for example:
+ * $ tria_logdecode app.tring --ring --follow
+ *
+ * 'ringSize' is the size of the ring in bytes (messages larger than a quarter of the ring are
+ * dropped) and 'tableSize' the size of the metadata table in bytes (messages from call-sites that
+ * do not fit are dropped).
+ * Note: An existing file at the path is replaced.
+ */
+
+[[nodiscard]] auto makeSharedRingSink(
+    fs::path path,
+    LevelMask mask   = allLevelMask(),
+    size_t ringSize  = 4U * 1024U * 1024U,
+    size_t tableSize = 1024U * 1024U) -> SinkUnique;
 
 } // namespace tria::log
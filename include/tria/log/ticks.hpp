@@ -0,0 +1,38 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace tria::log {
+
+/* Source of the timestamps of log messages.
+ * With 'Ticks' the log macros only read the tick counter, the log thread converts the ticks to
+ * wall-clock time before handing the messages to the sinks.
+ */
+enum class TimeSource : uint8_t {
+  SystemClock, // Read the wall-clock ('std::chrono::system_clock') when creating the message.
+  Ticks,       // Read the tick counter ('readTicks()'), converted to wall-clock time by the logger.
+};
+
+/* Read the raw monotonic tick counter.
+ * On x86 this is the cpu timestamp counter (a single 'rdtsc' instruction), on other architectures
+ * it falls back to 'std::chrono::steady_clock'.
+ * Note: Ticks have no defined unit or relation to the wall-clock, converting them requires a
+ * calibration (done by the logger).
+ * Note: Assumes an invariant timestamp counter that is synchronized between cores, which is the
+ * case on all reasonably modern x86 cpus.
+ */
+[[nodiscard]] inline auto readTicks() noexcept -> uint64_t {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+} // namespace tria::log
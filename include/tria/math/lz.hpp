@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tria::math {
+
+/*
+ * Fast LZ77 style compression using the LZ4 block format.
+ * Meant for data that is compressed as a stream of (small) blocks, blocks can reference the data
+ * of the previous blocks (up to 'g_lzWindowSize' bytes back) so even tiny blocks compress well when
+ * the stream is repetitive. Because of this blocks have to be decompressed in the same order as
+ * they were compressed, using a single decompressor.
+ *
+ * Favors speed over compression ratio: single hash probe per position (greedy matching) and
+ * skipping ahead faster on data that does not compress.
+ */
+
+// Maximum distance a match can reference back.
+constexpr size_t g_lzWindowSize = 64U * 1024U;
+
+/* Maximum size of the compressed output for an input of the given size.
+ */
+[[nodiscard]] constexpr auto lzCompressBound(size_t size) noexcept -> size_t {
+  return size + size / 255U + 16U;
+}
+
+class LzCompressor final {
+public:
+  LzCompressor();
+
+  /* Forget the previous blocks, the next block starts a new stream.
+   */
+  auto reset() noexcept -> void;
+
+  /* Compress a block of data.
+   * 'out' has to be atleast 'lzCompressBound(size)' bytes.
+   * Returns the size of the compressed block.
+   */
+  auto compress(const uint8_t* data, size_t size, uint8_t* out) noexcept -> size_t;
+
+private:
+  std::vector<uint8_t> m_window; // Data of the previous blocks followed by the current block.
+  std::vector<uint32_t> m_table; // Hash of 4 bytes to the last position in the window.
+};
+
+class LzDecompressor final {
+public:
+  LzDecompressor() = default;
+
+  /* Forget the previous blocks, the next block starts a new stream.
+   */
+  auto reset() noexcept -> void;
+
+  /* Decompress a block of data, 'rawSize' is the size of the block before compressing.
+   * Returns a pointer to the decompressed data (valid until the next call) or null if the block is
+   * corrupt (after which the decompressor has to be reset).
+   */
+  [[nodiscard]] auto decompress(const uint8_t* data, size_t size, size_t rawSize) noexcept
+      -> const uint8_t*;
+
+private:
+  std::vector<uint8_t> m_window; // Data of the previous blocks followed by the current block.
+};
+
+} // namespace tria::math
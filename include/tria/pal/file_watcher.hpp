@@ -0,0 +1,41 @@
+#pragma once
+#include "tria/fs.hpp"
+#include <memory>
+#include <vector>
+
+namespace tria::pal {
+
+class NativeFileWatcher;
+
+/*
+ * Watches a directory (including its sub-directories) for file changes.
+ * Changes are buffered by the os until they are polled, no threads are used.
+ *
+ * Note: Api is NOT thread-safe.
+ */
+class FileWatcher final {
+public:
+  /* Start watching the given directory.
+   * Throws a 'PlatformErr' if the directory cannot be watched.
+   */
+  explicit FileWatcher(const fs::path& rootPath);
+  FileWatcher(const FileWatcher& rhs)     = delete;
+  FileWatcher(FileWatcher&& rhs) noexcept = default;
+  ~FileWatcher();
+
+  auto operator=(const FileWatcher& rhs) -> FileWatcher& = delete;
+  auto operator=(FileWatcher&& rhs) noexcept -> FileWatcher& = default;
+
+  /* Files that were written, created or moved into the directory since the last call.
+   * Paths are relative to the root directory and every file is reported only once per call.
+   * When the os dropped changes (because its buffer overflowed) all files in the directory are
+   * reported instead and 'overflowed' is set to true.
+   * Note: Does not block.
+   */
+  [[nodiscard]] auto poll(bool* overflowed) -> std::vector<fs::path>;
+
+private:
+  std::unique_ptr<NativeFileWatcher> m_native;
+};
+
+} // namespace tria::pal
@@ -0,0 +1,58 @@
+#pragma once
+#include "tria/fs.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace tria::pal {
+
+enum class MapMode : uint8_t {
+  ReadOnly,
+  ReadWrite,
+};
+
+/*
+ * File that is mapped into the address space of the process.
+ * The mapping is shared: writes through a 'ReadWrite' mapping are visible to other processes that
+ * map the same file (without going through the file system write path).
+ *
+ * Note: The mapping stays valid after the file is deleted or replaced, but truncating a mapped
+ * file (from any process) makes accessing the truncated part of the mapping fail.
+ */
+class MappedFile final {
+public:
+  /* Map an existing file.
+   * Throws a 'PlatformErr' if the file cannot be opened or mapped.
+   */
+  [[nodiscard]] static auto open(const fs::path& path, MapMode mode) -> MappedFile;
+
+  /* Create a new zero initialized file of the given size and map it (read-write).
+   * An existing file at the path is replaced (instead of truncated) so processes that still map it
+   * are unaffected.
+   * Throws a 'PlatformErr' if the file cannot be created or mapped.
+   */
+  [[nodiscard]] static auto create(const fs::path& path, size_t size) -> MappedFile;
+
+  MappedFile() noexcept : m_data{nullptr}, m_size{0U} {}
+  MappedFile(const MappedFile& rhs) = delete;
+  MappedFile(MappedFile&& rhs) noexcept : m_data{rhs.m_data}, m_size{rhs.m_size} {
+    rhs.m_data = nullptr;
+    rhs.m_size = 0U;
+  }
+  ~MappedFile() noexcept;
+
+  auto operator=(const MappedFile& rhs) -> MappedFile& = delete;
+  auto operator=(MappedFile&& rhs) noexcept -> MappedFile&;
+
+  [[nodiscard]] auto getData() const noexcept -> uint8_t* { return m_data; }
+  [[nodiscard]] auto getSize() const noexcept -> size_t { return m_size; }
+
+private:
+  uint8_t* m_data;
+  size_t m_size;
+
+  MappedFile(uint8_t* data, size_t size) noexcept : m_data{data}, m_size{size} {}
+
+  auto unmap() noexcept -> void;
+};
+
+} // namespace tria::pal
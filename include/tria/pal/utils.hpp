@@ -1,6 +1,7 @@
 #pragma once
 #include "tria/fs.hpp"
 #include <cstdint>
+#include <cstdio>
 #include <string>
 #include <string_view>
 
@@ -30,6 +31,18 @@ auto setThreadName(std::string_view name) noexcept -> bool;
  */
 [[nodiscard]] auto getThreadName() noexcept -> std::string;
 
+/* Reserve disk space for the file without changing its (visible) size.
+ * Appending to a preallocated file avoids allocating new blocks (and updating the file metadata)
+ * on every write.
+ * Note: Not all platforms / filesystems implement this feature (returns false if it fails).
+ */
+auto preallocateFile(std::FILE* file, uint64_t size) noexcept -> bool;
+
+/* Release disk space that was reserved (using 'preallocateFile') beyond the end of the file.
+ * Note: Flushes the file.
+ */
+auto trimFile(std::FILE* file) noexcept -> bool;
+
 /* Setup the console (if attached) for console output.
  * Returns true if a console is present or false if no console is present (for example if the output
  * is redirected to a file).
@@ -0,0 +1,187 @@
+#include "tria/asset/archive.hpp"
+#include "internal/archive_format.hpp"
+#include "tria/asset/asset.hpp"
+#include "tria/asset/err/archive_err.hpp"
+#include "tria/asset/file_data.hpp"
+#include "tria/math/lz.hpp"
+#include "tria/pal/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace tria::asset {
+
+using namespace internal;
+
+namespace {
+
+// Compressed entries have to be decompressed into a heap buffer on load (instead of being mapped),
+// so only compress entries when that saves atleast an eighth of the size.
+constexpr uint64_t g_minCompressionGain = 8U;
+
+struct SrcFile final {
+  AssetId id;
+  fs::path path;
+};
+
+[[nodiscard]] constexpr auto alignUp(uint64_t val, uint64_t align) noexcept {
+  return (val + align - 1U) / align * align;
+}
+
+[[nodiscard]] auto findFiles(const fs::path& srcDir, const fs::path& archivePath)
+    -> std::vector<SrcFile> {
+  auto result  = std::vector<SrcFile>{};
+  auto listErr = std::error_code{};
+  for (auto itr = fs::recursive_directory_iterator{srcDir, listErr};
+       !listErr && itr != fs::recursive_directory_iterator{};
+       itr.increment(listErr)) {
+    if (!itr->is_regular_file(listErr)) {
+      continue;
+    }
+    // Skip the (previous version of the) archive itself when it is written to the source dir.
+    auto equivalentErr = std::error_code{};
+    if (fs::equivalent(itr->path(), archivePath, equivalentErr)) {
+      continue;
+    }
+    result.push_back(SrcFile{itr->path().lexically_relative(srcDir).generic_string(), itr->path()});
+  }
+  if (listErr) {
+    throw err::ArchiveErr{srcDir, "Failed to list files: " + listErr.message()};
+  }
+  // Sorted so the table of contents can be binary searched.
+  std::sort(result.begin(), result.end(), [](const SrcFile& a, const SrcFile& b) {
+    return a.id < b.id;
+  });
+  return result;
+}
+
+[[nodiscard]] auto readFile(const fs::path& path) -> std::vector<uint8_t> {
+  auto file = std::ifstream{path.string(), std::ios::ate | std::ios::binary};
+  if (!file.is_open()) {
+    throw err::ArchiveErr{path, "Failed to open file"};
+  }
+  const auto size = file.tellg();
+  if (size < 0) {
+    throw err::ArchiveErr{path, "Failed to open file"};
+  }
+  auto result = std::vector<uint8_t>(static_cast<size_t>(size));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(result.data()), size);
+  if (!file.good()) {
+    throw err::ArchiveErr{path, "Failed to read file"};
+  }
+  return result;
+}
+
+auto writeZeroes(std::ofstream& file, uint64_t count) {
+  constexpr auto zeroes = std::array<char, 256>{};
+  while (count != 0U) {
+    const auto chunk = std::min<uint64_t>(count, zeroes.size());
+    file.write(zeroes.data(), static_cast<std::streamsize>(chunk));
+    count -= chunk;
+  }
+}
+
+} // namespace
+
+auto packArchive(
+    const fs::path& srcDir, const fs::path& archivePath, ArchiveCompression compression)
+    -> ArchiveStats {
+  auto fsErr = std::error_code{};
+  if (!fs::is_directory(srcDir, fsErr)) {
+    throw err::ArchiveErr{srcDir, "Source is not a directory"};
+  }
+  const auto files = findFiles(srcDir, archivePath);
+
+  auto header       = ArchiveHeader{};
+  header.magic      = g_archiveMagic;
+  header.version    = g_archiveVersion;
+  header.entryCount = static_cast<uint32_t>(files.size());
+  auto entries      = std::vector<ArchiveEntry>(files.size());
+  auto ids          = std::string{};
+  for (auto i = 0U; i != files.size(); ++i) {
+    entries[i].idOffset = ids.size();
+    entries[i].idSize   = static_cast<uint32_t>(files[i].id.size());
+    ids += files[i].id;
+  }
+  header.idsSize = static_cast<uint32_t>(ids.size());
+
+  // Write to a temporary file and then replace the archive, existing mappings of the old archive
+  // stay valid this way.
+  auto tmpPath = archivePath;
+  tmpPath += "." + std::to_string(pal::getCurProcessId()) + ".tmp";
+  auto stats = ArchiveStats{};
+  try {
+    auto file = std::ofstream{tmpPath.string(), std::ios::binary | std::ios::trunc};
+    if (!file.is_open()) {
+      throw err::ArchiveErr{tmpPath, "Failed to create file"};
+    }
+
+    // Table of contents is written last, once the data offsets are known.
+    auto offset = getArchiveTocSize(entries.size());
+    writeZeroes(file, offset);
+    file.write(ids.data(), static_cast<std::streamsize>(ids.size()));
+    offset += ids.size();
+
+    auto compressor = math::LzCompressor{};
+    auto compressed = std::vector<uint8_t>{};
+    for (auto i = 0U; i != files.size(); ++i) {
+      const auto data = readFile(files[i].path);
+      auto& entry     = entries[i];
+      entry.rawSize   = data.size();
+      stats.srcSize += data.size();
+
+      const uint8_t* storedData = data.data();
+      entry.dataSize            = data.size();
+      entry.compression         = static_cast<uint32_t>(ArchiveCompression::None);
+      if (compression == ArchiveCompression::Lz && !data.empty()) {
+        // Every entry is compressed as a separate stream, so they can be decompressed on their own.
+        compressor.reset();
+        compressed.resize(math::lzCompressBound(data.size()));
+        const auto size = compressor.compress(data.data(), data.size(), compressed.data());
+        if (size < data.size() - data.size() / g_minCompressionGain) {
+          storedData        = compressed.data();
+          entry.dataSize    = size;
+          entry.compression = static_cast<uint32_t>(ArchiveCompression::Lz);
+          ++stats.compressedCount;
+        }
+      }
+
+      const auto alignedOffset = alignUp(offset, g_archiveDataAlign);
+      writeZeroes(file, alignedOffset - offset);
+      entry.dataOffset = alignedOffset;
+      file.write(
+          reinterpret_cast<const char*>(storedData), static_cast<std::streamsize>(entry.dataSize));
+      offset = alignedOffset + entry.dataSize;
+      if (entry.compression == static_cast<uint32_t>(ArchiveCompression::None)) {
+        writeZeroes(file, g_fileDataPadding);
+        offset += g_fileDataPadding;
+      }
+    }
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(ArchiveHeader));
+    file.write(
+        reinterpret_cast<const char*>(entries.data()),
+        static_cast<std::streamsize>(entries.size() * sizeof(ArchiveEntry)));
+    file.close();
+    if (!file.good()) {
+      throw err::ArchiveErr{tmpPath, "Failed to write file"};
+    }
+    fs::rename(tmpPath, archivePath);
+
+    stats.entryCount  = header.entryCount;
+    stats.archiveSize = offset;
+  } catch (const fs::filesystem_error& e) {
+    fs::remove(tmpPath, fsErr);
+    throw err::ArchiveErr{archivePath, e.what()};
+  } catch (...) {
+    fs::remove(tmpPath, fsErr);
+    throw;
+  }
+  return stats;
+}
+
+} // namespace tria::asset
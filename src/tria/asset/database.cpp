@@ -3,11 +3,29 @@
 
 namespace tria::asset {
 
-Database::Database(log::Logger* logger, fs::path rootPath) :
-    m_impl{std::make_unique<DatabaseImpl>(logger, std::move(rootPath))} {}
+Database::Database(
+    log::Logger* logger, fs::path rootPath, uint32_t workerCount, fs::path cachePath) :
+    m_impl{std::make_unique<DatabaseImpl>(
+        logger, std::move(rootPath), workerCount, std::move(cachePath))} {}
 
 Database::~Database() = default;
 
 auto Database::get(const AssetId& id) -> const Asset* { return m_impl->get(id); }
 
+auto Database::acquire(const AssetId& id) -> AssetHandle { return m_impl->acquire(id); }
+
+auto Database::getAsync(const AssetId& id) -> AssetFuture { return m_impl->getAsync(id); }
+
+auto Database::preload(const std::vector<AssetId>& ids) -> std::vector<AssetFuture> {
+  return m_impl->preload(ids);
+}
+
+auto Database::setMemoryBudget(uint64_t bytes) -> void { m_impl->setMemoryBudget(bytes); }
+
+auto Database::enableHotReload() -> void { m_impl->enableHotReload(); }
+
+auto Database::update() -> std::vector<AssetReload> { return m_impl->update(); }
+
+auto Database::getStats() const noexcept -> DatabaseStats { return m_impl->getStats(); }
+
 } // namespace tria::asset
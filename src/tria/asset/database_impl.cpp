@@ -2,10 +2,18 @@
 #include "internal/loader.hpp"
 #include "tria/asset/asset.hpp"
 #include "tria/asset/err/asset_load_err.hpp"
+#include "tria/asset/graphic.hpp"
+#include "tria/asset/raw_asset.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include "tria/pal/mapped_file.hpp"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstring>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
 
 namespace tria::asset {
 
@@ -13,17 +21,17 @@ using Clock = std::chrono::high_resolution_clock;
 
 namespace {
 
-// Pad every file buffer with this amount of zero bytes at the end, parsers can rely on this fact
-// and try to read atleast this amount 'past' the file.
-constexpr size_t g_fileBufferPadding = 32;
-
 // Maximum file size we support, guard against allocating huge amounts of memory.
 constexpr size_t g_maxFileSize = 512 * 1024 * 1024;
 
-auto loadRaw(const fs::path& path) -> math::RawData {
-  if (!fs::is_regular_file(path)) {
-    throw err::AssetLoadErr(path, "Path is not a file");
-  }
+// Files smaller then this are read into a heap buffer, for small files mapping is not worth it.
+constexpr size_t g_mapMinFileSize = 64 * 1024;
+
+// Smallest page size of the supported platforms, the remainder of the last page of a mapping is
+// zero filled by the os.
+constexpr size_t g_minPageSize = 4 * 1024;
+
+auto readRaw(const fs::path& path) -> FileData {
   auto file = std::ifstream{path.string(), std::ios::ate | std::ios::binary};
   if (!file.is_open()) {
     throw err::AssetLoadErr(path, "Failed to open file");
@@ -35,38 +43,399 @@ auto loadRaw(const fs::path& path) -> math::RawData {
   if (static_cast<size_t>(fileSize) > g_maxFileSize) {
     throw err::AssetLoadErr(path, "File too big");
   }
-  auto buffer = math::RawData{static_cast<size_t>(fileSize) + g_fileBufferPadding};
+  const auto size = static_cast<size_t>(fileSize);
+  auto buffer     = std::make_shared<math::RawData>(size + g_fileDataPadding);
   file.seekg(0);
-  file.read(reinterpret_cast<char*>(buffer.begin()), fileSize);
+  file.read(reinterpret_cast<char*>(buffer->begin()), fileSize);
   file.close();
 
   // Zero initialize the padding area.
-  std::memset(buffer.end() - g_fileBufferPadding, 0, g_fileBufferPadding);
+  std::memset(buffer->begin() + size, 0, g_fileDataPadding);
+
+  const auto* data = buffer->begin();
+  return FileData{std::move(buffer), data, size, false};
+}
+
+/* Load the contents of a file, large files are memory mapped if 'allowMap' is true.
+ * Note: Mapped files should be replaced instead of truncated while they are in use, accessing the
+ * truncated part of a mapping fails and rewritten parts show the new contents.
+ */
+auto loadRaw(const fs::path& path, bool allowMap) -> FileData {
+  if (!fs::is_regular_file(path)) {
+    throw err::AssetLoadErr(path, "Path is not a file");
+  }
+  auto sizeErr        = std::error_code{};
+  const auto fileSize = fs::file_size(path, sizeErr);
+  if (!allowMap || sizeErr || fileSize < g_mapMinFileSize) {
+    return readRaw(path);
+  }
+  if (fileSize > g_maxFileSize) {
+    throw err::AssetLoadErr(path, "File too big");
+  }
+  auto mapping = std::shared_ptr<pal::MappedFile>{};
+  try {
+    mapping = std::make_shared<pal::MappedFile>(
+        pal::MappedFile::open(path, pal::MapMode::ReadOnly));
+  } catch (const pal::err::PlatformErr& e) {
+    throw err::AssetLoadErr(path, e.what());
+  }
+  // The zero padding is provided by the unused remainder of the last page, if there is not enough
+  // room left in the last page we fall back to reading the file into a padded buffer.
+  const auto size = mapping->getSize();
+  const auto tail = size % g_minPageSize;
+  if (tail == 0U || g_minPageSize - tail < g_fileDataPadding) {
+    return readRaw(path);
+  }
+  const auto* data = mapping->getData();
+  return FileData{std::move(mapping), data, size, true};
+}
+
+[[nodiscard]] auto getMemSize(const Asset& asset) noexcept -> uint64_t {
+  switch (asset.getKind()) {
+  case AssetKind::Raw:
+    return asset.downcast<RawAsset>()->getSize();
+  case AssetKind::Mesh: {
+    const auto* mesh = asset.downcast<Mesh>();
+    return mesh->getVertexCount() * sizeof(Vertex) + mesh->getIndexCount() * sizeof(IndexType);
+  }
+  case AssetKind::Texture:
+    return asset.downcast<Texture>()->getPixelCount() * sizeof(Pixel);
+  case AssetKind::Shader: {
+    const auto* shader = asset.downcast<Shader>();
+    return shader->getSize() + shader->getResourceCount() * sizeof(ShaderResource);
+  }
+  case AssetKind::Graphic:
+    return sizeof(Graphic) + asset.downcast<Graphic>()->getSamplerCount() * sizeof(TextureSampler);
+  }
+  return 0U;
+}
+
+/* Assets that the asset that is being loaded on this thread depends on.
+ * Loaders request their dependencies from the database, while a load is in progress those requests
+ * are recorded so the dependencies can be kept loaded for as long as the asset is loaded.
+ */
+struct DependencyContext final {
+  const DatabaseImpl* db;
+  std::vector<AssetHandle>* dependencies;
+};
+
+thread_local DependencyContext t_dependencyContext = {nullptr, nullptr};
+
+/* Record dependency requests for the lifetime of the scope.
+ */
+class DependencyScope final {
+public:
+  DependencyScope(const DatabaseImpl* db, std::vector<AssetHandle>* dependencies) noexcept :
+      m_prev{t_dependencyContext} {
+    t_dependencyContext = {db, dependencies};
+  }
+  DependencyScope(const DependencyScope& rhs) = delete;
+  DependencyScope(DependencyScope&& rhs)      = delete;
+  ~DependencyScope() noexcept { t_dependencyContext = m_prev; }
+
+  auto operator=(const DependencyScope& rhs) -> DependencyScope& = delete;
+  auto operator=(DependencyScope&& rhs) -> DependencyScope& = delete;
+
+private:
+  DependencyContext m_prev;
+};
 
-  // Make the buffer size match the actual file size.
-  buffer.resize(fileSize);
-  return buffer;
+[[nodiscard]] auto isLoadingDependencies(const DatabaseImpl* db) noexcept {
+  return t_dependencyContext.db == db;
+}
+
+auto recordDependency(const DatabaseImpl* db, const AssetHandle& handle) {
+  if (isLoadingDependencies(db)) {
+    t_dependencyContext.dependencies->push_back(handle);
+  }
 }
 
 } // namespace
 
 auto DatabaseImpl::get(const AssetId& id) -> const Asset* {
-  // Find if the asset has been already loaded, if so return a pointer to it.
+  // Caller only receives a pointer so we cannot track its usage, keep it loaded forever.
+  const auto pin = !isLoadingDependencies(this);
+  return acquireImpl(id, pin).get();
+}
+
+auto DatabaseImpl::acquire(const AssetId& id) -> AssetHandle { return acquireImpl(id, false); }
+
+auto DatabaseImpl::getAsync(const AssetId& id) -> AssetFuture {
+  const auto lk = std::lock_guard<std::mutex>{m_assetsMutex};
+
+  // No need to involve a worker if the asset was already loaded or is being loaded.
+  const auto assetItr = m_assets.find(id);
+  if (assetItr != m_assets.end()) {
+    touch(assetItr->second);
+    auto promise = AssetPromise{};
+    promise.set_value(AssetHandle{assetItr->second.asset});
+    return promise.get_future().share();
+  }
+  const auto inFlightItr = m_inFlight.find(id);
+  if (inFlightItr != m_inFlight.end()) {
+    ++m_dedupCount;
+    return inFlightItr->second.future;
+  }
+
+  // Register the load before queuing it, so requests in the mean time share it.
+  auto promise     = std::make_shared<AssetPromise>();
+  const auto entry = m_inFlight.insert(
+      {id, InFlightLoad{promise, promise->get_future().share(), std::thread::id{}, false}});
+  m_workers.push([this, id]() { loadQueued(id); });
+  return entry.first->second.future;
+}
+
+auto DatabaseImpl::preload(const std::vector<AssetId>& ids) -> std::vector<AssetFuture> {
+  auto result = std::vector<AssetFuture>{};
+  result.reserve(ids.size());
+  for (const auto& id : ids) {
+    result.push_back(getAsync(id));
+  }
+  return result;
+}
+
+auto DatabaseImpl::join(const AssetId& id, const AssetFuture& future) -> AssetHandle {
+  auto promise = std::shared_ptr<AssetPromise>{};
+  if (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+    const auto lk          = std::lock_guard<std::mutex>{m_assetsMutex};
+    const auto inFlightItr = m_inFlight.find(id);
+    if (inFlightItr != m_inFlight.end()) {
+      auto& inFlight = inFlightItr->second;
+      if (inFlight.thread == std::this_thread::get_id()) {
+        // Asset (indirectly) depends on itself, waiting would never finish.
+        throw err::AssetLoadErr{getPath(id), "Circular asset dependency"};
+      }
+      if (inFlight.thread == std::thread::id{}) {
+        // Queued but not started yet: load it here instead of waiting for a worker to pick it up.
+        inFlight.thread = std::this_thread::get_id();
+        promise         = inFlight.promise;
+      }
+    }
+  }
+  auto handle = promise ? loadInFlight(id, promise.get()) : future.get();
+  recordDependency(this, handle);
+  return handle;
+}
+
+auto DatabaseImpl::setMemoryBudget(uint64_t bytes) -> void {
+  const auto lk  = std::lock_guard<std::mutex>{m_assetsMutex};
+  m_memoryBudget = bytes;
+  evict();
+}
+
+auto DatabaseImpl::enableHotReload() -> void {
+  const auto lk = std::lock_guard<std::mutex>{m_reloadMutex};
+  if (m_archive) {
+    LOG_W(m_logger, "Hot reload is not supported for archives", {"path", m_rootPath});
+    return;
+  }
+  if (!m_watcher) {
+    m_watcher = std::make_unique<pal::FileWatcher>(m_rootPath);
+    m_hotReload.store(true);
+    LOG_I(m_logger, "Hot reload enabled", {"path", m_rootPath});
+  }
+}
+
+auto DatabaseImpl::update() -> std::vector<AssetReload> {
+  const auto reloadLk = std::lock_guard<std::mutex>{m_reloadMutex};
+  if (!m_watcher) {
+    return {};
+  }
+  auto result = std::vector<AssetReload>{};
+  {
+    const auto lk = std::lock_guard<std::mutex>{m_assetsMutex};
+
+    // Note: No new references to replaced assets can be created, so a use-count of 1 (only the
+    // entry itself) means nobody uses the old version anymore.
+    m_retired.erase(
+        std::remove_if(
+            m_retired.begin(),
+            m_retired.end(),
+            [](const AssetEntry& entry) { return !entry.pinned && entry.asset.use_count() == 1; }),
+        m_retired.end());
+  }
+
+  // Apply the reloads that have finished.
+  for (auto itr = m_reloads.begin(); itr != m_reloads.end();) {
+    const auto& id = itr->first;
+    auto& reload   = itr->second;
+    if (reload.future.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+      ++itr;
+      continue;
+    }
+    auto newAsset = AssetHandle{};
+    try {
+      newAsset = reload.future.get();
+    } catch (const std::exception& e) {
+      LOG_W(
+          m_logger,
+          "Failed to reload asset, keeping the old version",
+          {"id", id},
+          {"reason", std::string{e.what()}});
+    }
+    {
+      const auto lk = std::lock_guard<std::mutex>{m_assetsMutex};
+      if (newAsset) {
+        const auto assetItr = m_assets.find(id);
+        if (reload.oldEntry.pinned && assetItr != m_assets.end()) {
+          assetItr->second.pinned = true;
+        }
+        ++m_reloadCount;
+        result.push_back(AssetReload{id, AssetHandle{reload.oldEntry.asset}, std::move(newAsset)});
+        m_retired.push_back(std::move(reload.oldEntry));
+      } else {
+        restore(id, std::move(reload.oldEntry));
+      }
+    }
+    itr = m_reloads.erase(itr);
+  }
+
+  // Start reloading the assets that changed.
+  auto overflowed = false;
+  for (const auto& path : m_watcher->poll(&overflowed)) {
+    m_changed.push_back(path.generic_string());
+  }
+  if (overflowed) {
+    LOG_W(m_logger, "File changes were lost, reloading all loaded assets", {"path", m_rootPath});
+  }
+  startReloads();
+  return result;
+}
+
+auto DatabaseImpl::getStats() const noexcept -> DatabaseStats {
+  const auto lk            = std::lock_guard<std::mutex>{m_assetsMutex};
+  const auto cacheHitCount = m_meshCache ? m_meshCache->getHitCount() : 0U;
+  return DatabaseStats{
+      m_loadCount,
+      m_dedupCount,
+      cacheHitCount,
+      m_evictCount,
+      m_reloadCount,
+      m_memoryUsage,
+      m_memoryUsagePerKind};
+}
+
+auto DatabaseImpl::acquireImpl(const AssetId& id, bool pin) -> AssetHandle {
+  auto handle  = AssetHandle{};
+  auto promise = std::shared_ptr<AssetPromise>{};
   {
-    const auto lk       = std::lock_guard<std::mutex>{m_assetsMutex};
+    auto lk = std::unique_lock<std::mutex>{m_assetsMutex};
+
+    // Find if the asset has been already loaded, if so return a handle to it.
     const auto assetItr = m_assets.find(id);
     if (assetItr != m_assets.end()) {
-      return assetItr->second.get();
+      touch(assetItr->second);
+      assetItr->second.pinned |= pin;
+      handle = AssetHandle{assetItr->second.asset};
+    } else {
+      // Find if the asset is being loaded, if so wait for that load instead of loading it again.
+      const auto inFlightItr = m_inFlight.find(id);
+      if (inFlightItr != m_inFlight.end()) {
+        auto& inFlight = inFlightItr->second;
+        if (inFlight.thread == std::this_thread::get_id()) {
+          // Asset (indirectly) depends on itself, waiting would never finish.
+          throw err::AssetLoadErr{getPath(id), "Circular asset dependency"};
+        }
+        ++m_dedupCount;
+        inFlight.pin |= pin;
+        if (inFlight.thread != std::thread::id{}) {
+          const auto future = inFlight.future;
+          lk.unlock();
+          handle = future.get();
+        } else {
+          // Queued but not started yet: load it here instead of waiting for a worker to pick it
+          // up, otherwise a worker could end up waiting for a task that is queued behind it.
+          inFlight.thread = std::this_thread::get_id();
+          promise         = inFlight.promise;
+        }
+      } else {
+        promise = std::make_shared<AssetPromise>();
+        m_inFlight.insert(
+            {id,
+             InFlightLoad{
+                 promise, promise->get_future().share(), std::this_thread::get_id(), pin}});
+      }
+    }
+  }
+  if (promise) {
+    handle = loadInFlight(id, promise.get());
+  }
+  recordDependency(this, handle);
+  return handle;
+}
+
+auto DatabaseImpl::loadInFlight(const AssetId& id, AssetPromise* promise) -> AssetHandle {
+  auto dependencies = std::vector<AssetHandle>{};
+  AssetUnique asset;
+  try {
+    const auto scope = DependencyScope{this, &dependencies};
+    asset            = load(id);
+  } catch (...) {
+    // Waiting requests receive the same error, later requests will try to load it again.
+    {
+      const auto lk = std::lock_guard<std::mutex>{m_assetsMutex};
+      m_inFlight.erase(id);
+    }
+    promise->set_exception(std::current_exception());
+    throw;
+  }
+
+  // Save the asset in the map.
+  const auto kind    = asset->getKind();
+  const auto memSize = getMemSize(*asset);
+  auto result        = AssetHandle{};
+  {
+    const auto lk          = std::lock_guard<std::mutex>{m_assetsMutex};
+    const auto inFlightItr = m_inFlight.find(id);
+    auto entry             = AssetEntry{
+        std::shared_ptr<const Asset>{std::move(asset)},
+        std::move(dependencies),
+        memSize,
+        inFlightItr->second.pin,
+        m_lru.insert(m_lru.begin(), id)};
+    result = AssetHandle{m_assets.insert({id, std::move(entry)}).first->second.asset};
+    m_inFlight.erase(inFlightItr);
+    m_memoryUsage += memSize;
+    m_memoryUsagePerKind[static_cast<size_t>(kind) - 1U] += memSize;
+    ++m_loadCount;
+
+    // Note: The new asset is kept alive by 'result'.
+    evict();
+  }
+  promise->set_value(result);
+  return result;
+}
+
+auto DatabaseImpl::loadQueued(const AssetId& id) noexcept -> void {
+  auto promise = std::shared_ptr<AssetPromise>{};
+  {
+    const auto lk          = std::lock_guard<std::mutex>{m_assetsMutex};
+    const auto inFlightItr = m_inFlight.find(id);
+    if (inFlightItr == m_inFlight.end() || inFlightItr->second.thread != std::thread::id{}) {
+      return; // Another thread needed the asset before we got to it and is loading it.
     }
+    inFlightItr->second.thread = std::this_thread::get_id();
+    promise                    = inFlightItr->second.promise;
+  }
+  try {
+    static_cast<void>(loadInFlight(id, promise.get()));
+  } catch (...) {
+    // Error is stored in the promise.
   }
+}
+
+auto DatabaseImpl::getPath(const AssetId& id) const noexcept -> fs::path { return m_rootPath / id; }
 
+auto DatabaseImpl::load(const AssetId& id) -> AssetUnique {
   auto loadBeginTime = Clock::now();
 
   const auto path = getPath(id);
   AssetUnique asset;
   try {
-    auto rawData        = loadRaw(path);
-    const auto dataSize = rawData.size();
+    // Editors (and tools like glslc) rewrite files in place, so while hot reload is enabled files
+    // are not mapped: old versions of the assets have to stay intact.
+    auto rawData = m_archive ? m_archive->read(id) : loadRaw(path, !m_hotReload.load());
+    const auto dataSize = rawData.getSize();
 
     asset = internal::loadAsset(m_logger, this, id, path, std::move(rawData));
     assert(asset);
@@ -92,18 +461,112 @@ auto DatabaseImpl::get(const AssetId& id) -> const Asset* {
     LOG_W(m_logger, "Failed to load asset", {"id", id}, {"path", path});
     throw;
   }
+  return asset;
+}
 
-  // Save the asset in the map.
+auto DatabaseImpl::touch(AssetEntry& entry) noexcept -> void {
+  m_lru.splice(m_lru.begin(), m_lru, entry.lruItr);
+}
+
+auto DatabaseImpl::evict() noexcept -> void {
+  if (m_memoryBudget == 0U) {
+    return;
+  }
+  // Unloading an asset can make the assets it depends on unreferenced, so keep making passes over
+  // the lru list (starting at the least recently used) until we are within budget or there is
+  // nothing left to unload.
+  auto evicted = true;
+  while (evicted && m_memoryUsage > m_memoryBudget) {
+    evicted = false;
+    for (auto itr = m_lru.rbegin(); itr != m_lru.rend() && m_memoryUsage > m_memoryBudget;) {
+      const auto assetItr = m_assets.find(*itr);
+      const auto& entry   = assetItr->second;
+
+      // Note: No new references can be created without holding the assets mutex, so a use-count
+      // of 1 (only the entry itself) means the asset is unreferenced.
+      if (entry.pinned || entry.asset.use_count() > 1) {
+        ++itr;
+        continue;
+      }
+      LOG_D(
+          m_logger,
+          "Asset unloaded",
+          {"id", entry.asset->getId()},
+          {"kind", getName(entry.asset->getKind())},
+          {"size", log::MemSize{entry.memSize}});
+
+      m_memoryUsage -= entry.memSize;
+      m_memoryUsagePerKind[static_cast<size_t>(entry.asset->getKind()) - 1U] -= entry.memSize;
+      ++m_evictCount;
+      evicted = true;
+
+      itr = std::make_reverse_iterator(m_lru.erase(std::next(itr).base()));
+      m_assets.erase(assetItr);
+    }
+  }
+}
+
+auto DatabaseImpl::startReloads() -> void {
+  auto ids = std::vector<AssetId>{};
   {
     const auto lk = std::lock_guard<std::mutex>{m_assetsMutex};
 
-    // Note: Another insertion might have beaten us to it, but in that case we will just return a
-    // pointer to the previously inserted asset and discard our asset.
-    const auto assetItr = m_assets.insert({id, std::move(asset)});
-    return assetItr.first->second.get();
+    // Assets that are still being reloaded are reloaded again once that reload is finished.
+    // Assets that are not loaded do not need reloading, the next load reads the new version.
+    auto deferred = std::vector<AssetId>{};
+    for (auto& id : m_changed) {
+      if (m_reloads.find(id) != m_reloads.end()) {
+        deferred.push_back(std::move(id));
+      } else if (
+          m_assets.find(id) != m_assets.end() &&
+          std::find(ids.begin(), ids.end(), id) == ids.end()) {
+        ids.push_back(std::move(id));
+      }
+    }
+    m_changed = std::move(deferred);
+
+    // Find the assets that (indirectly) depend on the changed assets, they reference the old
+    // versions so have to be reloaded as well.
+    auto isReloaded = [&ids](const AssetHandle& dep) {
+      return std::find(ids.begin(), ids.end(), dep->getId()) != ids.end();
+    };
+    for (auto found = !ids.empty(); found;) {
+      found = false;
+      for (const auto& [id, entry] : m_assets) {
+        if (std::find(ids.begin(), ids.end(), id) == ids.end() &&
+            std::any_of(entry.dependencies.begin(), entry.dependencies.end(), isReloaded)) {
+          ids.push_back(id);
+          found = true;
+        }
+      }
+    }
+
+    // Remove the old versions, the next requests will load the new versions.
+    for (const auto& id : ids) {
+      auto entry = std::move(m_assets.extract(id).mapped());
+      m_lru.erase(entry.lruItr);
+      m_memoryUsage -= entry.memSize;
+      m_memoryUsagePerKind[static_cast<size_t>(entry.asset->getKind()) - 1U] -= entry.memSize;
+      m_reloads.insert({id, PendingReload{AssetFuture{}, std::move(entry)}});
+
+      LOG_I(m_logger, "Reloading asset", {"id", id});
+    }
+  }
+  for (const auto& id : ids) {
+    m_reloads.find(id)->second.future = getAsync(id);
   }
 }
 
-auto DatabaseImpl::getPath(const AssetId& id) const noexcept -> fs::path { return m_rootPath / id; }
+auto DatabaseImpl::restore(const AssetId& id, AssetEntry entry) -> void {
+  if (m_assets.find(id) != m_assets.end() || m_inFlight.find(id) != m_inFlight.end()) {
+    // Asset was requested again in the mean time, keep the old version alive for its users.
+    m_retired.push_back(std::move(entry));
+    return;
+  }
+  entry.lruItr = m_lru.insert(m_lru.begin(), id);
+  m_memoryUsage += entry.memSize;
+  m_memoryUsagePerKind[static_cast<size_t>(entry.asset->getKind()) - 1U] += entry.memSize;
+  m_assets.insert({id, std::move(entry)});
+}
 
 } // namespace tria::asset
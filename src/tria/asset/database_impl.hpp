@@ -1,8 +1,18 @@
 #pragma once
+#include "internal/archive_reader.hpp"
+#include "internal/mesh_cache.hpp"
+#include "internal/worker_pool.hpp"
 #include "tria/asset/database.hpp"
+#include "tria/pal/file_watcher.hpp"
+#include <array>
+#include <atomic>
+#include <future>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace tria::asset {
 
@@ -10,27 +20,163 @@ using AssetUnique = std::unique_ptr<Asset>;
 
 class DatabaseImpl final {
 public:
-  DatabaseImpl(log::Logger* logger, fs::path rootPath) :
-      m_logger{logger}, m_rootPath{std::move(rootPath)} {}
+  DatabaseImpl(log::Logger* logger, fs::path rootPath, uint32_t workerCount, fs::path cachePath) :
+      m_logger{logger},
+      m_rootPath{std::move(rootPath)},
+      m_archive{
+          fs::is_regular_file(m_rootPath) ? std::make_unique<internal::ArchiveReader>(m_rootPath)
+                                          : nullptr},
+      m_meshCache{
+          cachePath.empty() ? nullptr
+                            : std::make_unique<internal::MeshCache>(logger, std::move(cachePath))},
+      m_memoryBudget{0U},
+      m_memoryUsage{0U},
+      m_memoryUsagePerKind{},
+      m_loadCount{0U},
+      m_dedupCount{0U},
+      m_evictCount{0U},
+      m_reloadCount{0U},
+      m_hotReload{false},
+      m_workers{workerCount} {}
   ~DatabaseImpl() = default;
 
   /* Get a pointer to an asset. Will either load it or return a previously loaded asset.
-   *
-   * TODO(bastian): In the future this should probably return a 'smart-pointer'-like handle so we
-   * can track who is using it so we can decide when to unload it.
+   * If another thread is already loading the asset then this waits for that load, if the asset is
+   * queued for loading on a worker (but not started yet) then it is loaded on the calling thread.
+   * When called while loading another asset (from a loader) the asset is recorded as a dependency
+   * of the asset being loaded, otherwise the asset is pinned.
    *
    * Throws if asset loading fails.
    */
   [[nodiscard]] auto get(const AssetId& id) -> const Asset*;
 
+  /* Same as 'get()' but returns a handle instead of pinning the asset.
+   */
+  [[nodiscard]] auto acquire(const AssetId& id) -> AssetHandle;
+
+  /* Load an asset on one of the worker threads.
+   * Load errors are stored in the future.
+   */
+  [[nodiscard]] auto getAsync(const AssetId& id) -> AssetFuture;
+
+  auto preload(const std::vector<AssetId>& ids) -> std::vector<AssetFuture>;
+
+  /* Wait for an asset that was requested with 'getAsync()'.
+   * If the load is still queued then it is loaded on the calling thread instead of waiting for a
+   * worker. Load errors are rethrown without loading the asset again. Like 'get()' the asset is
+   * recorded as a dependency when called from a loader.
+   */
+  [[nodiscard]] auto join(const AssetId& id, const AssetFuture& future) -> AssetHandle;
+
+  auto setMemoryBudget(uint64_t bytes) -> void;
+
+  auto enableHotReload() -> void;
+
+  /* Apply the finished reloads and start reloading the assets that changed since the last call.
+   */
+  [[nodiscard]] auto update() -> std::vector<AssetReload>;
+
+  [[nodiscard]] auto getStats() const noexcept -> DatabaseStats;
+
+  [[nodiscard]] auto getPath(const AssetId& id) const noexcept -> fs::path;
+
+  /* Cache for parsed meshes, nullptr if caching is disabled.
+   */
+  [[nodiscard]] auto getMeshCache() noexcept -> internal::MeshCache* { return m_meshCache.get(); }
+
 private:
+  using AssetPromise = std::promise<AssetHandle>;
+
+  /* Asset that is loaded.
+   */
+  struct AssetEntry final {
+    std::shared_ptr<const Asset> asset;
+    std::vector<AssetHandle> dependencies; // Keeps the assets this asset depends on loaded.
+    uint64_t memSize;
+    bool pinned;                         // Returned by 'get()', is never unloaded.
+    std::list<AssetId>::iterator lruItr; // Position in the lru list.
+  };
+
+  /* Asset that is currently being loaded or is queued for loading on a worker.
+   */
+  struct InFlightLoad final {
+    std::shared_ptr<AssetPromise> promise;
+    AssetFuture future;
+    std::thread::id thread; // Thread that is loading the asset, default id while queued.
+    bool pin;               // Requested by 'get()', entry is pinned once loaded.
+  };
+
+  /* Asset that is being reloaded, the old version is restored if the reload fails.
+   */
+  struct PendingReload final {
+    AssetFuture future;
+    AssetEntry oldEntry;
+  };
+
   log::Logger* m_logger;
   fs::path m_rootPath;
+  std::unique_ptr<internal::ArchiveReader> m_archive; // Null when loading from a directory.
+  std::unique_ptr<internal::MeshCache> m_meshCache;
 
-  std::mutex m_assetsMutex;
-  std::unordered_map<AssetId, AssetUnique> m_assets;
+  mutable std::mutex m_assetsMutex;
+  std::unordered_map<AssetId, AssetEntry> m_assets;
+  std::unordered_map<AssetId, InFlightLoad> m_inFlight;
+  std::list<AssetId> m_lru; // Loaded assets, most recently used first.
+  uint64_t m_memoryBudget;
+  uint64_t m_memoryUsage;
+  std::array<uint64_t, g_assetKindCount> m_memoryUsagePerKind;
+  uint64_t m_loadCount;
+  uint64_t m_dedupCount;
+  uint64_t m_evictCount;
+  uint64_t m_reloadCount;
 
-  [[nodiscard]] auto getPath(const AssetId& id) const noexcept -> fs::path;
+  // Note: Lock before the assets mutex when both are needed.
+  std::mutex m_reloadMutex;
+  std::atomic<bool> m_hotReload; // Set once the watcher is created, read without the lock.
+  std::unique_ptr<pal::FileWatcher> m_watcher;
+  std::vector<AssetId> m_changed; // Changed assets that were not reloaded yet.
+  std::unordered_map<AssetId, PendingReload> m_reloads;
+  std::vector<AssetEntry> m_retired; // Replaced assets that are still pinned or referenced.
+
+  // Note: Declared last so the workers are stopped before the other members are destroyed.
+  internal::WorkerPool m_workers;
+
+  /* Get a handle to the asset, loading it if needed.
+   * Records the asset as a dependency when called from a loader. When 'pin' is true the entry is
+   * pinned while the assets mutex is held, so it cannot be unloaded before the caller sees it.
+   */
+  [[nodiscard]] auto acquireImpl(const AssetId& id, bool pin) -> AssetHandle;
+
+  /* Load an asset that was registered in the in-flight map by the calling thread.
+   * Stores the result (or error) in the promise and removes the in-flight entry.
+   */
+  auto loadInFlight(const AssetId& id, AssetPromise* promise) -> AssetHandle;
+
+  /* Task executed by the workers, does nothing if another thread already took over the load.
+   */
+  auto loadQueued(const AssetId& id) noexcept -> void;
+
+  [[nodiscard]] auto load(const AssetId& id) -> AssetUnique;
+
+  /* Mark the entry as most recently used.
+   * Note: Requires holding the assets mutex.
+   */
+  auto touch(AssetEntry& entry) noexcept -> void;
+
+  /* Unload unreferenced assets until the memory usage is within the budget.
+   * Note: Requires holding the assets mutex.
+   */
+  auto evict() noexcept -> void;
+
+  /* Remove the changed assets (and the assets that depend on them) and queue loads for them.
+   * Note: Requires holding the reload mutex.
+   */
+  auto startReloads() -> void;
+
+  /* Put back the old version of an asset after its reload failed.
+   * Note: Requires holding the reload and the assets mutex.
+   */
+  auto restore(const AssetId& id, AssetEntry entry) -> void;
 };
 
 } // namespace tria::asset
@@ -0,0 +1,49 @@
+#pragma once
+#include "tria/asset/archive.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace tria::asset::internal {
+
+/*
+ * Archive file layout:
+ * - Header (see 'ArchiveHeader').
+ * - Table of contents, an 'ArchiveEntry' per asset sorted by id (so it can be binary searched).
+ * - Ids of the entries (without null-terminators).
+ * - Entry data, every entry starts at a multiple of 'g_archiveDataAlign'. Uncompressed entries are
+ *   followed by 'g_fileDataPadding' zero bytes, so the mapping satisfies the 'FileData' padding
+ *   guarantee and entries can be used without copying.
+ */
+
+constexpr std::array<char, 4> g_archiveMagic = {'T', 'P', 'A', 'K'};
+constexpr uint32_t g_archiveVersion          = 1U;
+constexpr size_t g_archiveDataAlign          = 16U;
+
+struct ArchiveHeader final {
+  std::array<char, 4> magic;
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t idsSize;
+};
+
+struct ArchiveEntry final {
+  uint64_t idOffset;   // Relative to the start of the ids.
+  uint64_t dataOffset; // Relative to the start of the file.
+  uint64_t dataSize;   // Stored size (compressed size for compressed entries).
+  uint64_t rawSize;    // Size of the original file.
+  uint32_t idSize;
+  uint32_t compression; // 'ArchiveCompression' of the entry.
+};
+
+static_assert(std::is_trivially_copyable_v<ArchiveHeader>, "Header has to be trivially copyable");
+static_assert(std::is_trivially_copyable_v<ArchiveEntry>, "Entry has to be trivially copyable");
+static_assert(sizeof(ArchiveEntry) == 40U, "Entries should not contain padding");
+static_assert(sizeof(ArchiveHeader) % alignof(ArchiveEntry) == 0U, "Entries have to be aligned");
+
+[[nodiscard]] constexpr auto getArchiveTocSize(size_t entryCount) noexcept {
+  return sizeof(ArchiveHeader) + entryCount * sizeof(ArchiveEntry);
+}
+
+} // namespace tria::asset::internal
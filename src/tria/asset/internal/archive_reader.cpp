@@ -0,0 +1,115 @@
+#include "archive_reader.hpp"
+#include "tria/asset/err/archive_err.hpp"
+#include "tria/asset/err/asset_load_err.hpp"
+#include "tria/math/lz.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace tria::asset::internal {
+
+namespace {
+
+// Maximum size of a compressed entry after decompressing, guard against allocating huge amounts of
+// memory for corrupt entries.
+constexpr uint64_t g_maxRawSize = 512 * 1024 * 1024;
+
+} // namespace
+
+ArchiveReader::ArchiveReader(fs::path path) :
+    m_path{std::move(path)}, m_entries{nullptr}, m_entryCount{0U}, m_ids{nullptr} {
+  try {
+    m_mapping = std::make_shared<pal::MappedFile>(
+        pal::MappedFile::open(m_path, pal::MapMode::ReadOnly));
+  } catch (const pal::err::PlatformErr& e) {
+    throw err::ArchiveErr{m_path, e.what()};
+  }
+  const auto* data = m_mapping->getData();
+  const auto size  = static_cast<uint64_t>(m_mapping->getSize());
+
+  auto header = ArchiveHeader{};
+  if (size < sizeof(ArchiveHeader)) {
+    throw err::ArchiveErr{m_path, "File is not an archive"};
+  }
+  std::memcpy(&header, data, sizeof(ArchiveHeader));
+  if (header.magic != g_archiveMagic) {
+    throw err::ArchiveErr{m_path, "File is not an archive"};
+  }
+  if (header.version != g_archiveVersion) {
+    throw err::ArchiveErr{m_path, "Unsupported archive version"};
+  }
+  const auto dataStart = getArchiveTocSize(header.entryCount) + header.idsSize;
+  if (dataStart > size) {
+    throw err::ArchiveErr{m_path, "Archive is truncated"};
+  }
+  m_entries    = reinterpret_cast<const ArchiveEntry*>(data + sizeof(ArchiveHeader));
+  m_entryCount = header.entryCount;
+  m_ids        = reinterpret_cast<const char*>(data + getArchiveTocSize(header.entryCount));
+
+  // Validate all entries up front, reading entries can then skip the checks.
+  for (auto i = 0U; i != m_entryCount; ++i) {
+    const auto& entry = m_entries[i];
+    if (entry.idOffset > header.idsSize || entry.idSize > header.idsSize - entry.idOffset) {
+      throw err::ArchiveErr{m_path, "Archive contains an invalid id"};
+    }
+    if (i != 0U && getId(m_entries[i - 1U]) >= getId(entry)) {
+      throw err::ArchiveErr{m_path, "Archive table of contents is not sorted"};
+    }
+    auto storedSize = entry.dataSize;
+    switch (static_cast<ArchiveCompression>(entry.compression)) {
+    case ArchiveCompression::None:
+      storedSize += g_fileDataPadding; // Padding is part of the archive for uncompressed entries.
+      if (entry.rawSize != entry.dataSize) {
+        throw err::ArchiveErr{m_path, "Archive contains an invalid entry"};
+      }
+      break;
+    case ArchiveCompression::Lz:
+      if (entry.rawSize > g_maxRawSize) {
+        throw err::ArchiveErr{m_path, "Archive contains an invalid entry"};
+      }
+      break;
+    default:
+      throw err::ArchiveErr{m_path, "Archive contains an unsupported compression"};
+    }
+    if (entry.dataOffset < dataStart || entry.dataOffset > size ||
+        storedSize > size - entry.dataOffset || storedSize < entry.dataSize) {
+      throw err::ArchiveErr{m_path, "Archive is truncated"};
+    }
+  }
+}
+
+auto ArchiveReader::read(const AssetId& id) const -> FileData {
+  const auto* entry = find(id);
+  if (!entry) {
+    throw err::AssetLoadErr{m_path / id, "Asset not found in archive"};
+  }
+  const auto* data = m_mapping->getData() + entry->dataOffset;
+  if (entry->compression == static_cast<uint32_t>(ArchiveCompression::None)) {
+    return FileData{m_mapping, data, static_cast<size_t>(entry->dataSize), true};
+  }
+
+  // Entries are compressed as separate streams, so a fresh decompressor can decompress any entry.
+  auto decompressor = math::LzDecompressor{};
+  const auto* raw   = decompressor.decompress(
+      data, static_cast<size_t>(entry->dataSize), static_cast<size_t>(entry->rawSize));
+  if (!raw) {
+    throw err::AssetLoadErr{m_path / id, "Archive entry is corrupt"};
+  }
+  return FileData::copy(raw, static_cast<size_t>(entry->rawSize));
+}
+
+auto ArchiveReader::getId(const ArchiveEntry& entry) const noexcept -> std::string_view {
+  return std::string_view{m_ids + entry.idOffset, entry.idSize};
+}
+
+auto ArchiveReader::find(const AssetId& id) const noexcept -> const ArchiveEntry* {
+  const auto* end = m_entries + m_entryCount;
+  const auto* itr = std::lower_bound(
+      m_entries, end, std::string_view{id}, [this](const ArchiveEntry& entry, auto key) {
+        return getId(entry) < key;
+      });
+  return itr != end && getId(*itr) == id ? itr : nullptr;
+}
+
+} // namespace tria::asset::internal
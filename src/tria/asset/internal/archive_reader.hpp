@@ -0,0 +1,42 @@
+#pragma once
+#include "archive_format.hpp"
+#include "tria/asset/asset.hpp"
+#include "tria/asset/file_data.hpp"
+#include "tria/fs.hpp"
+#include "tria/pal/mapped_file.hpp"
+#include <memory>
+#include <string_view>
+
+namespace tria::asset::internal {
+
+/*
+ * Read-only view of an archive created by 'packArchive()'.
+ * The whole archive is memory mapped once, finding an entry is a binary search over the table of
+ * contents and does not involve the file system. Uncompressed entries reference the mapping
+ * directly, compressed entries are decompressed into a heap buffer.
+ * Is thread-safe.
+ */
+class ArchiveReader final {
+public:
+  /* Open an archive.
+   * Throws an 'ArchiveErr' if the file cannot be opened or is not a valid archive.
+   */
+  explicit ArchiveReader(fs::path path);
+
+  /* Read the data of an entry.
+   * Throws an 'AssetLoadErr' if there is no entry with the given id or the entry is corrupt.
+   */
+  [[nodiscard]] auto read(const AssetId& id) const -> FileData;
+
+private:
+  fs::path m_path;
+  std::shared_ptr<pal::MappedFile> m_mapping;
+  const ArchiveEntry* m_entries;
+  size_t m_entryCount;
+  const char* m_ids;
+
+  [[nodiscard]] auto getId(const ArchiveEntry& entry) const noexcept -> std::string_view;
+  [[nodiscard]] auto find(const AssetId& id) const noexcept -> const ArchiveEntry*;
+};
+
+} // namespace tria::asset::internal
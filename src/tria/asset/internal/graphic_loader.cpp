@@ -6,6 +6,7 @@
 #include <optional>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace tria::asset::internal {
 
@@ -92,9 +93,49 @@ namespace {
   return search == table.end() ? std::nullopt : std::optional{search->second};
 }
 
+/* Start loading all the assets the graphic references on the database workers, this way they are
+ * loaded in parallel instead of one after the other. Malformed references are skipped here, they
+ * are reported when the graphic is actually parsed.
+ * Note: The futures keep the dependencies loaded until the graphic has acquired them.
+ */
+[[nodiscard]] auto prefetchDependencies(DatabaseImpl* db, const simdjson::dom::object& obj)
+    -> std::unordered_map<AssetId, AssetFuture> {
+  auto result   = std::unordered_map<AssetId, AssetFuture>{};
+  auto prefetch = [&](std::string_view depId) {
+    auto id = AssetId{depId};
+    if (result.find(id) == result.end()) {
+      auto future = db->getAsync(id);
+      result.insert({std::move(id), std::move(future)});
+    }
+  };
+  simdjson::dom::array shadersArray;
+  if (!obj.at_key("shaders").get(shadersArray)) {
+    for (const auto& elem : shadersArray) {
+      std::string_view shaderId;
+      if (!elem.get(shaderId)) {
+        prefetch(shaderId);
+      }
+    }
+  }
+  std::string_view meshId;
+  if (!obj.at_key("mesh").get(meshId)) {
+    prefetch(meshId);
+  }
+  simdjson::dom::array samplersArray;
+  if (!obj.at_key("samplers").get(samplersArray)) {
+    for (const auto& elem : samplersArray) {
+      std::string_view textureId;
+      if (!elem.at_key("texture").get(textureId)) {
+        prefetch(textureId);
+      }
+    }
+  }
+  return result;
+}
+
 } // namespace
 
-auto loadGraphic(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, math::RawData raw)
+auto loadGraphic(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, FileData raw)
     -> AssetUnique {
 
   simdjson::dom::object obj;
@@ -103,6 +144,15 @@ auto loadGraphic(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, math::Ra
     throw err::JsonErr{error_message(err)};
   }
 
+  // Join the prefetched loads instead of requesting the assets again, so a failed dependency is
+  // only loaded (and reported) once.
+  const auto dependencies = prefetchDependencies(db, obj);
+  auto getDependency      = [&](std::string_view depId) -> const Asset* {
+    const auto itr = dependencies.find(AssetId{depId});
+    return itr != dependencies.end() ? db->join(itr->first, itr->second).get()
+                                     : db->get(AssetId{depId});
+  };
+
   // Shaders.
   auto shaders = std::vector<const Shader*>{};
   simdjson::dom::array shadersArray;
@@ -112,7 +162,7 @@ auto loadGraphic(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, math::Ra
       if (elem.get(shaderId)) {
         throw err::GraphicErr{"Invalid shader reference"};
       }
-      shaders.push_back(db->get(AssetId{shaderId})->downcast<Shader>());
+      shaders.push_back(getDependency(shaderId)->downcast<Shader>());
     }
   }
   // Require exactly one vertex and one fragment shader at the moment.
@@ -131,7 +181,7 @@ auto loadGraphic(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, math::Ra
   const Mesh* mesh = nullptr;
   std::string_view meshId;
   if (!obj.at_key("mesh").get(meshId)) {
-    mesh = db->get(AssetId{meshId})->downcast<Mesh>();
+    mesh = getDependency(meshId)->downcast<Mesh>();
   }
 
   // Samplers (optional field).
@@ -146,7 +196,7 @@ auto loadGraphic(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, math::Ra
       if (elem.at_key("texture").get(textureId)) {
         throw err::GraphicErr{"Object in sampler array is missing a 'texture' field"};
       }
-      const auto* texture = db->get(AssetId{textureId})->downcast<Texture>();
+      const auto* texture = getDependency(textureId)->downcast<Texture>();
 
       // Wrap mode (optional field).
       auto wrapMode = WrapMode::Repeat;
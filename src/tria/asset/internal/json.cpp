@@ -2,12 +2,12 @@
 
 namespace tria::asset::internal {
 
-auto parseJson(const math::RawData& raw) noexcept -> JsonParseResult {
-  // Verify that the input is sufficiently padded.
-  assert(raw.capacity() - raw.size() >= simdjson::SIMDJSON_PADDING);
+// Verify that the input is sufficiently padded.
+static_assert(g_fileDataPadding >= simdjson::SIMDJSON_PADDING, "Insufficient padding for simdjson");
 
+auto parseJson(const FileData& raw) noexcept -> JsonParseResult {
   thread_local static simdjson::dom::parser parser;
-  return parser.parse(raw.begin(), raw.size(), false);
+  return parser.parse(raw.getBegin(), raw.getSize(), false);
 }
 
 } // namespace tria::asset::internal
@@ -1,6 +1,6 @@
 #pragma once
 #include "simdjson.h"
-#include "tria/math/pod_vector.hpp"
+#include "tria/asset/file_data.hpp"
 
 namespace tria::asset::internal {
 
@@ -10,8 +10,8 @@ using JsonParseResult = simdjson::simdjson_result<simdjson::dom::element>;
  * Parse a json file.
  * Note: Return value can be used until the next call to 'parseJson' on the same thread.
  * Safe to be called concurrently but results should not be shared among threads.
- * Note: Input buffer has to be padded with x bytes, current DatabaseImpl provides that guarantee.
+ * Note: Input has to be padded with 'simdjson::SIMDJSON_PADDING' bytes, 'FileData' provides that.
  */
-[[nodiscard]] auto parseJson(const math::RawData& raw) noexcept -> JsonParseResult;
+[[nodiscard]] auto parseJson(const FileData& raw) noexcept -> JsonParseResult;
 
 } // namespace tria::asset::internal
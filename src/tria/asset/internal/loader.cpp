@@ -3,18 +3,16 @@
 
 namespace tria::asset::internal {
 
-using RawData = math::RawData;
-
-auto loadGraphic(log::Logger*, DatabaseImpl*, AssetId, RawData) -> AssetUnique;
-auto loadMeshObj(log::Logger*, DatabaseImpl*, AssetId, RawData) -> AssetUnique;
-auto loadTexturePpm(log::Logger*, DatabaseImpl*, AssetId, RawData) -> AssetUnique;
-auto loadTextureTga(log::Logger*, DatabaseImpl*, AssetId, RawData) -> AssetUnique;
-auto loadShaderSpv(log::Logger*, DatabaseImpl*, AssetId, RawData) -> AssetUnique;
-auto loadRawAsset(log::Logger*, DatabaseImpl*, AssetId, RawData) -> AssetUnique;
+auto loadGraphic(log::Logger*, DatabaseImpl*, AssetId, FileData) -> AssetUnique;
+auto loadMeshObj(log::Logger*, DatabaseImpl*, AssetId, FileData) -> AssetUnique;
+auto loadTexturePpm(log::Logger*, DatabaseImpl*, AssetId, FileData) -> AssetUnique;
+auto loadTextureTga(log::Logger*, DatabaseImpl*, AssetId, FileData) -> AssetUnique;
+auto loadShaderSpv(log::Logger*, DatabaseImpl*, AssetId, FileData) -> AssetUnique;
+auto loadRawAsset(log::Logger*, DatabaseImpl*, AssetId, FileData) -> AssetUnique;
 
 namespace {
 
-using AssetLoader = AssetUnique (*)(log::Logger*, DatabaseImpl*, AssetId, RawData);
+using AssetLoader = AssetUnique (*)(log::Logger*, DatabaseImpl*, AssetId, FileData);
 
 auto getLoader(const fs::path& path) -> AssetLoader {
   static const std::unordered_map<std::string, AssetLoader> table = {
@@ -34,7 +32,8 @@ auto getLoader(const fs::path& path) -> AssetLoader {
 
 } // namespace
 
-auto loadAsset(log::Logger* logger, DatabaseImpl* db, AssetId id, const fs::path& path, RawData raw)
+auto loadAsset(
+    log::Logger* logger, DatabaseImpl* db, AssetId id, const fs::path& path, FileData raw)
     -> AssetUnique {
   assert(db);
   return getLoader(path)(logger, db, std::move(id), std::move(raw));
@@ -1,11 +1,11 @@
 #pragma once
 #include "../database_impl.hpp"
+#include "tria/asset/file_data.hpp"
 #include "tria/fs.hpp"
-#include "tria/math/pod_vector.hpp"
 
 namespace tria::asset::internal {
 
-[[nodiscard]] auto loadAsset(log::Logger*, DatabaseImpl*, AssetId, const fs::path&, math::RawData)
+[[nodiscard]] auto loadAsset(log::Logger*, DatabaseImpl*, AssetId, const fs::path&, FileData)
     -> AssetUnique;
 
 } // namespace tria::asset::internal
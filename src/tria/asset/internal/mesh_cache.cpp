@@ -0,0 +1,181 @@
+#include "mesh_cache.hpp"
+#include "tria/math/utils.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include "tria/pal/mapped_file.hpp"
+#include "tria/pal/utils.hpp"
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace tria::asset::internal {
+
+/*
+ * Cache file layout:
+ * - Header (see 'CacheHeader').
+ * - Asset id (without null-terminator), used to detect file name collisions.
+ * - Vertices, aligned to 'g_dataAlign'.
+ * - Indices.
+ * - 'g_fileDataPadding' zero bytes, so the mapping satisfies the 'FileData' padding guarantee.
+ */
+
+namespace {
+
+constexpr std::array<char, 4> g_cacheMagic = {'T', 'M', 'S', 'H'};
+constexpr uint32_t g_cacheVersion          = 1U;
+constexpr size_t g_dataAlign               = 16U;
+
+struct CacheHeader final {
+  std::array<char, 4> magic;
+  uint32_t version;
+  uint32_t vertexSize;
+  uint32_t indexSize;
+  uint64_t srcSize;
+  int64_t srcModTime;
+  uint32_t srcHash;
+  uint32_t idSize;
+  math::Box3f posBounds;
+  math::Box2f texBounds;
+  uint64_t vertexCount;
+  uint64_t indexCount;
+};
+
+static_assert(std::is_trivially_copyable_v<CacheHeader>, "Header has to be trivially copyable");
+static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex has to be trivially copyable");
+
+[[nodiscard]] constexpr auto alignUp(size_t val, size_t align) noexcept {
+  return (val + align - 1U) / align * align;
+}
+
+[[nodiscard]] constexpr auto getVertexOffset(size_t idSize) noexcept {
+  return alignUp(sizeof(CacheHeader) + idSize, g_dataAlign);
+}
+
+} // namespace
+
+auto MeshCache::getKey(const fs::path& srcPath, const FileData& src) noexcept -> MeshCacheKey {
+  auto err           = std::error_code{};
+  const auto modTime = fs::last_write_time(srcPath, err);
+  return MeshCacheKey{
+      src.getSize(),
+      err ? 0 : static_cast<int64_t>(modTime.time_since_epoch().count()),
+      math::hash(src.getBegin(), src.getSize())};
+}
+
+auto MeshCache::load(const AssetId& id, const MeshCacheKey& key) -> std::unique_ptr<Mesh> {
+  const auto path = getEntryPath(id);
+  auto err        = std::error_code{};
+  if (!fs::is_regular_file(path, err)) {
+    return nullptr;
+  }
+  auto mapping = std::shared_ptr<pal::MappedFile>{};
+  try {
+    mapping = std::make_shared<pal::MappedFile>(
+        pal::MappedFile::open(path, pal::MapMode::ReadOnly));
+  } catch (const pal::err::PlatformErr& e) {
+    LOG_W(m_logger, "Failed to open mesh cache", {"path", path}, {"reason", std::string{e.what()}});
+    return nullptr;
+  }
+
+  // Validate the entry, anything unexpected is treated as a cache miss.
+  auto header = CacheHeader{};
+  if (mapping->getSize() < sizeof(CacheHeader)) {
+    return nullptr;
+  }
+  std::memcpy(&header, mapping->getData(), sizeof(CacheHeader));
+  if (header.magic != g_cacheMagic || header.version != g_cacheVersion ||
+      header.vertexSize != sizeof(Vertex) || header.indexSize != sizeof(IndexType)) {
+    return nullptr;
+  }
+  if (header.srcSize != key.srcSize || header.srcModTime != key.srcModTime ||
+      header.srcHash != key.srcHash) {
+    return nullptr;
+  }
+  const auto vertexOffset = getVertexOffset(header.idSize);
+  const auto indexOffset  = vertexOffset + header.vertexCount * sizeof(Vertex);
+  const auto dataEnd      = indexOffset + header.indexCount * sizeof(IndexType);
+  if (header.vertexCount > mapping->getSize() || header.indexCount > mapping->getSize() ||
+      dataEnd + g_fileDataPadding != mapping->getSize()) {
+    return nullptr;
+  }
+  const auto* data    = mapping->getData();
+  const auto storedId = std::string_view{
+      reinterpret_cast<const char*>(data + sizeof(CacheHeader)), header.idSize};
+  if (storedId != id) {
+    return nullptr; // Different asset whose id hashes to the same file name.
+  }
+
+  m_hitCount.fetch_add(1U, std::memory_order_relaxed);
+  return std::make_unique<Mesh>(
+      id,
+      header.posBounds,
+      header.texBounds,
+      FileData{std::move(mapping), data, dataEnd, true},
+      reinterpret_cast<const Vertex*>(data + vertexOffset),
+      static_cast<size_t>(header.vertexCount),
+      reinterpret_cast<const IndexType*>(data + indexOffset),
+      static_cast<size_t>(header.indexCount));
+}
+
+auto MeshCache::save(const AssetId& id, const MeshCacheKey& key, const Mesh& mesh) noexcept
+    -> void {
+  const auto path = getEntryPath(id);
+  try {
+    const auto vertexOffset = getVertexOffset(id.size());
+    const auto vertexBytes  = mesh.getVertexCount() * sizeof(Vertex);
+    const auto indexBytes   = mesh.getIndexCount() * sizeof(IndexType);
+
+    auto header        = CacheHeader{};
+    header.magic       = g_cacheMagic;
+    header.version     = g_cacheVersion;
+    header.vertexSize  = sizeof(Vertex);
+    header.indexSize   = sizeof(IndexType);
+    header.srcSize     = key.srcSize;
+    header.srcModTime  = key.srcModTime;
+    header.srcHash     = key.srcHash;
+    header.idSize      = static_cast<uint32_t>(id.size());
+    header.posBounds   = mesh.getPosBounds();
+    header.texBounds   = mesh.getTexBounds();
+    header.vertexCount = mesh.getVertexCount();
+    header.indexCount  = mesh.getIndexCount();
+
+    // Zero initialized, that takes care of the alignment padding and the tail padding.
+    auto buffer = std::string(vertexOffset + vertexBytes + indexBytes + g_fileDataPadding, '\0');
+    std::memcpy(buffer.data(), &header, sizeof(CacheHeader));
+    std::memcpy(buffer.data() + sizeof(CacheHeader), id.data(), id.size());
+    std::memcpy(buffer.data() + vertexOffset, mesh.getVertexBegin(), vertexBytes);
+    std::memcpy(buffer.data() + vertexOffset + vertexBytes, mesh.getIndexBegin(), indexBytes);
+
+    // Write to a temporary file and then replace the entry, this way other threads and processes
+    // never observe a partially written entry and existing mappings of the old entry stay valid.
+    fs::create_directories(m_cachePath);
+    const auto threadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    auto tmpPath          = path;
+    tmpPath += "." + std::to_string(pal::getCurProcessId()) + "-" + std::to_string(threadHash);
+    {
+      auto file = std::ofstream{tmpPath.string(), std::ios::binary | std::ios::trunc};
+      file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      if (!file.good()) {
+        throw std::runtime_error{"Failed to write file"};
+      }
+    }
+    fs::rename(tmpPath, path);
+
+  } catch (const std::exception& e) {
+    LOG_W(m_logger, "Failed to save mesh cache", {"path", path}, {"reason", std::string{e.what()}});
+  }
+}
+
+auto MeshCache::getEntryPath(const AssetId& id) const -> fs::path {
+  const auto idHash = math::hash(id.data(), id.size());
+  auto name         = std::array<char, 16>{};
+  std::snprintf(name.data(), name.size(), "%08x.mesh", static_cast<unsigned int>(idHash));
+  return m_cachePath / name.data();
+}
+
+} // namespace tria::asset::internal
@@ -0,0 +1,60 @@
+#pragma once
+#include "tria/asset/file_data.hpp"
+#include "tria/asset/mesh.hpp"
+#include "tria/fs.hpp"
+#include "tria/log/api.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace tria::asset::internal {
+
+/* Identifies the version of a source file that a cache entry was created from.
+ */
+struct MeshCacheKey final {
+  uint64_t srcSize;
+  int64_t srcModTime;
+  uint32_t srcHash;
+};
+
+/*
+ * Cache of meshes in a binary format, so source files (for example obj) only have to be parsed
+ * once. Cache entries are memory mapped directly into 'Mesh' assets.
+ *
+ * Entries are stored per asset id and are invalidated when the size, modification time or content
+ * hash of the source file changes, or when the format version or vertex layout changes.
+ * Cache files use the native byte order, they are not meant to be shared between machines.
+ * Is thread-safe.
+ */
+class MeshCache final {
+public:
+  MeshCache(log::Logger* logger, fs::path cachePath) noexcept :
+      m_logger{logger}, m_cachePath{std::move(cachePath)}, m_hitCount{0U} {}
+
+  [[nodiscard]] auto getHitCount() const noexcept {
+    return m_hitCount.load(std::memory_order_relaxed);
+  }
+
+  /* Compute the key for the current version of a source file.
+   */
+  [[nodiscard]] static auto getKey(const fs::path& srcPath, const FileData& src) noexcept
+      -> MeshCacheKey;
+
+  /* Load a cached mesh, returns nullptr if there is no valid cache entry for the key.
+   */
+  [[nodiscard]] auto load(const AssetId& id, const MeshCacheKey& key) -> std::unique_ptr<Mesh>;
+
+  /* Write a cache entry for the mesh, replaces the existing entry (if any).
+   * Failures are logged but otherwise ignored, the cache is only an optimization.
+   */
+  auto save(const AssetId& id, const MeshCacheKey& key, const Mesh& mesh) noexcept -> void;
+
+private:
+  log::Logger* m_logger;
+  fs::path m_cachePath;
+  std::atomic<uint64_t> m_hitCount;
+
+  [[nodiscard]] auto getEntryPath(const AssetId& id) const -> fs::path;
+};
+
+} // namespace tria::asset::internal
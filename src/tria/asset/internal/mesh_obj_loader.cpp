@@ -1,5 +1,6 @@
 #include "loader.hpp"
 #include "mesh_builder.hpp"
+#include "mesh_cache.hpp"
 #include "mesh_utils.hpp"
 #include "tria/asset/mesh.hpp"
 #include "tria/math/vec.hpp"
@@ -378,15 +379,24 @@ ObjDataEnd:
 
 } // namespace
 
-auto loadMeshObj(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, math::RawData raw)
+auto loadMeshObj(log::Logger* /*unused*/, DatabaseImpl* db, AssetId id, FileData raw)
     -> AssetUnique {
 
+  // Parsing obj files is expensive, use the result of a previous run if it is still valid.
+  auto* cache   = db->getMeshCache();
+  auto cacheKey = MeshCacheKey{};
+  if (cache) {
+    cacheKey = MeshCache::getKey(db->getPath(id), raw);
+    if (auto mesh = cache->load(id, cacheKey)) {
+      return mesh;
+    }
+  }
+
   // Assert that the raw buffer is null-terminated which allow us to skip bounds checks, the
   // database implementation currently guarantees that.
-  assert(raw.capacity() > raw.size());
-  assert(*raw.end() == '\0');
+  assert(*raw.getEnd() == '\0');
 
-  auto reader        = Reader{raw.begin()};
+  auto reader        = Reader{raw.getBegin()};
   const auto objData = readObjData(reader);
   if (objData.faces.empty()) {
     throw err::MeshErr{"No faces found in obj"};
@@ -444,8 +454,12 @@ auto loadMeshObj(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id,
 
   assert(vertices.size() <= numMeshVertices);
   assert(indices.size() == numMeshVertices);
-  return std::make_unique<Mesh>(
+  auto mesh = std::make_unique<Mesh>(
       std::move(id), objData.posBounds, objData.texBounds, std::move(vertices), std::move(indices));
+  if (cache) {
+    cache->save(mesh->getId(), cacheKey, *mesh);
+  }
+  return mesh;
 }
 
 } // namespace tria::asset::internal
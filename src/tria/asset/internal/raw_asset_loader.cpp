@@ -3,7 +3,7 @@
 
 namespace tria::asset::internal {
 
-auto loadRawAsset(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, math::RawData raw)
+auto loadRawAsset(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, FileData raw)
     -> AssetUnique {
 
   return std::make_unique<RawAsset>(std::move(id), std::move(raw));
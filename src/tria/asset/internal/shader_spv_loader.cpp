@@ -317,18 +317,18 @@ getShaderResourceKind(const SpvProgram& program, uint32_t typeIdx, SpvStorageCla
 
 } // namespace
 
-auto loadShaderSpv(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, math::RawData raw)
+auto loadShaderSpv(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, FileData raw)
     -> AssetUnique {
 
   // SpirV consists of 32 bit words so we interpret the file as a set of 32 bit words.
   // TODO(bastian): Consider endianness differences, because SpirV consists of only words it might
   // be easiest to just convert to whole data to host endianess if we are running on a big-endian
   // system.
-  if (raw.size() % 4 != 0) {
+  if (raw.getSize() % 4 != 0) {
     throw err::ShaderSpvErr{"Malformed SpirV"};
   }
-  const auto* begin = reinterpret_cast<const uint32_t*>(raw.data());
-  auto reader       = Reader{begin, begin + raw.size() / 4U};
+  const auto* begin = reinterpret_cast<const uint32_t*>(raw.getBegin());
+  auto reader       = Reader{begin, begin + raw.getSize() / 4U};
 
   // Read the header.
   reader.assertRemainingSize(5); // Space needed for the header.
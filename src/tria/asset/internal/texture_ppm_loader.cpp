@@ -185,11 +185,10 @@ private:
 
 } // namespace
 
-auto loadTexturePpm(
-    log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, math::RawData raw)
+auto loadTexturePpm(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, FileData raw)
     -> AssetUnique {
 
-  auto reader = Reader{raw.begin(), raw.end()};
+  auto reader = Reader{raw.getBegin(), raw.getEnd()};
   auto header = readHeader(reader);
 
   if (header.type == PixmapType::Unknown) {
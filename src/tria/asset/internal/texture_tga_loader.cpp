@@ -246,11 +246,10 @@ readTgaPixels(Reader& reader, TextureSize size, bool hasAlpha, bool rle, TgaOrig
 
 } // namespace
 
-auto loadTextureTga(
-    log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, math::RawData raw)
+auto loadTextureTga(log::Logger* /*unused*/, DatabaseImpl* /*unused*/, AssetId id, FileData raw)
     -> AssetUnique {
 
-  auto reader       = Reader{raw.begin(), raw.end()};
+  auto reader       = Reader{raw.getBegin(), raw.getEnd()};
   const auto header = readTgaHeader(reader);
 
   if (!header) {
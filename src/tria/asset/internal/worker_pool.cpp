@@ -0,0 +1,55 @@
+#include "worker_pool.hpp"
+#include "tria/pal/utils.hpp"
+#include <algorithm>
+
+namespace tria::asset::internal {
+
+WorkerPool::WorkerPool(uint32_t workerCount) noexcept :
+    m_workerCount{workerCount ? workerCount : std::max(std::thread::hardware_concurrency(), 1U)},
+    m_shutdown{false} {}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_shutdown = true;
+    m_tasks.clear();
+  }
+  m_condVar.notify_all();
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+auto WorkerPool::push(Task task) -> void {
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_threads.empty()) {
+      m_threads.reserve(m_workerCount);
+      for (auto i = 0U; i != m_workerCount; ++i) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this);
+      }
+    }
+    m_tasks.push_back(std::move(task));
+  }
+  m_condVar.notify_one();
+}
+
+auto WorkerPool::workerLoop() noexcept -> void {
+  pal::setThreadName("tria_asset_worker");
+
+  while (true) {
+    auto task = Task{};
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_condVar.wait(lk, [this]() { return !m_tasks.empty() || m_shutdown; });
+      if (m_shutdown) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+
+} // namespace tria::asset::internal
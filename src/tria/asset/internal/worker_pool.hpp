@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tria::asset::internal {
+
+/*
+ * Pool of threads that execute tasks in the order they were pushed.
+ * Threads are started on the first push, so a database that never loads anything in parallel
+ * (asynchronous loads or the dependencies of a graphic) does not pay for them.
+ * On destruction the tasks that are currently executing are finished, tasks that have not started
+ * yet are discarded (destroying them without executing).
+ * Is thread-safe.
+ */
+class WorkerPool final {
+public:
+  using Task = std::function<void()>;
+
+  /* 'workerCount' of 0 uses the amount of hardware threads.
+   */
+  explicit WorkerPool(uint32_t workerCount) noexcept;
+  WorkerPool(const WorkerPool& rhs) = delete;
+  WorkerPool(WorkerPool&& rhs)      = delete;
+  ~WorkerPool();
+
+  auto operator=(const WorkerPool& rhs) -> WorkerPool& = delete;
+  auto operator=(WorkerPool&& rhs) -> WorkerPool& = delete;
+
+  [[nodiscard]] auto getWorkerCount() const noexcept { return m_workerCount; }
+
+  /* Queue a task to be executed on one of the worker threads.
+   */
+  auto push(Task task) -> void;
+
+private:
+  uint32_t m_workerCount;
+  bool m_shutdown;
+  std::deque<Task> m_tasks;
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_condVar;
+
+  auto workerLoop() noexcept -> void;
+};
+
+} // namespace tria::asset::internal
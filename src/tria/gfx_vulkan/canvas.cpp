@@ -24,6 +24,8 @@ auto Canvas::draw(
   m_native->draw(asset, indexCount, instData, instDatSize, count);
 }
 
+auto Canvas::releaseAsset(const asset::Asset* asset) -> void { m_native->releaseAsset(asset); }
+
 auto Canvas::drawEnd() -> void { m_native->drawEnd(); }
 
 } // namespace tria::gfx
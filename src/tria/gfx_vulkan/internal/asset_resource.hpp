@@ -1,6 +1,8 @@
 #pragma once
+#include "tria/asset/handle.hpp"
 #include "tria/log/api.hpp"
 #include <cassert>
+#include <iterator>
 #include <memory>
 #include <unordered_map>
 
@@ -9,6 +11,8 @@ namespace tria::gfx::internal {
 class Device;
 
 /* Repository for resources that are created per asset.
+ * Resources hold a handle to their asset, this keeps the asset loaded (and its address in use) so
+ * a resource can never be mistaken for the resource of a newer asset at the same address.
  */
 template <typename T>
 class AssetResource final {
@@ -25,18 +29,46 @@ public:
     // If we already have a resource for the given asset then return that.
     const auto itr = m_data.find(asset);
     if (itr != m_data.end()) {
-      return &itr->second;
+      return &itr->second.resource;
     }
 
     // Otherwise construct a new resource.
-    const auto insertItr = m_data.try_emplace(asset, m_logger, m_device, asset, parameters...);
-    return &insertItr.first->second;
+    // Note: Assets that are not owned by a database (for example in tests) get an empty handle,
+    // for those the caller is responsible for keeping the asset alive.
+    auto handle          = asset::AssetHandle{asset->weak_from_this().lock()};
+    const auto insertItr =
+        m_data.try_emplace(asset, std::move(handle), m_logger, m_device, asset, parameters...);
+    return &insertItr.first->second.resource;
+  }
+
+  /* Destroy the resource for the given asset (if any), it is recreated on the next request.
+   * Note: The resource should not be in use anymore.
+   */
+  auto release(const AssetType* asset) -> void { m_data.erase(asset); }
+
+  /* Destroy the resources whose asset matches the predicate.
+   * Note: The resources should not be in use anymore.
+   */
+  template <typename Predicate>
+  auto releaseIf(Predicate pred) -> void {
+    for (auto itr = m_data.begin(); itr != m_data.end();) {
+      itr = pred(itr->first) ? m_data.erase(itr) : std::next(itr);
+    }
   }
 
 private:
+  struct Entry final {
+    asset::AssetHandle handle;
+    T resource;
+
+    template <typename... Args>
+    explicit Entry(asset::AssetHandle assetHandle, Args&&... args) :
+        handle{std::move(assetHandle)}, resource(std::forward<Args>(args)...) {}
+  };
+
   log::Logger* m_logger;
   Device* m_device;
-  std::unordered_map<const AssetType*, T> m_data;
+  std::unordered_map<const AssetType*, Entry> m_data;
 };
 
 template <typename T>
@@ -112,19 +112,19 @@ auto DebugMessenger::handleMessage(
     LOG_E(
         m_logger,
         "Vulkan validation error",
-        {"type", messageTypeLabel},
+        {"type", log::StaticStr{messageTypeLabel}},
         {"message", pCallbackData->pMessage});
   } else if (messageSeverity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
     LOG_W(
         m_logger,
         "Vulkan validation warning",
-        {"type", messageTypeLabel},
+        {"type", log::StaticStr{messageTypeLabel}},
         {"message", pCallbackData->pMessage});
   } else {
     LOG_D(
         m_logger,
         "Vulkan validation message",
-        {"type", messageTypeLabel},
+        {"type", log::StaticStr{messageTypeLabel}},
         {"message", pCallbackData->pMessage});
   }
 }
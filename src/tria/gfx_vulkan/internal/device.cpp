@@ -253,9 +253,9 @@ Device::Device(
       {"deviceName", m_properties.deviceName},
       {"graphicsQueueIdx", m_graphicsQueueIdx},
       {"presentQueueIdx", m_presentQueueIdx},
-      {"surfaceFormat", getVkFormatString(m_surfaceFormatInfo.format)},
-      {"surfaceColorSpace", getVkColorSpaceString(m_surfaceFormatInfo.colorSpace)},
-      {"depthFormat", getVkFormatString(m_depthFormat)});
+      {"surfaceFormat", log::StaticStr{getVkFormatString(m_surfaceFormatInfo.format)}},
+      {"surfaceColorSpace", log::StaticStr{getVkColorSpaceString(m_surfaceFormatInfo.colorSpace)}},
+      {"depthFormat", log::StaticStr{getVkFormatString(m_depthFormat)}});
 }
 
 Device::~Device() {
@@ -340,9 +340,9 @@ getDevice(log::Logger* logger, const NativeContext* context, const pal::Window*
         "Found Vulkan physical device",
         {"deviceId", properties.deviceID},
         {"deviceName", properties.deviceName},
-        {"deviceType", getVkDeviceTypeString(properties.deviceType)},
+        {"deviceType", log::StaticStr{getVkDeviceTypeString(properties.deviceType)}},
         {"vendorId", properties.vendorID},
-        {"vendorName", getVkVendorString(properties.vendorID)},
+        {"vendorName", log::StaticStr{getVkVendorString(properties.vendorID)}},
         {"suitable", deviceIsSuitable},
         {"score", score});
 
@@ -16,6 +16,11 @@ namespace {
  */
 constexpr auto g_maxInstanceCount = 2048U;
 
+/* Warnings while binding data or drawing can fire every frame (or every draw), rate limit them to
+ * avoid flooding the log.
+ */
+constexpr auto g_drawWarnRateLimit = log::perSecond(1U);
+
 /* Create a pipeline layout with a single global descriptor-set 0, all pipeline layouts have to be
  * compatible with this layout. This allows us to share the global data binding between different
  * pipelines.
@@ -229,12 +234,13 @@ auto Renderer::drawBegin(
 
 auto Renderer::bindGlobalData(const void* data, size_t dataSize) -> void {
   if (!data || !dataSize) {
-    LOG_W(m_logger, "Attempting to bind 0 data");
+    LOG_W_RATE(m_logger, g_drawWarnRateLimit, "Attempting to bind 0 data");
     return;
   }
   if (dataSize > m_uni->getMaxDataSize()) {
-    LOG_W(
+    LOG_W_RATE(
         m_logger,
+        g_drawWarnRateLimit,
         "Global data size exceeds maximum",
         {"size", log::MemSize{dataSize}},
         {"maxSize", log::MemSize{m_uni->getMaxDataSize()}});
@@ -263,8 +269,9 @@ auto Renderer::draw(
     uint32_t count) -> void {
 
   if (instDataSize > m_uni->getMaxDataSize()) {
-    LOG_W(
+    LOG_W_RATE(
         m_logger,
+        g_drawWarnRateLimit,
         "Instance data size exceeds maximum",
         {"size", log::MemSize{instDataSize}},
         {"maxSize", log::MemSize{m_uni->getMaxDataSize()}},
@@ -272,7 +279,11 @@ auto Renderer::draw(
     return;
   }
   if (graphic->getUsesGlobalData() && !m_hasBoundGlobalData) {
-    LOG_W(m_logger, "Graphic uses global data but none is bound", {"graphic", graphic->getId()});
+    LOG_W_RATE(
+        m_logger,
+        g_drawWarnRateLimit,
+        "Graphic uses global data but none is bound",
+        {"graphic", graphic->getId()});
     return;
   }
 
@@ -315,8 +326,9 @@ auto Renderer::draw(
 
   if (!indexCount) {
     DBG_CMD_END_LABEL(m_device, m_drawVkCommandBuffer);
-    LOG_W(
+    LOG_W_RATE(
         m_logger,
+        g_drawWarnRateLimit,
         "IndexCount of zero is provided but graphic has no mesh",
         {"graphic", graphic->getId()});
     return;
@@ -324,8 +336,9 @@ auto Renderer::draw(
 
   if (graphic->getUsesInstanceData() && (!instData || instDataSize == 0U)) {
     DBG_CMD_END_LABEL(m_device, m_drawVkCommandBuffer);
-    LOG_W(
+    LOG_W_RATE(
         m_logger,
+        g_drawWarnRateLimit,
         "Graphic uses instance data but none was provided",
         {"graphic", graphic->getId()});
     return;
@@ -258,7 +258,7 @@ auto Swapchain::initSwapchain() -> bool {
       m_logger,
       "Vulkan swapchain created",
       {"vSync", getName(m_vSync)},
-      {"presentMode", getVkPresentModeString(presentMode)},
+      {"presentMode", log::StaticStr{getVkPresentModeString(presentMode)}},
       {"imageCount", m_images.size()},
       {"size", m_size});
 
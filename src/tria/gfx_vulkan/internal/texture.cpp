@@ -31,7 +31,7 @@ Texture::Texture(log::Logger* logger, Device* device, const asset::Texture* asse
       {"size", m_image.getSize()},
       {"mipMode", getName(m_image.getMipMode())},
       {"mipLevels", m_image.getMipLevels()},
-      {"format", getVkFormatString(vkFormat)},
+      {"format", log::StaticStr{getVkFormatString(vkFormat)}},
       {"memory", log::MemSize{m_image.getMemSize()}});
 }
 
@@ -4,6 +4,7 @@
 #include "tria/gfx/err/gfx_err.hpp"
 #include "tria/gfx/err/sync_err.hpp"
 #include "tria/pal/utils.hpp"
+#include <algorithm>
 #include <cassert>
 
 namespace tria::gfx {
@@ -120,6 +121,52 @@ auto NativeCanvas::draw(
   getCurRenderer().draw(*m_fwdTechnique, graphic, indexCount, instData, instDataSize, count);
 }
 
+auto NativeCanvas::releaseAsset(const asset::Asset* asset) -> void {
+  assert(asset);
+  if (m_curSwapchainImgIdx) {
+    throw err::SyncErr{"Unable to release an asset: draw active"};
+  }
+
+  // Resources can still be in use by the frames that are executing on the gpu.
+  getCurRenderer().waitUntilReady();
+  getPrevRenderer().waitUntilReady();
+
+  // Graphics hold on to the resources of their shaders, mesh and textures, so they have to be
+  // released as well. Only the affected pipelines and buffers are recreated on the next draw.
+  switch (asset->getKind()) {
+  case asset::AssetKind::Graphic:
+    m_graphics->release(asset->downcast<asset::Graphic>());
+    break;
+  case asset::AssetKind::Shader: {
+    const auto* shader = asset->downcast<asset::Shader>();
+    m_graphics->releaseIf([shader](const asset::Graphic* gfx) {
+      return std::find(gfx->getShaderBegin(), gfx->getShaderEnd(), shader) != gfx->getShaderEnd();
+    });
+    m_shaders->release(shader);
+    break;
+  }
+  case asset::AssetKind::Mesh: {
+    const auto* mesh = asset->downcast<asset::Mesh>();
+    m_graphics->releaseIf([mesh](const asset::Graphic* gfx) { return gfx->getMesh() == mesh; });
+    m_meshes->release(mesh);
+    break;
+  }
+  case asset::AssetKind::Texture: {
+    const auto* texture = asset->downcast<asset::Texture>();
+    m_graphics->releaseIf([texture](const asset::Graphic* gfx) {
+      return std::any_of(
+          gfx->getSamplerBegin(), gfx->getSamplerEnd(), [texture](const auto& sampler) {
+            return sampler.getTexture() == texture;
+          });
+    });
+    m_textures->release(texture);
+    break;
+  }
+  case asset::AssetKind::Raw:
+    break; // Raw assets do not have gpu resources.
+  }
+}
+
 auto NativeCanvas::drawEnd() -> void {
   if (!m_curSwapchainImgIdx) {
     throw err::SyncErr{"Unable to end a draw: no draw active"};
@@ -59,6 +59,10 @@ public:
       size_t instDataSize,
       uint32_t size) -> void;
 
+  /* Destroy the resources for the given asset and the graphics that use it.
+   */
+  auto releaseAsset(const asset::Asset* asset) -> void;
+
   /* Stop recording draw commands, execute the commands and present the result to the surface
    * (window).
    */
@@ -0,0 +1,89 @@
+#include "tria/log/bin_reader.hpp"
+#include "internal/bin_decoder.hpp"
+#include "internal/lz_stream.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include <cassert>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace tria::log {
+
+namespace {
+
+// Size of the chunks that are read from the file, records that span chunks are decoded once the
+// next chunk has been read.
+constexpr size_t g_readChunkSize = 64U * 1024U;
+
+} // namespace
+
+auto readBinaryLog(const fs::path& path, Sink* sink) -> size_t {
+  assert(sink);
+
+  auto file = std::ifstream{path.string(), std::ios::binary};
+  if (!file.is_open()) {
+    throw err::LogDecodeErr{"Failed to open file: " + path.string()};
+  }
+
+  auto decoder     = internal::BinDecoder{};
+  auto buffer      = std::vector<uint8_t>{};
+  auto headerValid = false;
+  auto msg         = Message{};
+  auto msgCount    = size_t{0};
+
+  // Compressed logs are decompressed into the buffer, 'compressedBuffer' keeps the compressed data.
+  auto compressed       = false;
+  auto decompressor     = internal::LzStreamReader{};
+  auto compressedBuffer = std::vector<uint8_t>{};
+  auto decompressed     = std::string{};
+  while (file) {
+    // Append the next chunk to the remaining (not yet decoded) data.
+    auto* chunkBuffer   = compressed ? &compressedBuffer : &buffer;
+    const auto prevSize = chunkBuffer->size();
+    chunkBuffer->resize(prevSize + g_readChunkSize);
+    file.read(reinterpret_cast<char*>(chunkBuffer->data() + prevSize), g_readChunkSize);
+    chunkBuffer->resize(prevSize + static_cast<size_t>(file.gcount()));
+
+    if (!headerValid && !compressed && internal::isLzStream(buffer.data(), buffer.size())) {
+      compressed = true;
+      compressedBuffer.swap(buffer);
+    }
+    if (compressed) {
+      const auto consumed =
+          decompressor.read(compressedBuffer.data(), compressedBuffer.size(), &decompressed);
+      compressedBuffer.erase(compressedBuffer.begin(), compressedBuffer.begin() + consumed);
+      buffer.insert(buffer.end(), decompressed.begin(), decompressed.end());
+      decompressed.clear();
+    }
+
+    auto cursor = internal::BinCursor{buffer.data(), buffer.data() + buffer.size()};
+    if (!headerValid) {
+      headerValid = internal::BinDecoder::decodeHeader(&cursor);
+      if (!headerValid) {
+        continue;
+      }
+    }
+
+    auto res = internal::BinDecodeResult{};
+    while ((res = decoder.decodeRecord(&cursor, &msg)) != internal::BinDecodeResult::Incomplete) {
+      if (res == internal::BinDecodeResult::Message &&
+          isInMask(sink->getMask(), msg.getMeta()->getLevel())) {
+        sink->write(msg);
+        ++msgCount;
+      }
+    }
+
+    // Keep the incomplete data for the next chunk.
+    buffer.erase(buffer.begin(), buffer.begin() + (cursor.getCur() - buffer.data()));
+  }
+
+  if (!headerValid) {
+    throw err::LogDecodeErr{"Missing header"};
+  }
+  if (!buffer.empty() || !compressedBuffer.empty()) {
+    throw err::LogDecodeErr{"Truncated record at end of file"};
+  }
+  return msgCount;
+}
+
+} // namespace tria::log
@@ -0,0 +1,52 @@
+#include "internal/bin_encoder.hpp"
+#include "internal/file_sink.hpp"
+
+namespace tria::log {
+
+/*
+ * Sink that writes messages in the compact binary log format (see 'internal/bin_format.hpp').
+ * Static data (call-site metadata and parameter keys) is only written once and referenced by id,
+ * messages only contain the id, timestamp and the raw parameter values.
+ * Every (rotated) file starts with a header and repeats the static data it uses, so each file can
+ * be decoded on its own.
+ */
+class BinarySink final : public internal::FileSink {
+public:
+  BinarySink(std::FILE* fileHandle, bool closeFile, LevelMask mask, FlushPolicy flushPolicy) :
+      FileSink{fileHandle, closeFile, mask, flushPolicy} {}
+  ~BinarySink() override {
+    // Make sure the header is written, even when no messages were logged.
+    startFile();
+  }
+
+protected:
+  auto format(const Message& msg, std::string* out) noexcept -> void override {
+    // Make sure all static data is written before the message that references it.
+    m_encoder.encodeStatic(msg, out);
+    m_encoder.encodeMessage(msg, out);
+  }
+
+  auto beginFile(std::string* out) noexcept -> void override {
+    // Write the header.
+    out->append(internal::g_binMagic.data(), internal::g_binMagic.size());
+    internal::writeBinFixed(out, internal::g_binVersion);
+
+    // Static data has to be written again to the new file.
+    m_encoder.reset();
+  }
+
+private:
+  internal::BinEncoder m_encoder;
+};
+
+auto makeFileBinarySink(
+    fs::path path,
+    LevelMask mask,
+    FlushPolicy flushPolicy,
+    RotationPolicy rotationPolicy,
+    Compression compression) -> SinkUnique {
+  return internal::makeFileSink<BinarySink>(
+      std::move(path), true, mask, flushPolicy, rotationPolicy, compression);
+}
+
+} // namespace tria::log
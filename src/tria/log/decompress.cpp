@@ -0,0 +1,52 @@
+#include "tria/log/decompress.hpp"
+#include "internal/lz_stream.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include <cassert>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace tria::log {
+
+namespace {
+
+// Size of the chunks that are read from the file, blocks that span chunks are decompressed once
+// the next chunk has been read.
+constexpr size_t g_readChunkSize = 64U * 1024U;
+
+} // namespace
+
+auto decompressLog(const fs::path& path, std::FILE* output) -> uint64_t {
+  assert(output);
+
+  auto file = std::ifstream{path.string(), std::ios::binary};
+  if (!file.is_open()) {
+    throw err::LogDecodeErr{"Failed to open file: " + path.string()};
+  }
+
+  auto reader     = internal::LzStreamReader{};
+  auto buffer     = std::vector<uint8_t>{};
+  auto raw        = std::string{};
+  auto outputSize = uint64_t{0};
+  while (file) {
+    // Append the next chunk to the remaining (not yet decompressed) data.
+    const auto prevSize = buffer.size();
+    buffer.resize(prevSize + g_readChunkSize);
+    file.read(reinterpret_cast<char*>(buffer.data() + prevSize), g_readChunkSize);
+    buffer.resize(prevSize + static_cast<size_t>(file.gcount()));
+
+    const auto consumed = reader.read(buffer.data(), buffer.size(), &raw);
+    buffer.erase(buffer.begin(), buffer.begin() + consumed);
+
+    std::fwrite(raw.data(), raw.size(), 1, output);
+    outputSize += raw.size();
+    raw.clear();
+  }
+
+  if (!buffer.empty()) {
+    throw err::LogDecodeErr{"Truncated block at end of file"};
+  }
+  return outputSize;
+}
+
+} // namespace tria::log
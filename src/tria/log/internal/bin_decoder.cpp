@@ -0,0 +1,309 @@
+#include "bin_decoder.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace tria::log::internal {
+
+namespace {
+
+/*
+ * Interned metadata, owns the strings that the metadata points to.
+ */
+struct InternedMetaData final {
+  std::string txt;
+  std::string file;
+  std::string func;
+  MetaData meta;
+
+  InternedMetaData(
+      Level lvl,
+      std::string_view txt,
+      std::string_view file,
+      std::string_view func,
+      uint32_t line) :
+      txt{txt}, file{file}, func{func}, meta{lvl, this->txt, this->file, this->func, line} {}
+};
+
+using MetaDataKey =
+    std::tuple<Level, std::string_view, std::string_view, std::string_view, uint32_t>;
+
+/* Get a metadata instance that lives for the remainder of the process.
+ * Identical metadata (for example when decoding the same log twice) is only stored once.
+ */
+[[nodiscard]] auto internMetaData(
+    Level lvl, std::string_view txt, std::string_view file, std::string_view func, uint32_t line)
+    -> const MetaData* {
+  static std::mutex mutex;
+  static std::deque<InternedMetaData> storage; // Deque keeps the entries at a stable address.
+  static std::map<MetaDataKey, const MetaData*> lookup;
+
+  const auto lk = std::lock_guard<std::mutex>{mutex};
+  auto itr      = lookup.find(MetaDataKey{lvl, txt, file, func, line});
+  if (itr == lookup.end()) {
+    const auto& meta = storage.emplace_back(lvl, txt, file, func, line).meta;
+
+    // Key points into the interned strings.
+    const auto key = MetaDataKey{lvl, meta.getTxt(), meta.getFile(), meta.getFunc(), line};
+    itr            = lookup.emplace(key, &meta).first;
+  }
+  return itr->second;
+}
+
+[[nodiscard]] auto isValidLevel(uint8_t lvl) noexcept {
+  switch (static_cast<Level>(lvl)) {
+  case Level::Debug:
+  case Level::Info:
+  case Level::Warn:
+  case Level::Error:
+    return true;
+  }
+  return false;
+}
+
+[[nodiscard]] auto toTimePoint(int64_t nanoSec) noexcept -> TimePoint {
+  return TimePoint{std::chrono::duration_cast<TimePoint::duration>(
+      std::chrono::nanoseconds{nanoSec})};
+}
+
+/* Read a single (non-list) value and add it to the output vector.
+ * Returns false if not enough data is available.
+ */
+auto readValue(BinCursor* cursor, BinValueKind kind, std::vector<Value>* out) -> bool {
+  switch (kind) {
+  case BinValueKind::Int: {
+    int64_t val;
+    if (!cursor->readVarInt(&val)) {
+      return false;
+    }
+    out->emplace_back(val);
+    return true;
+  }
+  case BinValueKind::UInt: {
+    uint64_t val;
+    if (!cursor->readVarUInt(&val)) {
+      return false;
+    }
+    out->emplace_back(val);
+    return true;
+  }
+  case BinValueKind::Double: {
+    double val;
+    if (!cursor->readFixed(&val)) {
+      return false;
+    }
+    out->emplace_back(val);
+    return true;
+  }
+  case BinValueKind::Float: {
+    float val;
+    if (!cursor->readFixed(&val)) {
+      return false;
+    }
+    out->emplace_back(val);
+    return true;
+  }
+  case BinValueKind::Bool: {
+    uint8_t val;
+    if (!cursor->readByte(&val)) {
+      return false;
+    }
+    out->emplace_back(val != 0U);
+    return true;
+  }
+  case BinValueKind::Str: {
+    std::string_view val;
+    if (!cursor->readStr(&val)) {
+      return false;
+    }
+    out->emplace_back(val);
+    return true;
+  }
+  case BinValueKind::Path: {
+    std::string_view val;
+    if (!cursor->readStr(&val)) {
+      return false;
+    }
+    out->emplace_back(fs::path{val});
+    return true;
+  }
+  case BinValueKind::Duration: {
+    double val;
+    if (!cursor->readFixed(&val)) {
+      return false;
+    }
+    out->emplace_back(Duration{val});
+    return true;
+  }
+  case BinValueKind::TimePoint: {
+    int64_t val;
+    if (!cursor->readFixed(&val)) {
+      return false;
+    }
+    out->emplace_back(toTimePoint(val));
+    return true;
+  }
+  case BinValueKind::MemSize: {
+    uint64_t val;
+    if (!cursor->readVarUInt(&val)) {
+      return false;
+    }
+    out->emplace_back(MemSize{static_cast<size_t>(val)});
+    return true;
+  }
+  case BinValueKind::List:
+    throw err::LogDecodeErr{"Nested lists are not supported"};
+  }
+  throw err::LogDecodeErr{"Unknown value kind"};
+}
+
+} // namespace
+
+auto BinDecoder::decodeHeader(BinCursor* cursor) -> bool {
+  if (cursor->getRemaining() < g_binHeaderSize) {
+    return false;
+  }
+  std::array<char, g_binMagic.size()> magic;
+  uint32_t version;
+  [[maybe_unused]] const auto success = cursor->readFixed(&magic) && cursor->readFixed(&version);
+  assert(success);
+
+  if (magic != g_binMagic) {
+    throw err::LogDecodeErr{"Not a binary log (magic mismatch)"};
+  }
+  // Newer versions only add value kinds, so older logs can still be decoded.
+  if (version == 0U || version > g_binVersion) {
+    throw err::LogDecodeErr{"Unsupported version: " + std::to_string(version)};
+  }
+  return true;
+}
+
+auto BinDecoder::decodeRecord(BinCursor* cursor, Message* out) -> BinDecodeResult {
+  const auto start = *cursor;
+
+  uint8_t kind;
+  if (!cursor->readByte(&kind)) {
+    return BinDecodeResult::Incomplete;
+  }
+  auto complete = false;
+  auto result   = BinDecodeResult::Record;
+  switch (static_cast<BinRecordKind>(kind)) {
+  case BinRecordKind::MetaData:
+    complete = decodeMeta(cursor);
+    break;
+  case BinRecordKind::Key:
+    complete = decodeKey(cursor);
+    break;
+  case BinRecordKind::Message:
+    complete = decodeMessage(cursor, out);
+    result   = BinDecodeResult::Message;
+    break;
+  default:
+    throw err::LogDecodeErr{"Unknown record kind: " + std::to_string(kind)};
+  }
+  if (!complete) {
+    *cursor = start;
+    return BinDecodeResult::Incomplete;
+  }
+  return result;
+}
+
+auto BinDecoder::decodeMeta(BinCursor* cursor) -> bool {
+  uint64_t id, line;
+  uint8_t lvl;
+  std::string_view txt, file, func;
+  if (!cursor->readVarUInt(&id) || !cursor->readByte(&lvl) || !cursor->readStr(&txt) ||
+      !cursor->readStr(&file) || !cursor->readStr(&func) || !cursor->readVarUInt(&line)) {
+    return false;
+  }
+  if (id != m_metas.size()) {
+    throw err::LogDecodeErr{"Unexpected metadata id: " + std::to_string(id)};
+  }
+  if (!isValidLevel(lvl)) {
+    throw err::LogDecodeErr{"Invalid level: " + std::to_string(lvl)};
+  }
+  m_metas.push_back(
+      internMetaData(static_cast<Level>(lvl), txt, file, func, static_cast<uint32_t>(line)));
+  return true;
+}
+
+auto BinDecoder::decodeKey(BinCursor* cursor) -> bool {
+  uint64_t id;
+  std::string_view key;
+  if (!cursor->readVarUInt(&id) || !cursor->readStr(&key)) {
+    return false;
+  }
+  if (id != m_keys.size()) {
+    throw err::LogDecodeErr{"Unexpected key id: " + std::to_string(id)};
+  }
+  m_keys.emplace_back(key);
+  return true;
+}
+
+auto BinDecoder::decodeMessage(BinCursor* cursor, Message* out) -> bool {
+  uint64_t metaId, paramCount;
+  int64_t time;
+  if (!cursor->readVarUInt(&metaId) || !cursor->readFixed(&time) ||
+      !cursor->readVarUInt(&paramCount)) {
+    return false;
+  }
+  if (metaId >= m_metas.size()) {
+    throw err::LogDecodeErr{"Unknown metadata id: " + std::to_string(metaId)};
+  }
+  // Every parameter takes at least two bytes (key id and value kind), protects against
+  // allocating huge amounts of memory for corrupt counts.
+  if (paramCount > cursor->getRemaining() / 2U) {
+    return false;
+  }
+  auto params = std::vector<Param>{};
+  params.reserve(paramCount);
+  for (auto i = 0U; i != paramCount; ++i) {
+    if (!decodeParam(cursor, &params)) {
+      return false;
+    }
+  }
+  *out = Message{m_metas[metaId], toTimePoint(time), std::move(params)};
+  return true;
+}
+
+auto BinDecoder::decodeParam(BinCursor* cursor, std::vector<Param>* out) -> bool {
+  uint64_t keyId;
+  uint8_t kind;
+  if (!cursor->readVarUInt(&keyId) || !cursor->readByte(&kind)) {
+    return false;
+  }
+  if (keyId >= m_keys.size()) {
+    throw err::LogDecodeErr{"Unknown key id: " + std::to_string(keyId)};
+  }
+  const std::string_view key = m_keys[keyId];
+
+  auto values = std::vector<Value>{};
+  if (static_cast<BinValueKind>(kind) == BinValueKind::List) {
+    uint64_t count;
+    if (!cursor->readVarUInt(&count) || count > cursor->getRemaining()) {
+      return false;
+    }
+    values.reserve(count);
+    for (auto i = 0U; i != count; ++i) {
+      uint8_t elemKind;
+      if (!cursor->readByte(&elemKind) ||
+          !readValue(cursor, static_cast<BinValueKind>(elemKind), &values)) {
+        return false;
+      }
+    }
+    out->emplace_back(key, std::move(values));
+    return true;
+  }
+  if (!readValue(cursor, static_cast<BinValueKind>(kind), &values)) {
+    return false;
+  }
+  out->emplace_back(key, std::move(values.front()));
+  return true;
+}
+
+} // namespace tria::log::internal
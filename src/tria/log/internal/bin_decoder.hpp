@@ -0,0 +1,51 @@
+#pragma once
+#include "bin_format.hpp"
+#include "tria/log/message.hpp"
+#include "tria/log/metadata.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace tria::log::internal {
+
+enum class BinDecodeResult {
+  Incomplete, // Not enough data available to decode the next record.
+  Record,     // A metadata or key record was decoded.
+  Message,    // A message was decoded.
+};
+
+/*
+ * Decoder for the binary log format (see 'bin_format.hpp').
+ * Keeps track of the metadata and keys that have been written to the log, decoded messages
+ * reference keys that are owned by the decoder so messages cannot outlive it.
+ *
+ * Note: Decoded metadata is interned for the lifetime of the process, this way it satisfies the
+ * 'MetaData' lifetime requirement (sinks cache call-site data by address).
+ *
+ * Throws a 'LogDecodeErr' when encountering invalid data.
+ */
+class BinDecoder final {
+public:
+  BinDecoder() = default;
+
+  /* Validate the header at the start of a binary log.
+   * Returns false if not enough data is available.
+   */
+  [[nodiscard]] static auto decodeHeader(BinCursor* cursor) -> bool;
+
+  /* Decode a single record.
+   * In case of an incomplete record the cursor is left at the start of the record.
+   */
+  [[nodiscard]] auto decodeRecord(BinCursor* cursor, Message* out) -> BinDecodeResult;
+
+private:
+  std::vector<const MetaData*> m_metas;
+  std::deque<std::string> m_keys; // Deque keeps the keys at a stable address.
+
+  auto decodeMeta(BinCursor* cursor) -> bool;
+  auto decodeKey(BinCursor* cursor) -> bool;
+  auto decodeMessage(BinCursor* cursor, Message* out) -> bool;
+  auto decodeParam(BinCursor* cursor, std::vector<Param>* out) -> bool;
+};
+
+} // namespace tria::log::internal
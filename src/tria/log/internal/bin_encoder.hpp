@@ -0,0 +1,119 @@
+#pragma once
+#include "bin_format.hpp"
+#include "tria/log/message.hpp"
+#include "tria/log/metadata.hpp"
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+
+namespace tria::log::internal {
+
+/*
+ * Encoder for the binary log format (see 'bin_format.hpp').
+ * Static data (call-site metadata and parameter keys) is assigned an id and only written the first
+ * time it is used, messages reference it by id.
+ * Static records can be written to a different output than the messages (as long as decoders see
+ * them before the messages that reference them).
+ */
+class BinEncoder final {
+public:
+  /* Point to roll back to, see 'rollback()'.
+   */
+  struct Mark final {
+    size_t metaCount;
+    size_t keyCount;
+  };
+
+  BinEncoder() = default;
+
+  [[nodiscard]] auto getMark() const noexcept -> Mark {
+    return {m_metaIds.size(), m_keyStorage.size()};
+  }
+
+  /* Forget all static data, it will be written again when used.
+   */
+  auto reset() noexcept -> void {
+    m_metaIds.clear();
+    m_keyIds.clear();
+    m_keyStorage.clear();
+  }
+
+  /* Forget the static data that was registered after the mark was taken, for example because the
+   * records that were encoded for it could not be stored.
+   */
+  auto rollback(Mark mark) noexcept -> void {
+    for (auto itr = m_metaIds.begin(); itr != m_metaIds.end();) {
+      itr = itr->second >= mark.metaCount ? m_metaIds.erase(itr) : std::next(itr);
+    }
+    while (m_keyStorage.size() > mark.keyCount) {
+      m_keyIds.erase(m_keyStorage.back());
+      m_keyStorage.pop_back();
+    }
+  }
+
+  /* Write the static records for the data of the message that has not been written yet.
+   */
+  auto encodeStatic(const Message& msg, std::string* out) noexcept -> void {
+    getMetaId(out, msg.getMeta());
+    for (const auto& param : msg) {
+      getKeyId(out, param.getKey());
+    }
+  }
+
+  /* Write a message record.
+   * Pre-condition: Static data of the message has been encoded (see 'encodeStatic()').
+   */
+  auto encodeMessage(const Message& msg, std::string* out) noexcept -> void {
+    writeBinByte(out, static_cast<uint8_t>(BinRecordKind::Message));
+    writeBinVarUInt(out, getMetaId(out, msg.getMeta()));
+    writeBinFixed<int64_t>(
+        out,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(msg.getTime().time_since_epoch())
+            .count());
+    writeBinVarUInt(out, static_cast<uint64_t>(msg.end() - msg.begin()));
+
+    for (const auto& param : msg) {
+      writeBinVarUInt(out, getKeyId(out, param.getKey()));
+      param.writeValue(out, ParamWriteMode::Binary);
+    }
+  }
+
+private:
+  std::unordered_map<const MetaData*, uint64_t> m_metaIds;
+  std::deque<std::string> m_keyStorage; // Owns the key strings, deque keeps them at stable address.
+  std::unordered_map<std::string_view, uint64_t> m_keyIds;
+
+  auto getMetaId(std::string* out, const MetaData* meta) noexcept -> uint64_t {
+    const auto [itr, inserted] = m_metaIds.try_emplace(meta, m_metaIds.size());
+    if (inserted) {
+      // First message for this call-site: write its metadata.
+      writeBinByte(out, static_cast<uint8_t>(BinRecordKind::MetaData));
+      writeBinVarUInt(out, itr->second);
+      writeBinByte(out, static_cast<uint8_t>(meta->getLevel()));
+      writeBinStr(out, meta->getTxt());
+      writeBinStr(out, meta->getFile());
+      writeBinStr(out, meta->getFunc());
+      writeBinVarUInt(out, meta->getLine());
+    }
+    return itr->second;
+  }
+
+  auto getKeyId(std::string* out, std::string_view key) noexcept -> uint64_t {
+    const auto itr = m_keyIds.find(key);
+    if (itr != m_keyIds.end()) {
+      return itr->second;
+    }
+    // First use of this key: write it.
+    const auto id = static_cast<uint64_t>(m_keyIds.size());
+    m_keyIds.insert({m_keyStorage.emplace_back(key), id});
+
+    writeBinByte(out, static_cast<uint8_t>(BinRecordKind::Key));
+    writeBinVarUInt(out, id);
+    writeBinStr(out, key);
+    return id;
+  }
+};
+
+} // namespace tria::log::internal
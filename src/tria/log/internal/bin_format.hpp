@@ -0,0 +1,157 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace tria::log::internal {
+
+/*
+ * Binary log format.
+ * Compact format that stores the raw (unformatted) message data, formatting is deferred until the
+ * log is decoded (for example by the 'tria_logdecode' tool).
+ *
+ * Layout:
+ * - Header: magic ('TLOG') followed by a 32 bit format version.
+ * - Records, each starting with a 'BinRecordKind' byte:
+ *   - MetaData: id, level, text, file, function and line of a log call-site.
+ *     Written once, the first time a call-site logs a message.
+ *   - Key: id and text of a parameter key, written once the first time a key is used.
+ *   - Message: metadata id, timestamp (nanoseconds since epoch), parameter count and per parameter
+ *     a key id and a value ('BinValueKind' byte followed by the raw value data).
+ *
+ * Integers are stored as (LEB128) variable length integers, signed integers are zig-zag encoded.
+ * Fixed size values (floats, doubles and timestamps) are stored in little-endian byte order.
+ */
+
+constexpr std::array<char, 4> g_binMagic = {'T', 'L', 'O', 'G'};
+constexpr uint32_t g_binVersion          = 2U; // Version 2 added 'BinValueKind::Float'.
+constexpr size_t g_binHeaderSize         = g_binMagic.size() + sizeof(uint32_t);
+
+enum class BinRecordKind : uint8_t {
+  MetaData = 1,
+  Key      = 2,
+  Message  = 3,
+};
+
+enum class BinValueKind : uint8_t {
+  Int       = 1,
+  UInt      = 2,
+  Double    = 3,
+  Bool      = 4,
+  Str       = 5,
+  Path      = 6,
+  Duration  = 7,
+  TimePoint = 8,
+  MemSize   = 9,
+  List      = 10,
+  Float     = 11,
+};
+
+inline auto writeBinByte(std::string* str, uint8_t value) noexcept {
+  (*str) += static_cast<char>(value);
+}
+
+inline auto writeBinVarUInt(std::string* str, uint64_t value) noexcept {
+  while (value >= 0x80U) {
+    (*str) += static_cast<char>(value | 0x80U);
+    value >>= 7U;
+  }
+  (*str) += static_cast<char>(value);
+}
+
+inline auto writeBinVarInt(std::string* str, int64_t value) noexcept {
+  // Zig-zag encode so small negative numbers also take up few bytes.
+  const auto zigZag = (static_cast<uint64_t>(value) << 1U) ^ static_cast<uint64_t>(value >> 63);
+  writeBinVarUInt(str, zigZag);
+}
+
+/* Write a trivially copyable value in little-endian byte order.
+ * Note: Assumes a little-endian host.
+ */
+template <typename T>
+inline auto writeBinFixed(std::string* str, T value) noexcept {
+  static_assert(std::is_trivially_copyable_v<T>, "Type has to be trivially copyable");
+  char buffer[sizeof(T)];
+  std::memcpy(buffer, &value, sizeof(T));
+  str->append(buffer, sizeof(T));
+}
+
+inline auto writeBinStr(std::string* str, std::string_view value) noexcept {
+  writeBinVarUInt(str, value.size());
+  str->append(value);
+}
+
+/*
+ * Cursor for reading binary log data.
+ * All read methods return false when there is not enough data remaining, in that case the cursor
+ * should be considered invalid.
+ */
+class BinCursor final {
+public:
+  BinCursor(const uint8_t* cur, const uint8_t* end) noexcept : m_cur{cur}, m_end{end} {}
+
+  [[nodiscard]] auto getCur() const noexcept { return m_cur; }
+  [[nodiscard]] auto getRemaining() const noexcept { return static_cast<size_t>(m_end - m_cur); }
+
+  [[nodiscard]] auto readByte(uint8_t* out) noexcept -> bool {
+    if (m_cur == m_end) {
+      return false;
+    }
+    *out = *m_cur++;
+    return true;
+  }
+
+  [[nodiscard]] auto readVarUInt(uint64_t* out) noexcept -> bool {
+    *out = 0U;
+    for (auto shift = 0U; shift < 64U; shift += 7U) {
+      uint8_t byte;
+      if (!readByte(&byte)) {
+        return false;
+      }
+      *out |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+      if ((byte & 0x80U) == 0U) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  [[nodiscard]] auto readVarInt(int64_t* out) noexcept -> bool {
+    uint64_t zigZag;
+    if (!readVarUInt(&zigZag)) {
+      return false;
+    }
+    *out = static_cast<int64_t>(zigZag >> 1U) ^ -static_cast<int64_t>(zigZag & 1U);
+    return true;
+  }
+
+  template <typename T>
+  [[nodiscard]] auto readFixed(T* out) noexcept -> bool {
+    static_assert(std::is_trivially_copyable_v<T>, "Type has to be trivially copyable");
+    if (getRemaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(out, m_cur, sizeof(T));
+    m_cur += sizeof(T);
+    return true;
+  }
+
+  [[nodiscard]] auto readStr(std::string_view* out) noexcept -> bool {
+    uint64_t size;
+    if (!readVarUInt(&size) || getRemaining() < size) {
+      return false;
+    }
+    *out = std::string_view{reinterpret_cast<const char*>(m_cur), static_cast<size_t>(size)};
+    m_cur += size;
+    return true;
+  }
+
+private:
+  const uint8_t* m_cur;
+  const uint8_t* m_end;
+};
+
+} // namespace tria::log::internal
@@ -1,4 +1,11 @@
 #pragma once
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 /*
  * If the platform's standard library has the <charconv> header this includes it and sets the
@@ -11,3 +18,404 @@
 #define HAS_CHAR_CONV
 
 #endif
+
+namespace tria::log::internal {
+
+/*
+ * Shortest round-trip floating point formatting.
+ * Implementation of the Grisu2 algorithm by Florian Loitsch: "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers" (https://florian.loitsch.com/publications).
+ * Output always parses back to the exact same value, and is the shortest possible representation
+ * in the vast majority of cases (in rare cases a single digit longer).
+ *
+ * Float and double are both supported, floats are formatted with the precision of a float (so
+ * 0.1f is written as '0.1' instead of '0.100000001490116').
+ */
+
+namespace grisu {
+
+/* Floating point number with a 64 bit significand and a binary exponent: 'f * 2^e'.
+ */
+struct DiyFp final {
+  uint64_t f;
+  int e;
+};
+
+[[nodiscard]] constexpr auto sub(DiyFp x, DiyFp y) noexcept -> DiyFp {
+  assert(x.e == y.e && x.f >= y.f);
+  return {x.f - y.f, x.e};
+}
+
+/* Multiply two DiyFps, the result is rounded to 64 bits.
+ */
+[[nodiscard]] constexpr auto mul(DiyFp x, DiyFp y) noexcept -> DiyFp {
+  const auto xLo = x.f & 0xFFFFFFFFU;
+  const auto xHi = x.f >> 32U;
+  const auto yLo = y.f & 0xFFFFFFFFU;
+  const auto yHi = y.f >> 32U;
+
+  const auto p0 = xLo * yLo;
+  const auto p1 = xLo * yHi;
+  const auto p2 = xHi * yLo;
+  const auto p3 = xHi * yHi;
+
+  auto mid = (p0 >> 32U) + (p1 & 0xFFFFFFFFU) + (p2 & 0xFFFFFFFFU);
+  mid += 1U << 31U; // Round.
+  return {p3 + (p1 >> 32U) + (p2 >> 32U) + (mid >> 32U), x.e + y.e + 64};
+}
+
+[[nodiscard]] constexpr auto normalize(DiyFp x) noexcept -> DiyFp {
+  assert(x.f != 0U);
+  while ((x.f >> 63U) == 0U) {
+    x.f <<= 1U;
+    --x.e;
+  }
+  return x;
+}
+
+[[nodiscard]] constexpr auto normalizeTo(DiyFp x, int targetE) noexcept -> DiyFp {
+  assert(x.e >= targetE);
+  return {x.f << static_cast<unsigned>(x.e - targetE), targetE};
+}
+
+/* Normalized value and its (normalized) boundaries, all values between the boundaries round to
+ * the value.
+ */
+struct Boundaries final {
+  DiyFp w;
+  DiyFp minus;
+  DiyFp plus;
+};
+
+template <typename FloatType>
+[[nodiscard]] auto computeBoundaries(FloatType value) noexcept -> Boundaries {
+  static_assert(std::numeric_limits<FloatType>::is_iec559, "Only IEEE floats are supported");
+  using Bits = std::conditional_t<sizeof(FloatType) == 4U, uint32_t, uint64_t>;
+
+  constexpr int precision  = std::numeric_limits<FloatType>::digits; // Including the hidden bit.
+  constexpr int bias       = std::numeric_limits<FloatType>::max_exponent - 1 + (precision - 1);
+  constexpr int minExp     = 1 - bias;
+  constexpr auto hiddenBit = uint64_t{1U} << (precision - 1);
+
+  Bits bits;
+  std::memcpy(&bits, &value, sizeof(Bits));
+  const auto biasedExp = static_cast<int>(bits >> (precision - 1));
+  const auto fraction  = static_cast<uint64_t>(bits) & (hiddenBit - 1U);
+
+  const auto v = biasedExp == 0 ? DiyFp{fraction, minExp} // Denormal.
+                                : DiyFp{fraction + hiddenBit, biasedExp - bias};
+
+  // At a power of two the distance to the next lower value is half the distance to the next higher.
+  const auto lowerIsCloser = fraction == 0U && biasedExp > 1;
+  const auto plus          = DiyFp{2U * v.f + 1U, v.e - 1};
+  const auto minus =
+      lowerIsCloser ? DiyFp{4U * v.f - 1U, v.e - 2} : DiyFp{2U * v.f - 1U, v.e - 1};
+
+  const auto wPlus = normalize(plus);
+  return {normalize(v), normalizeTo(minus, wPlus.e), wPlus};
+}
+
+/* Range of the binary exponent of the scaled values, chosen so the integral part of the scaled
+ * value fits in 32 bits.
+ */
+constexpr int g_alpha = -60;
+constexpr int g_gamma = -32;
+
+struct CachedPower final {
+  uint64_t f;
+  int e;
+  int k;
+};
+
+/* Normalized powers of ten: 'f * 2^e ~= 10^k', for k in the range [-300, 324] with steps of 8.
+ */
+constexpr int g_cachedPowersMinDecExp = -300;
+constexpr int g_cachedPowersDecStep   = 8;
+constexpr std::array<CachedPower, 79> g_cachedPowers = {{
+    {0xAB70FE17C79AC6CA, -1060, -300},
+    {0xFF77B1FCBEBCDC4F, -1034, -292},
+    {0xBE5691EF416BD60C, -1007, -284},
+    {0x8DD01FAD907FFC3C, -980, -276},
+    {0xD3515C2831559A83, -954, -268},
+    {0x9D71AC8FADA6C9B5, -927, -260},
+    {0xEA9C227723EE8BCB, -901, -252},
+    {0xAECC49914078536D, -874, -244},
+    {0x823C12795DB6CE57, -847, -236},
+    {0xC21094364DFB5637, -821, -228},
+    {0x9096EA6F3848984F, -794, -220},
+    {0xD77485CB25823AC7, -768, -212},
+    {0xA086CFCD97BF97F4, -741, -204},
+    {0xEF340A98172AACE5, -715, -196},
+    {0xB23867FB2A35B28E, -688, -188},
+    {0x84C8D4DFD2C63F3B, -661, -180},
+    {0xC5DD44271AD3CDBA, -635, -172},
+    {0x936B9FCEBB25C996, -608, -164},
+    {0xDBAC6C247D62A584, -582, -156},
+    {0xA3AB66580D5FDAF6, -555, -148},
+    {0xF3E2F893DEC3F126, -529, -140},
+    {0xB5B5ADA8AAFF80B8, -502, -132},
+    {0x87625F056C7C4A8B, -475, -124},
+    {0xC9BCFF6034C13053, -449, -116},
+    {0x964E858C91BA2655, -422, -108},
+    {0xDFF9772470297EBD, -396, -100},
+    {0xA6DFBD9FB8E5B88F, -369, -92},
+    {0xF8A95FCF88747D94, -343, -84},
+    {0xB94470938FA89BCF, -316, -76},
+    {0x8A08F0F8BF0F156B, -289, -68},
+    {0xCDB02555653131B6, -263, -60},
+    {0x993FE2C6D07B7FAC, -236, -52},
+    {0xE45C10C42A2B3B06, -210, -44},
+    {0xAA242499697392D3, -183, -36},
+    {0xFD87B5F28300CA0E, -157, -28},
+    {0xBCE5086492111AEB, -130, -20},
+    {0x8CBCCC096F5088CC, -103, -12},
+    {0xD1B71758E219652C, -77, -4},
+    {0x9C40000000000000, -50, 4},
+    {0xE8D4A51000000000, -24, 12},
+    {0xAD78EBC5AC620000, 3, 20},
+    {0x813F3978F8940984, 30, 28},
+    {0xC097CE7BC90715B3, 56, 36},
+    {0x8F7E32CE7BEA5C70, 83, 44},
+    {0xD5D238A4ABE98068, 109, 52},
+    {0x9F4F2726179A2245, 136, 60},
+    {0xED63A231D4C4FB27, 162, 68},
+    {0xB0DE65388CC8ADA8, 189, 76},
+    {0x83C7088E1AAB65DB, 216, 84},
+    {0xC45D1DF942711D9A, 242, 92},
+    {0x924D692CA61BE758, 269, 100},
+    {0xDA01EE641A708DEA, 295, 108},
+    {0xA26DA3999AEF774A, 322, 116},
+    {0xF209787BB47D6B85, 348, 124},
+    {0xB454E4A179DD1877, 375, 132},
+    {0x865B86925B9BC5C2, 402, 140},
+    {0xC83553C5C8965D3D, 428, 148},
+    {0x952AB45CFA97A0B3, 455, 156},
+    {0xDE469FBD99A05FE3, 481, 164},
+    {0xA59BC234DB398C25, 508, 172},
+    {0xF6C69A72A3989F5C, 534, 180},
+    {0xB7DCBF5354E9BECE, 561, 188},
+    {0x88FCF317F22241E2, 588, 196},
+    {0xCC20CE9BD35C78A5, 614, 204},
+    {0x98165AF37B2153DF, 641, 212},
+    {0xE2A0B5DC971F303A, 667, 220},
+    {0xA8D9D1535CE3B396, 694, 228},
+    {0xFB9B7CD9A4A7443C, 720, 236},
+    {0xBB764C4CA7A44410, 747, 244},
+    {0x8BAB8EEFB6409C1A, 774, 252},
+    {0xD01FEF10A657842C, 800, 260},
+    {0x9B10A4E5E9913129, 827, 268},
+    {0xE7109BFBA19C0C9D, 853, 276},
+    {0xAC2820D9623BF429, 880, 284},
+    {0x80444B5E7AA7CF85, 907, 292},
+    {0xBF21E44003ACDD2D, 933, 300},
+    {0x8E679C2F5E44FF8F, 960, 308},
+    {0xD433179D9C8CB841, 986, 316},
+    {0x9E19DB92B4E31BA9, 1013, 324},
+}};
+
+/* Find a cached power of ten 'c' such that 'g_alpha <= c.e + e + 64 <= g_gamma'.
+ */
+[[nodiscard]] inline auto getCachedPower(int e) noexcept -> CachedPower {
+  // Approximation of 'ceil((g_alpha - e - 1) * log10(2))', 78913 / 2^18 ~= log10(2).
+  const auto f = g_alpha - e - 1;
+  const auto k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+
+  const auto index = static_cast<size_t>(
+      (-g_cachedPowersMinDecExp + k + (g_cachedPowersDecStep - 1)) / g_cachedPowersDecStep);
+  assert(index < g_cachedPowers.size());
+
+  const auto cached = g_cachedPowers[index];
+  assert(g_alpha <= cached.e + e + 64 && cached.e + e + 64 <= g_gamma);
+  return cached;
+}
+
+/* Amount of decimal digits in n, 'pow10' receives '10^(digits - 1)'.
+ */
+[[nodiscard]] constexpr auto findLargestPow10(uint32_t n, uint32_t* pow10) noexcept -> int {
+  auto digits = 1;
+  *pow10      = 1U;
+  while (digits != 10 && n / *pow10 >= 10U) {
+    *pow10 *= 10U;
+    ++digits;
+  }
+  return digits;
+}
+
+/* Move the last digit closer to the exact value, while staying inside the rounding boundaries.
+ */
+inline auto round(
+    char* buffer, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK) noexcept
+    -> void {
+  while (rest < dist && delta - rest >= tenK &&
+         (rest + tenK < dist || dist - rest > rest + tenK - dist)) {
+    --buffer[length - 1];
+    rest += tenK;
+  }
+}
+
+/* Generate the shortest digits for a scaled value in the range [mMinus, mPlus].
+ */
+inline auto digitGen(char* buffer, int* length, int* decExp, DiyFp mMinus, DiyFp w, DiyFp mPlus)
+    -> void {
+  assert(mPlus.e >= g_alpha && mPlus.e <= g_gamma);
+
+  auto delta = sub(mPlus, mMinus).f;
+  auto dist  = sub(mPlus, w).f;
+
+  // Split mPlus into an integral (p1) and a fractional (p2) part.
+  const auto one = DiyFp{uint64_t{1U} << static_cast<unsigned>(-mPlus.e), mPlus.e};
+  auto p1        = static_cast<uint32_t>(mPlus.f >> static_cast<unsigned>(-one.e));
+  auto p2        = mPlus.f & (one.f - 1U);
+
+  // Integral digits.
+  uint32_t pow10;
+  auto n = findLargestPow10(p1, &pow10);
+  while (n > 0) {
+    const auto digit = p1 / pow10;
+    p1 %= pow10;
+    buffer[(*length)++] = static_cast<char>('0' + digit);
+    --n;
+
+    const auto rest = (static_cast<uint64_t>(p1) << static_cast<unsigned>(-one.e)) + p2;
+    if (rest <= delta) {
+      *decExp += n;
+      round(buffer, *length, dist, delta, rest, static_cast<uint64_t>(pow10) << -one.e);
+      return;
+    }
+    pow10 /= 10U;
+  }
+
+  // Fractional digits.
+  auto m = 0;
+  while (true) {
+    p2 *= 10U;
+    const auto digit = p2 >> static_cast<unsigned>(-one.e);
+    p2 &= one.f - 1U;
+    buffer[(*length)++] = static_cast<char>('0' + digit);
+    ++m;
+
+    delta *= 10U;
+    dist *= 10U;
+    if (p2 <= delta) {
+      break;
+    }
+  }
+  *decExp -= m;
+  round(buffer, *length, dist, delta, p2, one.f);
+}
+
+/* Write the shortest digits of a positive finite value, the value is 'digits * 10^decExp'.
+ */
+template <typename FloatType>
+inline auto grisu2(char* buffer, int* length, int* decExp, FloatType value) noexcept -> void {
+  assert(std::isfinite(value) && value > 0);
+  const auto b = computeBoundaries(value);
+
+  const auto cached = getCachedPower(b.plus.e);
+  const auto c      = DiyFp{cached.f, cached.e};
+
+  const auto w      = mul(b.w, c);
+  const auto wMinus = mul(b.minus, c);
+  const auto wPlus  = mul(b.plus, c);
+
+  // Shrink the range by one ulp on both sides to account for the rounding errors of 'mul'.
+  const auto mMinus = DiyFp{wMinus.f + 1U, wMinus.e};
+  const auto mPlus  = DiyFp{wPlus.f - 1U, wPlus.e};
+
+  *length = 0;
+  *decExp = -cached.k;
+  digitGen(buffer, length, decExp, mMinus, w, mPlus);
+}
+
+/* Write the exponent of the scientific notation: 'e+XX' or 'e-XX' (atleast two digits).
+ */
+inline auto writeExponent(char* out, int e) noexcept -> char* {
+  *out++ = 'e';
+  *out++ = e < 0 ? '-' : '+';
+  auto absE = static_cast<uint32_t>(e < 0 ? -e : e);
+  if (absE >= 100U) {
+    *out++ = static_cast<char>('0' + absE / 100U);
+    absE %= 100U;
+  }
+  *out++ = static_cast<char>('0' + absE / 10U);
+  *out++ = static_cast<char>('0' + absE % 10U);
+  return out;
+}
+
+/* Format the digits (that are 'digits * 10^decExp') in fixed notation for reasonably sized
+ * values and in scientific notation otherwise.
+ * Note: Buffer contains the digits on entry and needs room for 'g_maxFloatChars' characters.
+ */
+inline auto formatDigits(char* buffer, int length, int decExp) noexcept -> char* {
+  constexpr auto minFixedExp = -4; // Fixed notation for values >= 1e-4.
+  constexpr auto maxFixedExp = 17; // Fixed notation for values < 1e17.
+
+  // Position of the decimal point relative to the start of the digits.
+  const auto n = length + decExp;
+
+  if (length <= n && n <= maxFixedExp) {
+    // Integer: digits followed by zeros: '1234000'.
+    std::memset(buffer + length, '0', static_cast<size_t>(n - length));
+    return buffer + n;
+  }
+  if (0 < n && n <= maxFixedExp) {
+    // Decimal point inside the digits: '12.34'.
+    std::memmove(buffer + n + 1, buffer + n, static_cast<size_t>(length - n));
+    buffer[n] = '.';
+    return buffer + length + 1;
+  }
+  if (minFixedExp < n && n <= 0) {
+    // Leading zeros: '0.001234'.
+    const auto zeros = static_cast<size_t>(-n);
+    std::memmove(buffer + 2 + zeros, buffer, static_cast<size_t>(length));
+    buffer[0] = '0';
+    buffer[1] = '.';
+    std::memset(buffer + 2, '0', zeros);
+    return buffer + 2 + zeros + length;
+  }
+
+  // Scientific notation: '1.234e+56'.
+  if (length == 1) {
+    return writeExponent(buffer + 1, n - 1);
+  }
+  std::memmove(buffer + 2, buffer + 1, static_cast<size_t>(length - 1));
+  buffer[1] = '.';
+  return writeExponent(buffer + length + 1, n - 1);
+}
+
+} // namespace grisu
+
+/* Maximum amount of characters 'writeShortest' writes, for example: '-1.2345678901234567e-308'.
+ */
+constexpr size_t g_maxFloatChars = 32U;
+
+/* Write the shortest representation of the value that parses back to the exact same value.
+ * Non-finite values are written as 'nan', 'inf' and '-inf'.
+ * Returns a pointer past the last written character, 'out' needs room for 'g_maxFloatChars'.
+ */
+template <typename FloatType>
+inline auto writeShortest(char* out, FloatType value) noexcept -> char* {
+  static_assert(std::is_floating_point_v<FloatType>, "Only floating point types are supported");
+  if (std::isnan(value)) {
+    std::memcpy(out, "nan", 3U);
+    return out + 3;
+  }
+  if (std::signbit(value)) {
+    *out++ = '-';
+    value  = -value;
+  }
+  if (std::isinf(value)) {
+    std::memcpy(out, "inf", 3U);
+    return out + 3;
+  }
+  if (value == 0) {
+    *out = '0';
+    return out + 1;
+  }
+  int length;
+  int decExp;
+  grisu::grisu2(out, &length, &decExp, value);
+  return grisu::formatDigits(out, length, decExp);
+}
+
+} // namespace tria::log::internal
@@ -0,0 +1,250 @@
+#include "file_rotator.hpp"
+#include "file_sink.hpp"
+#include "tria/pal/utils.hpp"
+#include <cassert>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace tria::log::internal {
+
+namespace {
+
+// Time to wait before retrying after rotating failed, avoids retrying on every write.
+constexpr static auto g_retryDelay = std::chrono::seconds{1};
+
+} // namespace
+
+FileRotator::FileRotator(fs::path path, bool binary, RotationPolicy policy, std::FILE* file) :
+    m_path{std::move(path)},
+    m_binary{binary},
+    m_policy{policy},
+    m_fileOpenTime{std::chrono::steady_clock::now()},
+    m_retryTime{},
+    m_nextFile{nullptr},
+    m_busy{false},
+    m_shutdown{false} {
+  m_thread = std::thread(&FileRotator::workLoop, this);
+
+  // Preallocate the initial file and prepare the next one.
+#if defined(_WIN32)
+  pushJob({nullptr, file, false, false});
+#else
+  pushJob({nullptr, file, false, true});
+#endif
+}
+
+FileRotator::~FileRotator() {
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_shutdown = true;
+  }
+  m_jobCondVar.notify_one();
+  m_thread.join();
+
+  // Remove the prepared file that was never used.
+  if (m_nextFile) {
+    std::fclose(m_nextFile);
+    auto err = std::error_code{};
+    fs::remove(getNextPath(), err);
+  }
+}
+
+auto FileRotator::getRotatedPath(uint32_t index) const -> fs::path {
+  auto result = m_path;
+  result += "." + std::to_string(index);
+  return result;
+}
+
+auto FileRotator::getStagingPath() const -> fs::path {
+  auto result = m_path;
+  result += ".rotating";
+  return result;
+}
+
+auto FileRotator::getNextPath() const -> fs::path {
+  auto result = m_path;
+  result += ".next";
+  return result;
+}
+
+auto FileRotator::shouldRotate(uint64_t fileSize) const noexcept -> bool {
+  const auto sizeExceeded = m_policy.maxSize != 0U && fileSize >= m_policy.maxSize;
+  if (!sizeExceeded && m_policy.maxAge.count() == 0) {
+    return false;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (now < m_retryTime) {
+    return false; // Backing off after a failed rotation.
+  }
+  return sizeExceeded || now - m_fileOpenTime >= m_policy.maxAge;
+}
+
+auto FileRotator::rotate(std::FILE* file) noexcept -> std::FILE* {
+#if defined(_WIN32)
+  // Open files cannot be renamed on windows, so the old file is closed and a new file is opened on
+  // the log thread. The previous background work has to be finished as it moves the previous file
+  // out of the staging path, normally it finished long before the next rotation.
+  waitIdle();
+
+  // Note: Is null if a previous rotation failed to reopen the file.
+  if (file) {
+    std::fclose(file);
+    file = nullptr;
+  }
+  auto err = std::error_code{};
+  fs::rename(m_path, getStagingPath(), err);
+
+  std::FILE* newFile = nullptr;
+  try {
+    // Continue appending to the old file if renaming it failed.
+    newFile = openLogFile(m_path, m_binary, static_cast<bool>(err));
+  } catch (...) {
+    newFile = nullptr;
+  }
+  if (!newFile) {
+    // Note: The sink stops writing until a rotation succeeds.
+    m_retryTime = std::chrono::steady_clock::now() + g_retryDelay;
+    return nullptr;
+  }
+  m_fileOpenTime = std::chrono::steady_clock::now();
+  pushJob({nullptr, newFile, !err, false});
+  return newFile;
+#else
+  // Take the file that the background thread prepared, it is only missing when rotating faster
+  // than the background work can keep up with (or when preparing the file failed).
+  auto* newFile = takeNextFile();
+  if (!newFile) {
+    waitIdle();
+    newFile = takeNextFile();
+  }
+  if (!newFile) {
+    m_retryTime = std::chrono::steady_clock::now() + g_retryDelay;
+    pushJob({nullptr, nullptr, false, true}); // Try preparing the next file again.
+    return file;
+  }
+
+  // Move the old file out of the way and the prepared file in its place, the prepared file is only
+  // made available after the previous file was moved out of the staging path.
+  auto err = std::error_code{};
+  fs::rename(m_path, getStagingPath(), err);
+  if (!err) {
+    fs::rename(getNextPath(), m_path, err);
+    if (err) {
+      // Move the old file back so the next rotation (and the readers) find it at the active path.
+      auto restoreErr = std::error_code{};
+      fs::rename(getStagingPath(), m_path, restoreErr);
+    }
+  }
+  if (err) {
+    m_retryTime = std::chrono::steady_clock::now() + g_retryDelay;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_nextFile = newFile; // Keep the prepared file for the next attempt.
+    return file;          // Keep writing to the old file.
+  }
+
+  // Closing the old file, moving it to 'path.1' and preparing the next file happen in the
+  // background.
+  m_fileOpenTime = std::chrono::steady_clock::now();
+  pushJob({file, nullptr, true, true});
+  return newFile;
+#endif
+}
+
+auto FileRotator::pushJob(Job job) noexcept -> void {
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_jobs.push_back(job);
+    m_busy = true;
+  }
+  m_jobCondVar.notify_one();
+}
+
+auto FileRotator::waitIdle() noexcept -> void {
+  std::unique_lock<std::mutex> lk(m_mutex);
+  m_idleCondVar.wait(lk, [this]() { return !m_busy; });
+}
+
+auto FileRotator::workLoop() noexcept -> void {
+  pal::setThreadName("tria_log_rotate");
+
+  while (true) {
+    auto job = Job{};
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_jobCondVar.wait(lk, [this]() { return !m_jobs.empty() || m_shutdown; });
+      if (m_jobs.empty()) {
+        return; // Only stop when all jobs have been processed.
+      }
+      job = m_jobs.front();
+      m_jobs.pop_front();
+    }
+
+    processJob(job);
+
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_busy = !m_jobs.empty();
+    }
+    m_idleCondVar.notify_all();
+  }
+}
+
+auto FileRotator::processJob(const Job& job) noexcept -> void {
+  if (job.oldFile) {
+    // Release the unused preallocated space, then close (and thus flush) the old file.
+    if (m_policy.preallocateSize != 0U) {
+      pal::trimFile(job.oldFile);
+    }
+    std::fclose(job.oldFile);
+  }
+  if (job.newFile && m_policy.preallocateSize != 0U) {
+    // Safe to do while the log thread is writing, it only touches the file on the os level.
+    pal::preallocateFile(job.newFile, m_policy.preallocateSize);
+  }
+  if (job.rotated) {
+    shiftRotatedFiles();
+  }
+  if (job.prepareNext) {
+    prepareNextFile();
+  }
+}
+
+auto FileRotator::prepareNextFile() noexcept -> void {
+  std::FILE* file = nullptr;
+  try {
+    file = openLogFile(getNextPath(), m_binary);
+  } catch (...) {
+    return; // Retried by the next rotation.
+  }
+  if (m_policy.preallocateSize != 0U) {
+    pal::preallocateFile(file, m_policy.preallocateSize);
+  }
+  std::lock_guard<std::mutex> lk(m_mutex);
+  assert(!m_nextFile);
+  m_nextFile = file;
+}
+
+auto FileRotator::takeNextFile() noexcept -> std::FILE* {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return std::exchange(m_nextFile, nullptr);
+}
+
+auto FileRotator::shiftRotatedFiles() noexcept -> void {
+  auto err = std::error_code{};
+  if (m_policy.maxFiles == 0U) {
+    fs::remove(getStagingPath(), err);
+    return;
+  }
+  // Delete the files beyond the retention and shift the others up to make room for the new file.
+  fs::remove(getRotatedPath(m_policy.maxFiles), err);
+  for (auto index = m_policy.maxFiles - 1U; index != 0U; --index) {
+    const auto path = getRotatedPath(index);
+    if (fs::exists(path, err)) {
+      fs::rename(path, getRotatedPath(index + 1U), err);
+    }
+  }
+  fs::rename(getStagingPath(), getRotatedPath(1U), err);
+}
+
+} // namespace tria::log::internal
@@ -0,0 +1,93 @@
+#pragma once
+#include "tria/fs.hpp"
+#include "tria/log/sink.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace tria::log::internal {
+
+/*
+ * Rotates the file of a file sink according to a 'RotationPolicy'.
+ * A background thread prepares (opens and preallocates) the next file at 'path.next' in advance,
+ * 'rotate()' is called from the log thread and only renames the active file (to a staging path)
+ * and the prepared file (to the active path). The remaining work (closing the old file, shifting /
+ * deleting the previously rotated files, moving the old file to 'path.1' and preparing the next
+ * file) is performed on the background thread.
+ * On windows open files cannot be renamed, there the log thread closes the old file and opens the
+ * new file itself.
+ * Note: Not thread-safe, meant to be owned by a single sink.
+ */
+class FileRotator final {
+public:
+  FileRotator(fs::path path, bool binary, RotationPolicy policy, std::FILE* file);
+  FileRotator(const FileRotator& rhs) = delete;
+  FileRotator(FileRotator&& rhs)      = delete;
+  ~FileRotator();
+
+  auto operator=(const FileRotator& rhs) -> FileRotator& = delete;
+  auto operator=(FileRotator&& rhs) -> FileRotator& = delete;
+
+  [[nodiscard]] auto getPolicy() const noexcept -> const RotationPolicy& { return m_policy; }
+
+  /* Path of a rotated file, 1 being the most recent.
+   */
+  [[nodiscard]] auto getRotatedPath(uint32_t index) const -> fs::path;
+
+  /* Path the old file is moved to by the log thread, before it is moved to 'path.1'.
+   */
+  [[nodiscard]] auto getStagingPath() const -> fs::path;
+
+  /* Path of the file that is prepared to become the active file on the next rotation.
+   */
+  [[nodiscard]] auto getNextPath() const -> fs::path;
+
+  /* Check if the active file should be rotated, 'fileSize' is the amount of bytes written to it.
+   */
+  [[nodiscard]] auto shouldRotate(uint64_t fileSize) const noexcept -> bool;
+
+  /* Switch to a new file, returns the new file or (if rotating failed) the old file.
+   * Ownership of the given file is transferred to the rotator.
+   * After a failure 'shouldRotate()' returns false for a while, before rotating is retried.
+   * Note: Can return null if reopening the file failed on windows.
+   */
+  [[nodiscard]] auto rotate(std::FILE* file) noexcept -> std::FILE*;
+
+private:
+  /* Background work after switching files.
+   */
+  struct Job final {
+    std::FILE* oldFile; // File to close, null if none.
+    std::FILE* newFile; // File to preallocate, null if none.
+    bool rotated;       // Was the old file moved to the staging path.
+    bool prepareNext;   // Prepare the file for the next rotation.
+  };
+
+  fs::path m_path;
+  bool m_binary;
+  RotationPolicy m_policy;
+  std::chrono::steady_clock::time_point m_fileOpenTime;
+  std::chrono::steady_clock::time_point m_retryTime; // No rotation before this (after a failure).
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::FILE* m_nextFile; // Prepared file at the next path, null if not (yet) available.
+  std::condition_variable m_jobCondVar;
+  std::condition_variable m_idleCondVar;
+  std::deque<Job> m_jobs;
+  bool m_busy;
+  bool m_shutdown;
+
+  auto pushJob(Job job) noexcept -> void;
+  auto waitIdle() noexcept -> void;
+  auto workLoop() noexcept -> void;
+  auto processJob(const Job& job) noexcept -> void;
+  auto shiftRotatedFiles() noexcept -> void;
+  auto prepareNextFile() noexcept -> void;
+  [[nodiscard]] auto takeNextFile() noexcept -> std::FILE*;
+};
+
+} // namespace tria::log::internal
@@ -1,13 +1,43 @@
 #pragma once
+#include "file_rotator.hpp"
+#include "lz_stream.hpp"
 #include "tria/fs.hpp"
 #include "tria/log/err/log_file_err.hpp"
+#include "tria/log/metadata.hpp"
 #include "tria/log/sink.hpp"
+#include "tria/pal/utils.hpp"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 namespace tria::log::internal {
 
+/*
+ * Base class for sinks that write formatted messages to a file.
+ * Messages of a batch are formatted into a single buffer that is written with a single call, when
+ * the data is flushed to the operating system is controlled by the 'FlushPolicy'.
+ * Optionally rotates the file (see 'RotationPolicy'), rotation happens in between batches.
+ * Optionally compresses the file (see 'Compression'), every batch is compressed as a block.
+ * Files are started (header written) lazily before the first batch, this way compression and
+ * rotation can be enabled after construction.
+ */
 class FileSink : public Sink {
 public:
   ~FileSink() override {
+    // Finish the background rotation work first, it can still reference the active file.
+    // Note: Unstarted files stay empty, sinks that always need a header start the file themselves.
+    const auto trim = m_rotator && m_rotator->getPolicy().preallocateSize != 0U;
+    m_rotator.reset();
+    if (!m_fileHandle) {
+      return;
+    }
+    if (trim) {
+      pal::trimFile(m_fileHandle);
+    }
+
     // Flush all data to the underlying storage.
     std::fflush(m_fileHandle);
 
@@ -16,44 +46,220 @@ public:
     }
   }
 
-  auto write(const Message& msg) noexcept -> void override = 0;
+  auto write(const Message& msg) noexcept -> void final { writeBatch(&msg, &msg + 1); }
+
+  auto writeBatch(const Message* begin, const Message* end) noexcept -> void final {
+    if (m_rotator && m_rotator->shouldRotate(m_fileSize)) {
+      rotate();
+    }
+    startFile();
+
+    auto containsError = false;
+    for (auto* itr = begin; itr != end; ++itr) {
+      const auto lvl = itr->getMeta()->getLevel();
+      if (isInMask(getMask(), lvl)) {
+        format(*itr, &m_buffer);
+        containsError |= lvl == Level::Error;
+      }
+    }
+    if (m_buffer.empty()) {
+      return;
+    }
+    writeData(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+
+    if (m_fileHandle && shouldFlush(containsError)) {
+      flush();
+    }
+  }
+
+  auto idle(std::chrono::steady_clock::time_point now) noexcept
+      -> std::chrono::steady_clock::time_point final {
+    if (!m_flushPending || !m_fileHandle) {
+      return std::chrono::steady_clock::time_point::max();
+    }
+    const auto flushTime = m_lastFlush + m_flushPolicy.interval;
+    if (now < flushTime) {
+      return flushTime;
+    }
+    flush();
+    return std::chrono::steady_clock::time_point::max();
+  }
+
+  /* Rotate the file according to the given policy.
+   * Note: Has to be called before any message is written.
+   */
+  auto enableRotation(fs::path path, bool binary, RotationPolicy policy) -> void {
+    assert(!m_rotator);
+    m_rotator = std::make_unique<FileRotator>(std::move(path), binary, policy, m_fileHandle);
+  }
+
+  /* Compress the written data (see 'lz_stream.hpp').
+   * Note: Has to be called before any message is written.
+   */
+  auto enableCompression() -> void {
+    assert(!m_compressor && !m_fileStarted);
+    m_compressor = std::make_unique<LzStreamWriter>();
+  }
 
 protected:
-  FileSink(std::FILE* fileHandle, bool closeFile, LevelMask mask) :
-      Sink{mask}, m_fileHandle{fileHandle}, m_closeFile{closeFile} {
+  FileSink(std::FILE* fileHandle, bool closeFile, LevelMask mask, FlushPolicy flushPolicy) :
+      Sink{mask},
+      m_fileHandle{fileHandle},
+      m_closeFile{closeFile},
+      m_flushPolicy{flushPolicy},
+      m_lastFlush{std::chrono::steady_clock::now()},
+      m_flushPending{false},
+      m_fileSize{0U},
+      m_fileStarted{false} {
     if (!m_fileHandle) {
       throw std::invalid_argument{"Null file handle is not supported"};
     }
+    constexpr auto startingBufferSize = 1024;
+    m_buffer.reserve(startingBufferSize);
   }
 
-  auto writeToFile(const char* data, size_t size) noexcept {
-    assert(data);
-    std::fwrite(data, size, 1, m_fileHandle);
+  /* Format the given message into the output string.
+   */
+  virtual auto format(const Message& msg, std::string* out) noexcept -> void = 0;
+
+  /* Called when a new file is started (initially and after rotating), can be used to write a file
+   * header and to reset state that refers to data written to the previous file.
+   */
+  virtual auto beginFile(std::string* /*unused*/) noexcept -> void {}
+
+  /* Start the file if it has not been started yet (no batch has been written to it).
+   */
+  auto startFile() noexcept -> void {
+    if (m_fileStarted) {
+      return;
+    }
+    m_fileStarted = true;
+    if (m_compressor) {
+      m_compressor->begin(&m_compressBuffer);
+      writeToFile(m_compressBuffer.data(), m_compressBuffer.size());
+      m_compressBuffer.clear();
+    }
+    // Note: Uses the message buffer, which is empty in between batches.
+    beginFile(&m_buffer);
+    if (!m_buffer.empty()) {
+      writeData(m_buffer.data(), m_buffer.size());
+      m_buffer.clear();
+    }
   }
 
 private:
   std::FILE* m_fileHandle;
   bool m_closeFile;
+  FlushPolicy m_flushPolicy;
+  std::chrono::steady_clock::time_point m_lastFlush;
+  bool m_flushPending; // Data was held back by the interval flush policy.
+  uint64_t m_fileSize; // Bytes written to the current file.
+  bool m_fileStarted;
+  std::unique_ptr<FileRotator> m_rotator;
+  std::unique_ptr<LzStreamWriter> m_compressor;
+  std::string m_buffer;
+  std::string m_compressBuffer;
+
+  auto rotate() noexcept -> void {
+    auto* newFile = m_rotator->rotate(m_fileHandle);
+    if (newFile == m_fileHandle) {
+      return; // Rotating failed, keep appending to the current file.
+    }
+    m_fileHandle  = newFile;
+    m_fileSize    = 0U;
+    m_fileStarted = false;
+  }
+
+  /* Write (compressed if enabled) data to the file.
+   */
+  auto writeData(const char* data, size_t size) noexcept -> void {
+    if (!m_compressor) {
+      writeToFile(data, size);
+      return;
+    }
+    m_compressor->writeBlocks(data, size, &m_compressBuffer);
+    writeToFile(m_compressBuffer.data(), m_compressBuffer.size());
+    m_compressBuffer.clear();
+  }
+
+  auto writeToFile(const char* data, size_t size) noexcept -> void {
+    assert(data);
+    if (m_fileHandle) {
+      std::fwrite(data, size, 1, m_fileHandle);
+      m_fileSize += size;
+    }
+  }
+
+  auto flush() noexcept -> void {
+    std::fflush(m_fileHandle);
+    m_lastFlush    = std::chrono::steady_clock::now();
+    m_flushPending = false;
+  }
+
+  [[nodiscard]] auto shouldFlush(bool containsError) noexcept -> bool {
+    switch (m_flushPolicy.kind) {
+    case FlushPolicy::Kind::Batch:
+      return true;
+    case FlushPolicy::Kind::Interval:
+      // Data that is held back is flushed from 'idle()' once the interval has elapsed.
+      m_flushPending = std::chrono::steady_clock::now() - m_lastFlush < m_flushPolicy.interval;
+      return !m_flushPending;
+    case FlushPolicy::Kind::Error:
+      return containsError;
+    }
+    return true;
+  }
 };
 
 template <typename T, typename... Args>
 [[nodiscard]] auto makeConsoleSink(LevelMask mask, Args&&... args) -> SinkUnique {
-  return std::make_unique<T>(stdout, false, mask, std::forward<Args>(args)...);
+  return std::make_unique<T>(stdout, false, mask, flushPerBatch(), std::forward<Args>(args)...);
 }
 
-template <typename T, typename... Args>
-[[nodiscard]] auto makeFileSink(fs::path path, LevelMask mask, Args&&... args) -> SinkUnique {
+/* Open a file for writing, throws a 'LogFileErr' if the file could not be opened.
+ * Note: Binary files are written as-is, text files may get platform specific newline conversions.
+ */
+[[nodiscard]] inline auto openLogFile(const fs::path& path, bool binary, bool append = false)
+    -> std::FILE* {
 #if defined(_WIN32)
-  auto* file = _wfopen(path.c_str(), L"w");
+  const auto* mode = append ? (binary ? L"ab" : L"a") : (binary ? L"wb" : L"w");
+  auto* file       = _wfopen(path.c_str(), mode);
 #else
-  auto* file = std::fopen(path.c_str(), "w");
+  const auto* mode = append ? (binary ? "ab" : "a") : (binary ? "wb" : "w");
+  auto* file       = std::fopen(path.c_str(), mode);
 #endif
 
   if (!file) {
     const auto errCode = std::make_error_code(static_cast<std::errc>(errno));
     throw err::LogFileErr(path, errCode.message());
   }
-  return std::make_unique<T>(file, true, mask, std::forward<Args>(args)...);
+  return file;
+}
+
+/* Create a file sink, 'binary' indicates that the sink writes binary data.
+ * Note: Compressed files are always written as binary files.
+ */
+template <typename T, typename... Args>
+[[nodiscard]] auto makeFileSink(
+    fs::path path,
+    bool binary,
+    LevelMask mask,
+    FlushPolicy flushPolicy,
+    RotationPolicy rotationPolicy,
+    Compression compression,
+    Args&&... args) -> SinkUnique {
+  const auto binaryFile = binary || compression != Compression::None;
+
+  auto* file = openLogFile(path, binaryFile);
+  auto sink  = std::make_unique<T>(file, true, mask, flushPolicy, std::forward<Args>(args)...);
+  if (compression == Compression::Lz) {
+    sink->enableCompression();
+  }
+  if (rotationPolicy.isEnabled()) {
+    sink->enableRotation(std::move(path), binaryFile, rotationPolicy);
+  }
+  return sink;
 }
 
 } // namespace tria::log::internal
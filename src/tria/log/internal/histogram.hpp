@@ -0,0 +1,81 @@
+#pragma once
+#include "tria/log/logger.hpp"
+#include "tria/math/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace tria::log::internal {
+
+/*
+ * Histogram that can be snapshotted while it is being recorded to.
+ * Supports only a single recording thread, that way recording is a handful of relaxed loads and
+ * stores (no read-modify-write operations). A snapshot can be slightly inconsistent (for example
+ * the count already being updated but the sum not yet), which is fine for statistics.
+ */
+class AtomicHistogram final {
+public:
+  AtomicHistogram() noexcept : m_buckets{}, m_count{0U}, m_sum{0U}, m_max{0U} {}
+  AtomicHistogram(const AtomicHistogram& rhs) = delete;
+  AtomicHistogram(AtomicHistogram&& rhs)      = delete;
+
+  auto operator=(const AtomicHistogram& rhs) -> AtomicHistogram& = delete;
+  auto operator=(AtomicHistogram&& rhs) -> AtomicHistogram& = delete;
+
+  /* Record a value.
+   * Note: Not thread-safe, should only be called from a single thread.
+   */
+  auto record(uint64_t value) noexcept -> void {
+    add(&m_buckets[getBucket(value)], 1U);
+    add(&m_count, 1U);
+    add(&m_sum, value);
+    if (value > m_max.load(std::memory_order_relaxed)) {
+      m_max.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  /* Record the duration in nanoseconds, negative durations are recorded as zero.
+   */
+  template <typename Rep, typename Period>
+  auto recordDuration(std::chrono::duration<Rep, Period> dur) noexcept -> void {
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(dur).count();
+    record(nanos > 0 ? static_cast<uint64_t>(nanos) : 0U);
+  }
+
+  /* Copy of the current state.
+   * Is thread-safe.
+   */
+  [[nodiscard]] auto getSnapshot() const noexcept -> LoggerHistogram {
+    auto result = LoggerHistogram{};
+    for (auto i = 0U; i != m_buckets.size(); ++i) {
+      result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    result.count = m_count.load(std::memory_order_relaxed);
+    result.sum   = m_sum.load(std::memory_order_relaxed);
+    result.max   = m_max.load(std::memory_order_relaxed);
+    return result;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, LoggerHistogram::s_bucketCount> m_buckets;
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_sum;
+  std::atomic<uint64_t> m_max;
+
+  static auto add(std::atomic<uint64_t>* counter, uint64_t amount) noexcept -> void {
+    // Single writer, so no need for an (expensive) atomic read-modify-write.
+    counter->store(counter->load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] static auto getBucket(uint64_t value) noexcept -> size_t {
+    // Index of the highest set bit plus one, zero for a value of zero.
+    const auto high = static_cast<uint32_t>(value >> 32U);
+    const auto bits = high ? 64U - math::countLeadingZeroes(high)
+                           : 32U - math::countLeadingZeroes(static_cast<uint32_t>(value));
+    return std::min<size_t>(bits, LoggerHistogram::s_bucketCount - 1U);
+  }
+};
+
+} // namespace tria::log::internal
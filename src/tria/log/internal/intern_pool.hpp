@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace tria::log::internal {
+
+/*
+ * Thread-safe pool of interned strings.
+ * Interned strings are never freed, so they can be referenced for as long as the pool lives.
+ * Split into shards (by hash) to reduce contention, looking up an already interned string only
+ * takes a shared lock on a single shard.
+ * Bounded by 'maxBytes', when the pool is full 'intern' fails and the caller has to store a copy.
+ */
+class InternPool final {
+public:
+  explicit InternPool(size_t maxBytes) noexcept : m_size{0U}, m_maxBytes{maxBytes} {}
+  InternPool(const InternPool& rhs) = delete;
+  InternPool(InternPool&& rhs)      = delete;
+
+  auto operator=(const InternPool& rhs) -> InternPool& = delete;
+  auto operator=(InternPool&& rhs) -> InternPool& = delete;
+
+  /* Amount of bytes that are interned.
+   */
+  [[nodiscard]] auto getSize() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+  /* Get the interned copy of the string, interning it if it is not in the pool yet.
+   * Returns an empty optional if the pool is full.
+   */
+  [[nodiscard]] auto intern(std::string_view str) noexcept -> std::optional<std::string_view> {
+    const auto hash = std::hash<std::string_view>{}(str);
+    auto& shard     = m_shards[hash % s_shardCount];
+    {
+      std::shared_lock<std::shared_mutex> lk(shard.mutex);
+      const auto itr = shard.entries.find(str);
+      if (itr != shard.entries.end()) {
+        return *itr;
+      }
+    }
+    if (m_size.load(std::memory_order_relaxed) + str.size() > m_maxBytes) {
+      return std::nullopt;
+    }
+    std::lock_guard<std::shared_mutex> lk(shard.mutex);
+    const auto itr = shard.entries.find(str);
+    if (itr != shard.entries.end()) {
+      return *itr; // Interned by another thread in the mean time.
+    }
+    // Note: Deque does not move its elements when growing, so the views into them stay valid.
+    const auto& stored = shard.storage.emplace_back(str);
+    m_size.fetch_add(stored.size(), std::memory_order_relaxed);
+    return *shard.entries.insert(std::string_view{stored}).first;
+  }
+
+private:
+  constexpr static size_t s_shardCount = 16U;
+
+  struct Shard final {
+    std::shared_mutex mutex;
+    std::unordered_set<std::string_view> entries;
+    std::deque<std::string> storage;
+  };
+
+  std::array<Shard, s_shardCount> m_shards;
+  std::atomic<size_t> m_size;
+  size_t m_maxBytes;
+};
+
+} // namespace tria::log::internal
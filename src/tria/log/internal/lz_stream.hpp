@@ -0,0 +1,124 @@
+#pragma once
+#include "bin_format.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include "tria/math/lz.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace tria::log::internal {
+
+/*
+ * Compressed log format, used by file sinks with 'Compression::Lz'.
+ *
+ * Layout:
+ * - Header: magic ('TLZS') followed by a 32 bit format version.
+ * - Blocks: 32 bit compressed size, 32 bit raw size and the compressed data (see
+ *   'tria/math/lz.hpp'). Every batch of messages is written as a block, blocks reference the data
+ *   of the previous blocks so they have to be decompressed in order.
+ *
+ * Sizes are stored in little-endian byte order.
+ */
+
+constexpr std::array<char, 4> g_lzMagic = {'T', 'L', 'Z', 'S'};
+constexpr uint32_t g_lzVersion          = 1U;
+constexpr size_t g_lzHeaderSize         = g_lzMagic.size() + sizeof(uint32_t);
+constexpr size_t g_lzBlockHeaderSize    = sizeof(uint32_t) * 2U;
+constexpr size_t g_lzMaxBlockSize       = 4U * 1024U * 1024U; // Larger batches are split.
+
+/* Check if the data starts with the compressed log magic.
+ */
+[[nodiscard]] inline auto isLzStream(const uint8_t* data, size_t size) noexcept -> bool {
+  return size >= g_lzMagic.size() && std::memcmp(data, g_lzMagic.data(), g_lzMagic.size()) == 0;
+}
+
+class LzStreamWriter final {
+public:
+  /* Start a new stream, resets the compressor and writes the header.
+   */
+  auto begin(std::string* out) noexcept -> void {
+    m_compressor.reset();
+    out->append(g_lzMagic.data(), g_lzMagic.size());
+    writeBinFixed(out, g_lzVersion);
+  }
+
+  /* Compress the data and append it as one or more blocks.
+   */
+  auto writeBlocks(const char* data, size_t size, std::string* out) noexcept -> void {
+    do {
+      const auto blockSize = std::min(size, g_lzMaxBlockSize);
+      const auto offset    = out->size();
+      out->resize(offset + g_lzBlockHeaderSize + math::lzCompressBound(blockSize));
+
+      auto* block               = reinterpret_cast<uint8_t*>(out->data() + offset);
+      const auto compressedSize = m_compressor.compress(
+          reinterpret_cast<const uint8_t*>(data), blockSize, block + g_lzBlockHeaderSize);
+      const auto sizes = std::array<uint32_t, 2>{
+          static_cast<uint32_t>(compressedSize), static_cast<uint32_t>(blockSize)};
+      std::memcpy(block, sizes.data(), g_lzBlockHeaderSize);
+      out->resize(offset + g_lzBlockHeaderSize + compressedSize);
+
+      data += blockSize;
+      size -= blockSize;
+    } while (size != 0U);
+  }
+
+private:
+  math::LzCompressor m_compressor;
+};
+
+class LzStreamReader final {
+public:
+  LzStreamReader() noexcept : m_headerRead{false} {}
+
+  [[nodiscard]] auto isHeaderRead() const noexcept { return m_headerRead; }
+
+  /* Decompress the complete blocks in the data and append the result to the output.
+   * Returns the amount of bytes that were consumed, incomplete blocks are not consumed.
+   * Throws a 'LogDecodeErr' when encountering invalid data.
+   */
+  auto read(const uint8_t* data, size_t size, std::string* out) -> size_t {
+    auto cursor = BinCursor{data, data + size};
+    if (!m_headerRead) {
+      std::array<char, g_lzMagic.size()> magic;
+      uint32_t version;
+      if (!cursor.readFixed(&magic) || !cursor.readFixed(&version)) {
+        return 0U;
+      }
+      if (magic != g_lzMagic) {
+        throw err::LogDecodeErr{"Not a compressed log (magic mismatch)"};
+      }
+      if (version == 0U || version > g_lzVersion) {
+        throw err::LogDecodeErr{"Unsupported compression version: " + std::to_string(version)};
+      }
+      m_headerRead = true;
+    }
+    while (true) {
+      const auto blockStart = cursor;
+      uint32_t compressedSize, rawSize;
+      if (!cursor.readFixed(&compressedSize) || !cursor.readFixed(&rawSize)) {
+        return static_cast<size_t>(blockStart.getCur() - data);
+      }
+      if (rawSize > g_lzMaxBlockSize || compressedSize > math::lzCompressBound(rawSize)) {
+        throw err::LogDecodeErr{"Corrupt compressed block header"};
+      }
+      if (cursor.getRemaining() < compressedSize) {
+        return static_cast<size_t>(blockStart.getCur() - data);
+      }
+      const auto* raw = m_decompressor.decompress(cursor.getCur(), compressedSize, rawSize);
+      if (!raw) {
+        throw err::LogDecodeErr{"Corrupt compressed block"};
+      }
+      out->append(reinterpret_cast<const char*>(raw), rawSize);
+      cursor = BinCursor{cursor.getCur() + compressedSize, data + size};
+    }
+  }
+
+private:
+  math::LzDecompressor m_decompressor;
+  bool m_headerRead;
+};
+
+} // namespace tria::log::internal
@@ -0,0 +1,32 @@
+#pragma once
+#include "tria/log/metadata.hpp"
+#include <unordered_map>
+
+namespace tria::log::internal {
+
+/*
+ * Cache of data derived from the (static) metadata of a log call-site.
+ * Metadata is keyed by address, this is valid because metadata has to outlive the sinks (see
+ * 'MetaData'), so data that only depends on the call-site only has to be computed once.
+ */
+template <typename Entry>
+class MetaCache final {
+public:
+  /* Get the cached entry for the given metadata, the builder is invoked to create the entry on
+   * first use.
+   * Note: Returned reference is stable, unordered_map does not move its elements.
+   */
+  template <typename Builder>
+  [[nodiscard]] auto get(const MetaData* meta, Builder&& builder) -> const Entry& {
+    auto itr = m_entries.find(meta);
+    if (itr == m_entries.end()) {
+      itr = m_entries.emplace(meta, builder(*meta)).first;
+    }
+    return itr->second;
+  }
+
+private:
+  std::unordered_map<const MetaData*, Entry> m_entries;
+};
+
+} // namespace tria::log::internal
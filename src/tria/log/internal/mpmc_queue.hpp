@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tria::log::internal {
+
+/*
+ * Bounded lock-free multi-producer multi-consumer queue.
+ * Based on Dmitry Vyukov's bounded queue: every slot has a sequence number that tells producers
+ * and consumers whose turn it is to access the slot, producers only contend on a single atomic
+ * counter (the tail) and consumers on another (the head).
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * Note: Capacity has to be a power of two.
+ */
+template <typename T>
+class MpmcQueue final {
+  // Align to (the common) cache-line size to avoid false sharing between producers and consumer.
+  constexpr static auto s_cacheLineSize = 64U;
+
+  struct alignas(s_cacheLineSize) Slot final {
+    std::atomic<size_t> seq;
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+    [[nodiscard]] auto getPtr() noexcept { return std::launder(reinterpret_cast<T*>(&storage)); }
+  };
+
+public:
+  explicit MpmcQueue(size_t capacity) :
+      m_slots{std::make_unique<Slot[]>(capacity)}, m_mask{capacity - 1U}, m_head{0}, m_tail{0} {
+    assert(capacity > 1U);
+    assert((capacity & m_mask) == 0U); // Has to be a power of two.
+
+    for (auto i = 0U; i != capacity; ++i) {
+      m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  MpmcQueue(const MpmcQueue& rhs)     = delete;
+  MpmcQueue(MpmcQueue&& rhs) noexcept = delete;
+  ~MpmcQueue() {
+    // Destroy any items that were not consumed.
+    while (tryPop([](T&&) {})) {
+    }
+  }
+
+  auto operator=(const MpmcQueue& rhs) -> MpmcQueue& = delete;
+  auto operator=(MpmcQueue&& rhs) noexcept -> MpmcQueue& = delete;
+
+  [[nodiscard]] auto getCapacity() const noexcept { return m_mask + 1U; }
+
+  /* Attempt to push an item to the queue.
+   * Returns false if the queue is full, in that case the item is left untouched.
+   * Is thread-safe, can be called concurrently from multiple producers.
+   */
+  auto tryPush(T& item) noexcept -> bool {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Type has to be nothrow movable");
+
+    auto pos = m_tail.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot     = m_slots[pos & m_mask];
+      const auto seq = slot.seq.load(std::memory_order_acquire);
+      const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (dif == 0) {
+        // Slot is free, attempt to claim it by advancing the tail.
+        if (m_tail.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+          new (&slot.storage) T(std::move(item));
+          slot.seq.store(pos + 1U, std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // Slot still contains an item from the previous lap: queue is full.
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed); // Another producer claimed the slot.
+      }
+    }
+  }
+
+  /* Attempt to pop an item from the queue, the item is passed (as a rvalue) to the given consumer.
+   * Returns false if the queue is empty.
+   * Is thread-safe, can be called concurrently from multiple consumers.
+   */
+  template <typename Consumer>
+  auto tryPop(Consumer&& consumer) noexcept -> bool {
+    auto pos = m_head.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot     = m_slots[pos & m_mask];
+      const auto seq = slot.seq.load(std::memory_order_acquire);
+      const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1U);
+      if (dif == 0) {
+        // Slot contains an item, attempt to claim it by advancing the head.
+        if (m_head.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+          auto* item = slot.getPtr();
+          consumer(std::move(*item));
+          item->~T();
+
+          // Mark the slot as free for the producers on the next lap.
+          slot.seq.store(pos + m_mask + 1U, std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // Not yet written by a producer: queue is empty.
+      } else {
+        pos = m_head.load(std::memory_order_relaxed); // Another consumer claimed the item.
+      }
+    }
+  }
+
+  /* Check if there are items available for consumers.
+   * Note: Only a snapshot, can be outdated immediately when other threads are pushing or popping.
+   */
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    const auto pos = m_head.load(std::memory_order_relaxed);
+    return m_slots[pos & m_mask].seq.load(std::memory_order_acquire) != pos + 1U;
+  }
+
+  /* Approximate amount of items in the queue.
+   * Note: Only a snapshot, includes items that are in the process of being pushed or popped.
+   */
+  [[nodiscard]] auto getSize() const noexcept -> size_t {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    return tail > head ? std::min(tail - head, getCapacity()) : 0U;
+  }
+
+private:
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_mask;
+  alignas(s_cacheLineSize) std::atomic<size_t> m_head;
+  alignas(s_cacheLineSize) std::atomic<size_t> m_tail;
+};
+
+} // namespace tria::log::internal
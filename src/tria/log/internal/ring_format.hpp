@@ -0,0 +1,98 @@
+#pragma once
+#include "bin_format.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace tria::log::internal {
+
+/*
+ * Shared ring buffer log format.
+ * Memory-mapped file that a single writer process publishes messages into and any amount of
+ * reader processes can follow live, readers decode the records directly from the mapping.
+ *
+ * Layout:
+ * - Header ('RingHeader'): magic ('TRNG'), format versions, region sizes and the atomic positions
+ *   that are used to synchronize with the readers.
+ * - Metadata table ('tableCapacity' bytes): binary log MetaData and Key records (see
+ *   'bin_format.hpp'), append-only so readers that start late can still resolve every id.
+ * - Ring ('ringCapacity' bytes): message records, positions are monotonically increasing byte
+ *   offsets that are wrapped into the ring. Every record starts at an 8 byte aligned position with
+ *   a 'RingRecordHeader' followed by a binary log Message record. Records never wrap, when a
+ *   record does not fit before the end of the ring a padding marker (sequence 0) is written and the
+ *   record starts at the beginning of the ring.
+ *
+ * Synchronization (seqlock style, readers never block the writer):
+ * - The writer appends static records to the table and then publishes 'tableSize'.
+ * - Before writing a record the writer publishes 'writeBegin' (the end of the region it is about
+ *   to overwrite), after writing it publishes 'writeEnd'.
+ * - Readers read records up to 'writeEnd' and afterwards validate that 'writeBegin' did not pass
+ *   the record (minus the ring capacity), otherwise the record was overwritten while reading it.
+ * - 'tail' is the position of the oldest record that is still (fully) in the ring, readers that
+ *   fall behind continue from there.
+ * - Records carry a message sequence number (starting at 1) so readers can detect lost messages,
+ *   messages the writer could not store also consume a sequence number.
+ *
+ * Note: Assumes a little-endian host and lock-free 64 bit atomics (which are address-free, and
+ * thus work across processes).
+ */
+
+constexpr std::array<char, 4> g_ringMagic = {'T', 'R', 'N', 'G'};
+constexpr uint32_t g_ringVersion          = 1U;
+constexpr size_t g_ringAlignment          = 8U;
+
+struct RingHeader final {
+  std::array<char, 4> magic;
+  uint32_t version;
+  uint32_t binVersion; // Version of the binary log records.
+  uint32_t padding;
+  uint64_t tableCapacity;
+  uint64_t ringCapacity;
+  std::atomic<uint64_t> tableSize;
+  std::atomic<uint64_t> writeBegin;
+  std::atomic<uint64_t> writeEnd;
+  std::atomic<uint64_t> tail;
+  std::atomic<uint32_t> closed; // Set when the writer is destroyed.
+};
+
+struct RingRecordHeader final {
+  uint64_t seq;  // Message sequence number, 0 for a padding marker.
+  uint32_t size; // Size of the binary log record that follows.
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "64 bit atomics have to be lock-free");
+static_assert(sizeof(RingHeader) % g_ringAlignment == 0U, "Header has to preserve alignment");
+
+constexpr size_t g_ringRecordHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+[[nodiscard]] constexpr auto ringAlign(uint64_t size) noexcept -> uint64_t {
+  return (size + g_ringAlignment - 1U) & ~static_cast<uint64_t>(g_ringAlignment - 1U);
+}
+
+/* Size that a record with the given payload takes up in the ring.
+ */
+[[nodiscard]] constexpr auto ringRecordSize(uint64_t payloadSize) noexcept -> uint64_t {
+  return ringAlign(g_ringRecordHeaderSize + payloadSize);
+}
+
+/* Read a record header, 'available' is the amount of bytes until the end of the ring.
+ * For padding markers only the sequence is read as they can be located in the last 8 bytes of the
+ * ring, a size of 0 is returned for (invalid) records that do not fit in the available bytes.
+ */
+[[nodiscard]] inline auto readRingRecordHeader(const uint8_t* data, uint64_t available) noexcept
+    -> RingRecordHeader {
+  auto result = RingRecordHeader{};
+  std::memcpy(&result.seq, data, sizeof(uint64_t));
+  if (result.seq != 0U && available >= g_ringRecordHeaderSize) {
+    std::memcpy(&result.size, data + sizeof(uint64_t), sizeof(uint32_t));
+  }
+  return result;
+}
+
+inline auto writeRingRecordHeader(uint8_t* data, RingRecordHeader header) noexcept -> void {
+  std::memcpy(data, &header.seq, sizeof(uint64_t));
+  std::memcpy(data + sizeof(uint64_t), &header.size, sizeof(uint32_t));
+}
+
+} // namespace tria::log::internal
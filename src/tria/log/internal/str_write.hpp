@@ -1,12 +1,15 @@
 #pragma once
+#include "charconv.hpp"
 #include "tria/fs.hpp"
 #include "tria/log/level.hpp"
 #include <array>
 #include <chrono>
 #include <cmath>
-#include <ctime>
+#include <cstdio>
+#include <limits>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 namespace tria::log::internal {
 
@@ -33,20 +36,6 @@ constexpr auto getIntFormatSpecifier() noexcept -> const char* {
   }
 }
 
-template <typename T>
-constexpr auto getSecondsFracFormatSpecifier() noexcept -> const char* {
-  if constexpr (std::is_same_v<T, int>) {
-    return "%06d";
-  } else if constexpr (std::is_same_v<T, long>) {
-    return "%06ld";
-  } else if constexpr (std::is_same_v<T, long long>) {
-    return "%06lld";
-  } else {
-    static_assert(falseValue<T>, "Unsupported type");
-    return nullptr;
-  }
-}
-
 template <typename IntType>
 inline auto writeInt(std::string* str, IntType value) noexcept {
   constexpr auto maxCharSize = 21;
@@ -65,50 +54,155 @@ inline auto writeInt(std::string* str, IntType value) noexcept {
   str->append(std::string_view{buffer.data(), static_cast<std::string_view::size_type>(size)});
 }
 
-inline auto writeDouble(std::string* str, double value, const char* fmtStr = "%.10g") noexcept {
+/* Write the shortest representation that parses back to the same value (see 'writeShortest').
+ */
+template <typename FloatType>
+inline auto writeFloat(std::string* str, FloatType value) noexcept {
+  auto buffer = std::array<char, g_maxFloatChars>{};
+  auto* end   = writeShortest(buffer.data(), value);
+  str->append(buffer.data(), end);
+}
 
-  // Check how many characters we need to represent the double.
-  const auto size = std::snprintf(nullptr, 0, fmtStr, value);
+/* Write a value rounded to a single decimal: '4.2'.
+ */
+inline auto writeOneDecimal(std::string* str, double value) noexcept {
+  if (value < 0.0) {
+    (*str) += '-';
+    value = -value;
+  }
+  const auto tenths = static_cast<uint64_t>(std::round(value * 10.0));
+  writeInt(str, tenths / 10U);
+  (*str) += '.';
+  (*str) += static_cast<char>('0' + tenths % 10U);
+}
 
-  // Allocate a buffer on the stack with that size.
-  auto buffer = static_cast<char*>(alloca(size + 1));
+/* Write a fixed amount of decimal digits (zero padded), two digits at a time using a lookup table.
+ */
+template <size_t Digits>
+inline auto writeDigits(char* out, uint32_t value) noexcept {
+  constexpr static char digitPairs[] = "00010203040506070809"
+                                       "10111213141516171819"
+                                       "20212223242526272829"
+                                       "30313233343536373839"
+                                       "40414243444546474849"
+                                       "50515253545556575859"
+                                       "60616263646566676869"
+                                       "70717273747576777879"
+                                       "80818283848586878889"
+                                       "90919293949596979899";
+  auto* itr = out + Digits;
+  for (auto i = 0U; i != Digits / 2U; ++i) {
+    const auto pair = (value % 100U) * 2U;
+    value /= 100U;
+    *--itr = digitPairs[pair + 1U];
+    *--itr = digitPairs[pair];
+  }
+  if constexpr (Digits % 2U != 0U) {
+    *--itr = static_cast<char>('0' + value % 10U);
+  }
+}
 
-  // Write the characters in the stack buffer.
-  std::snprintf(buffer, size + 1, fmtStr, value);
+/* Write the date and time (up to seconds) of the given amount of seconds since the unix epoch.
+ * Format: 'YYYY-MM-DDTHH:MM:SS', output buffer has to be atleast 19 characters.
+ * Converts days to a civil date using Howard Hinnant's algorithm
+ * (http://howardhinnant.github.io/date_algorithms.html#civil_from_days), unlike 'std::gmtime' this
+ * does not use any shared state and is thread-safe.
+ * Note: Only supports years in the range 0 - 9999.
+ */
+inline auto writeIsoDateTime(char* out, int64_t secsSinceEpoch) noexcept {
+  constexpr int64_t secsPerDay = 24 * 60 * 60;
 
-  // Wrap the buffer into a string_view and call the string_view overload.
-  str->append(std::string_view{buffer, static_cast<std::string_view::size_type>(size)});
+  // Floored division to also support times before the epoch.
+  auto days      = secsSinceEpoch / secsPerDay;
+  auto secsOfDay = secsSinceEpoch % secsPerDay;
+  if (secsOfDay < 0) {
+    secsOfDay += secsPerDay;
+    --days;
+  }
+
+  // Civil from days.
+  days += 719468; // Shift the epoch to 0000-03-01.
+  const auto era   = (days >= 0 ? days : days - 146096) / 146097;
+  const auto doe   = static_cast<uint32_t>(days - era * 146097);                // [0, 146096]
+  const auto yoe   = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U; // [0, 399]
+  const auto doy   = doe - (365U * yoe + yoe / 4U - yoe / 100U);                // [0, 365]
+  const auto mp    = (5U * doy + 2U) / 153U;                                    // [0, 11]
+  const auto day   = doy - (153U * mp + 2U) / 5U + 1U;                          // [1, 31]
+  const auto month = mp < 10U ? mp + 3U : mp - 9U;                              // [1, 12]
+  const auto year  = static_cast<int64_t>(yoe) + era * 400 + (month <= 2U ? 1 : 0);
+
+  writeDigits<4>(out, static_cast<uint32_t>(year));
+  out[4] = '-';
+  writeDigits<2>(out + 5, month);
+  out[7] = '-';
+  writeDigits<2>(out + 8, day);
+  out[10] = 'T';
+  writeDigits<2>(out + 11, static_cast<uint32_t>(secsOfDay / 3600));
+  out[13] = ':';
+  writeDigits<2>(out + 14, static_cast<uint32_t>(secsOfDay / 60 % 60));
+  out[16] = ':';
+  writeDigits<2>(out + 17, static_cast<uint32_t>(secsOfDay % 60));
+}
+
+/* Split a time-point into (floored) seconds since the epoch and the remaining microseconds.
+ */
+inline auto splitIsoTime(std::chrono::system_clock::time_point value) noexcept
+    -> std::pair<int64_t, uint32_t> {
+  using namespace std::chrono;
+  const auto microSecs = duration_cast<microseconds>(value.time_since_epoch()).count();
+  auto secs            = microSecs / 1'000'000;
+  auto remMicroSecs    = microSecs % 1'000'000;
+  if (remMicroSecs < 0) {
+    remMicroSecs += 1'000'000;
+    --secs;
+  }
+  return {secs, static_cast<uint32_t>(remMicroSecs)};
 }
 
+constexpr size_t g_isoTimeSize = 27U; // Size of: '2020-06-30T18:15:49.199029Z'.
+
 /* ISO 8601 in UTC with microseconds (https://en.wikipedia.org/wiki/ISO_8601).
  * Example output: 2020-06-30T18:15:49.199029Z
  */
 inline auto writeIsoTime(std::string* str, std::chrono::system_clock::time_point value) noexcept {
+  const auto [secs, microSecs] = splitIsoTime(value);
 
-  using namespace std::chrono;
-
-  const auto time         = system_clock::to_time_t(value);
-  const auto remMicroSecs = duration_cast<microseconds>(value - system_clock::from_time_t(time));
+  auto buffer = std::array<char, g_isoTimeSize>{};
+  writeIsoDateTime(buffer.data(), secs);
+  buffer[19] = '.';
+  writeDigits<6>(buffer.data() + 20, microSecs);
+  buffer[26] = 'Z'; // Timezone indicator (Z = UTC).
 
-  constexpr auto bufferSize = 28;
-  auto buffer               = std::array<char, bufferSize>{};
-
-  // Write the characters up to seconds into the buffer.
-  std::strftime(buffer.data(), bufferSize, "%Y-%m-%dT%H:%M:%S.", std::gmtime(&time));
+  str->append(buffer.data(), buffer.size());
+}
 
-  // Write the fractions of a seconds into the buffer.
-  std::sprintf(
-      buffer.data() + 20,
-      getSecondsFracFormatSpecifier<decltype(remMicroSecs)::rep>(),
-      remMicroSecs.count());
+/*
+ * ISO 8601 time writer that caches the formatted date and time of the last second.
+ * Log timestamps are mostly increasing, so for most messages only the microseconds have to be
+ * formatted. Output is identical to 'writeIsoTime'.
+ * Note: Not thread-safe, meant to be owned by a single sink.
+ */
+class IsoTimeWriter final {
+public:
+  IsoTimeWriter() noexcept : m_cachedSecs{std::numeric_limits<int64_t>::min()}, m_buffer{} {
+    m_buffer[19] = '.';
+    m_buffer[26] = 'Z'; // Timezone indicator (Z = UTC).
+  }
 
-  buffer[26] = 'Z';  // Timezone indicator (Z = UTC).
-  buffer[27] = '\0'; // Null-terminate.
+  auto write(std::string* str, std::chrono::system_clock::time_point value) noexcept {
+    const auto [secs, microSecs] = splitIsoTime(value);
+    if (secs != m_cachedSecs) {
+      writeIsoDateTime(m_buffer.data(), secs);
+      m_cachedSecs = secs;
+    }
+    writeDigits<6>(m_buffer.data() + 20, microSecs);
+    str->append(m_buffer.data(), m_buffer.size());
+  }
 
-  // Wrap the buffer into a string_view and call the string_view overload.
-  str->append(
-      std::string_view{buffer.data(), static_cast<std::string_view::size_type>(bufferSize - 1)});
-}
+private:
+  int64_t m_cachedSecs;
+  std::array<char, g_isoTimeSize> m_buffer;
+};
 
 inline auto writePrettyDuration(std::string* str, std::chrono::duration<double> dur) noexcept {
   constexpr static std::array<std::string_view, 4> units = {
@@ -118,8 +212,13 @@ inline auto writePrettyDuration(std::string* str, std::chrono::duration<double>
       " ns",
   };
 
+  auto t = dur.count();
+  if (t < 0.0) {
+    // Pick the unit based on the magnitude, the integer path below only supports positive values.
+    (*str) += '-';
+    t = -t;
+  }
   auto unitIdx = 0U;
-  auto t       = dur.count();
   for (; t < 1.0 && unitIdx != units.size() - 1; ++unitIdx) {
     t *= 1000.0;
   }
@@ -127,7 +226,7 @@ inline auto writePrettyDuration(std::string* str, std::chrono::duration<double>
   if (std::abs(t - rounded) < .05) {
     writeInt(str, static_cast<uint64_t>(rounded));
   } else {
-    writeDouble(str, t, "%.1f");
+    writeOneDecimal(str, t);
   }
   str->append(units[unitIdx]);
 }
@@ -150,14 +249,14 @@ inline auto writePrettyMemSize(std::string* str, const size_t size) noexcept {
   if (sizeD - std::floor(sizeD) < .1) {
     writeInt(str, static_cast<uint64_t>(sizeD));
   } else {
-    writeDouble(str, sizeD, "%.1f");
+    writeOneDecimal(str, sizeD);
   }
   str->append(units[unitIdx]);
 }
 
 inline auto writeStrEscaped(std::string* str, std::string_view input) noexcept {
-  for (auto* ptr = input.data();; ++ptr) {
-    switch (*ptr) {
+  for (const auto c : input) {
+    switch (c) {
     case '"':
       str->append("\\\"");
       break;
@@ -180,28 +279,16 @@ inline auto writeStrEscaped(std::string* str, std::string_view input) noexcept {
       str->append("\\f");
       break;
     default:
-      (*str) += *ptr;
+      (*str) += c;
       break;
-    case '\0':
-      return;
     }
   }
 }
 
-template <typename CharType>
-inline auto writePathNormalized(std::string* str, const CharType* path) noexcept {
+inline auto writePathNormalized(std::string* str, std::string_view path) noexcept {
   // TODO(bastian): Do we need to escape any other characters in paths?
-  for (auto* ptr = path;; ++ptr) {
-    switch (*ptr) {
-    case '\\':
-      str->append("/");
-      break;
-    default:
-      (*str) += *ptr;
-      break;
-    case '\0':
-      return;
-    }
+  for (const auto c : path) {
+    (*str) += c == '\\' ? '/' : c;
   }
 }
 
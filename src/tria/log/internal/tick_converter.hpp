@@ -0,0 +1,62 @@
+#pragma once
+#include "tria/log/param.hpp"
+#include "tria/log/ticks.hpp"
+#include <chrono>
+#include <cstdint>
+
+namespace tria::log::internal {
+
+/* Duration to measure the tick frequency over, longer gives a more accurate calibration.
+ */
+constexpr auto g_tickCalibrationDuration = std::chrono::milliseconds{2};
+
+/* Measure the duration of a tick in nanoseconds.
+ * Note: Calibrated once per process (by busy waiting 'g_tickCalibrationDuration').
+ */
+[[nodiscard]] inline auto getNanosPerTick() noexcept -> double {
+  static const auto nanosPerTick = []() {
+    const auto startTime  = std::chrono::steady_clock::now();
+    const auto startTicks = readTicks();
+    auto endTime          = startTime;
+    while (endTime - startTime < g_tickCalibrationDuration) {
+      endTime = std::chrono::steady_clock::now();
+    }
+    const auto endTicks = readTicks();
+    const auto nanos    = std::chrono::duration<double, std::nano>{endTime - startTime};
+    return nanos.count() / static_cast<double>(endTicks - startTicks);
+  }();
+  return nanosPerTick;
+}
+
+/*
+ * Converts raw ticks (see 'readTicks()') to wall-clock time.
+ * Ticks are converted relative to an anchor (a tick and wall-clock pair), re-anchoring regularly
+ * (using 'update()') keeps the error of the frequency calibration small and picks up adjustments
+ * to the wall-clock.
+ */
+class TickConverter final {
+public:
+  TickConverter() noexcept : m_nanosPerTick{getNanosPerTick()} { update(); }
+
+  /* Re-anchor to the current time.
+   */
+  auto update() noexcept -> void {
+    m_anchorTicks = readTicks();
+    m_anchorTime  = std::chrono::system_clock::now();
+  }
+
+  [[nodiscard]] auto toTime(uint64_t ticks) const noexcept -> TimePoint {
+    // Signed difference as the ticks can be from before the anchor.
+    const auto deltaTicks = static_cast<int64_t>(ticks - m_anchorTicks);
+    const auto delta      = std::chrono::duration<double, std::nano>{
+        static_cast<double>(deltaTicks) * m_nanosPerTick};
+    return m_anchorTime + std::chrono::duration_cast<TimePoint::duration>(delta);
+  }
+
+private:
+  double m_nanosPerTick;
+  uint64_t m_anchorTicks;
+  TimePoint m_anchorTime;
+};
+
+} // namespace tria::log::internal
@@ -1,4 +1,5 @@
 #include "internal/file_sink.hpp"
+#include "internal/meta_cache.hpp"
 #include "internal/str_write.hpp"
 #include "tria/log/metadata.hpp"
 
@@ -6,81 +7,96 @@ namespace tria::log {
 
 class JsonSink final : public internal::FileSink {
 public:
-  JsonSink(std::FILE* fileHandle, bool closeFile, LevelMask mask) :
-      FileSink{fileHandle, closeFile, mask} {
-    constexpr auto startingBufferSize = 1024;
-    m_buffer.reserve(startingBufferSize);
-  }
+  JsonSink(std::FILE* fileHandle, bool closeFile, LevelMask mask, FlushPolicy flushPolicy) :
+      FileSink{fileHandle, closeFile, mask, flushPolicy} {}
   ~JsonSink() override = default;
 
-  auto write(const Message& msg) noexcept -> void override {
-    // Start the log object.
-    m_buffer.append("{");
+protected:
+  auto format(const Message& msg, std::string* out) noexcept -> void override {
+    const auto& meta = m_metaCache.get(msg.getMeta(), &buildMeta);
 
-    // Text message.
-    m_buffer.append(" \"message\": \"");
-    m_buffer.append(msg.getMeta()->getTxt());
-    m_buffer.append("\",");
-
-    // Level.
-    m_buffer.append(" \"level\": \"");
-    m_buffer.append(getName(msg.getMeta()->getLevel()));
-    m_buffer.append("\",");
+    // Static fields before the timestamp (message and level).
+    out->append(meta.prefix);
 
     // Time.
-    m_buffer.append(" \"timestamp\": \"");
-    internal::writeIsoTime(&m_buffer, msg.getTime());
-    m_buffer.append("\",");
+    m_timeWriter.write(out, msg.getTime());
 
-    // File.
-    m_buffer.append(" \"file\": \"");
-    // TODO(bastian): We could probably normalize the file path at compile time.
-    internal::writePathNormalized(&m_buffer, msg.getMeta()->getFile().data());
-    m_buffer.append("\",");
-
-    // Function.
-    m_buffer.append(" \"func\": \"");
-    m_buffer.append(msg.getMeta()->getFunc());
-    m_buffer.append("\",");
-
-    // Line.
-    m_buffer.append(" \"line\": ");
-    internal::writeInt(&m_buffer, msg.getMeta()->getLine());
+    // Static fields after the timestamp (file, function and line).
+    out->append(meta.suffix);
 
     // Parameters.
     if (msg.hasParams()) {
       // Start the 'extra' object.
-      m_buffer.append(", \"extra\": {");
+      out->append(", \"extra\": {");
 
       for (auto itr = msg.begin(); itr != msg.end(); ++itr) {
-        m_buffer.append(" \"");
-        m_buffer.append(itr->getKey());
-        m_buffer.append("\": ");
+        out->append(" \"");
+        out->append(itr->getKey());
+        out->append("\": ");
 
-        itr->writeValue(&m_buffer, ParamWriteMode::Json);
+        itr->writeValue(out, ParamWriteMode::Json);
 
         auto isLast = itr == msg.end() - 1;
         if (!isLast) {
-          m_buffer.append(",");
+          out->append(",");
         }
       }
 
       // End the 'extra' object.
-      m_buffer.append(" }");
+      out->append(" }");
     }
 
     // End the log object.
-    m_buffer.append(" }\n");
-
-    writeBuffer();
+    out->append(" }\n");
   }
 
 private:
-  std::string m_buffer;
+  /* Pre-serialized static fields of a call-site, the timestamp is written in between.
+   */
+  struct MetaJson final {
+    std::string prefix;
+    std::string suffix;
+  };
+
+  internal::MetaCache<MetaJson> m_metaCache;
+  internal::IsoTimeWriter m_timeWriter;
+
+  [[nodiscard]] static auto buildMeta(const MetaData& meta) noexcept -> MetaJson {
+    auto result = MetaJson{};
 
-  auto writeBuffer() noexcept -> void {
-    writeToFile(m_buffer.data(), m_buffer.size());
-    m_buffer.clear();
+    // Start the log object.
+    result.prefix.append("{");
+
+    // Text message.
+    result.prefix.append(" \"message\": \"");
+    internal::writeStrEscaped(&result.prefix, meta.getTxt());
+    result.prefix.append("\",");
+
+    // Level.
+    result.prefix.append(" \"level\": \"");
+    result.prefix.append(getName(meta.getLevel()));
+    result.prefix.append("\",");
+
+    // Start of the time.
+    result.prefix.append(" \"timestamp\": \"");
+
+    // End of the time.
+    result.suffix.append("\",");
+
+    // File.
+    result.suffix.append(" \"file\": \"");
+    internal::writePathNormalized(&result.suffix, meta.getFile());
+    result.suffix.append("\",");
+
+    // Function.
+    result.suffix.append(" \"func\": \"");
+    internal::writeStrEscaped(&result.suffix, meta.getFunc());
+    result.suffix.append("\",");
+
+    // Line.
+    result.suffix.append(" \"line\": ");
+    internal::writeInt(&result.suffix, meta.getLine());
+    return result;
   }
 };
 
@@ -88,8 +104,14 @@ auto makeConsoleJsonSink(LevelMask mask) -> SinkUnique {
   return internal::makeConsoleSink<JsonSink>(mask);
 }
 
-auto makeFileJsonSink(fs::path path, LevelMask mask) -> SinkUnique {
-  return internal::makeFileSink<JsonSink>(std::move(path), mask);
+auto makeFileJsonSink(
+    fs::path path,
+    LevelMask mask,
+    FlushPolicy flushPolicy,
+    RotationPolicy rotationPolicy,
+    Compression compression) -> SinkUnique {
+  return internal::makeFileSink<JsonSink>(
+      std::move(path), false, mask, flushPolicy, rotationPolicy, compression);
 }
 
 } // namespace tria::log
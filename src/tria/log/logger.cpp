@@ -1,24 +1,246 @@
 #include "tria/log/logger.hpp"
+#include "internal/histogram.hpp"
+#include "internal/mpmc_queue.hpp"
+#include "internal/tick_converter.hpp"
 #include "tria/log/metadata.hpp"
+#include "tria/log/rate_limiter.hpp"
 #include "tria/pal/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <thread>
 #include <vector>
 
 namespace tria::log {
 
+namespace {
+
+[[nodiscard]] auto getQueueCapacity(const LoggerConfig& config) {
+  if (config.queueCapacity == 0U) {
+    throw std::invalid_argument{"Logger queue capacity has to be atleast one"};
+  }
+  // Round up to the next power of two (and atleast two), as required by the queue.
+  auto capacity = size_t{2U};
+  while (capacity < config.queueCapacity) {
+    capacity <<= 1U;
+  }
+  return capacity;
+}
+
+[[nodiscard]] constexpr auto getLevelIndex(Level lvl) noexcept -> size_t {
+  switch (lvl) {
+  case Level::Debug:
+    return 0U;
+  case Level::Info:
+    return 1U;
+  case Level::Warn:
+    return 2U;
+  case Level::Error:
+    return 3U;
+  }
+  return 0U;
+}
+
+constexpr static auto g_statsMeta =
+    MetaData{Level::Info, "Logger stats", __FILE__, "Logger::Impl::logStats", __LINE__};
+
+/* Statistics of a single sink, only written by the thread that invokes the sink.
+ */
+struct SinkMetrics final {
+  internal::AtomicHistogram writeTime;
+  internal::AtomicHistogram latency;
+  std::atomic<uint64_t> dropped{0U};
+};
+
+/* Write a batch to the sink while recording the latency of the messages and the write time.
+ */
+auto writeToSink(
+    Sink* sink, SinkMetrics* metrics, const Message* begin, const Message* end) noexcept -> void {
+  const auto now = std::chrono::system_clock::now();
+  for (const auto* itr = begin; itr != end; ++itr) {
+    if (isInMask(sink->getMask(), itr->getMeta()->getLevel())) {
+      metrics->latency.recordDuration(now - itr->getTime());
+    }
+  }
+  const auto writeStart = std::chrono::steady_clock::now();
+  sink->writeBatch(begin, end);
+  metrics->writeTime.recordDuration(std::chrono::steady_clock::now() - writeStart);
+}
+
+/* Amount of messages (in queue capacities) a sink thread can fall behind before the overflow policy
+ * applies to it, bounds the memory used when a sink cannot keep up.
+ */
+constexpr size_t g_sinkWorkerBacklog = 4U;
+
+using MessageBatch = std::shared_ptr<const std::vector<Message>>;
+
+/*
+ * Thread that invokes a single sink.
+ * The log thread pushes shared (immutable) batches, every worker keeps its own list of pending
+ * batches so each sink consumes the messages at its own pace.
+ */
+class SinkWorker final {
+public:
+  SinkWorker(
+      Sink* sink, SinkMetrics* metrics, OverflowPolicy overflowPolicy, size_t maxPendingMsgs) :
+      m_sink{sink},
+      m_metrics{metrics},
+      m_overflowPolicy{overflowPolicy},
+      m_maxPendingMsgs{maxPendingMsgs},
+      m_pendingMsgs{0U},
+      m_shutdown{false} {
+    m_thread = std::thread(&SinkWorker::loop, this);
+  }
+  SinkWorker(const SinkWorker& rhs) = delete;
+  SinkWorker(SinkWorker&& rhs)      = delete;
+
+  ~SinkWorker() {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_shutdown = true;
+    }
+    m_popCondVar.notify_one();
+    m_thread.join();
+  }
+
+  auto operator=(const SinkWorker& rhs) -> SinkWorker& = delete;
+  auto operator=(SinkWorker&& rhs) -> SinkWorker& = delete;
+
+  /* Push a batch for the sink to write.
+   * Note: While the sink is more than 'maxPendingMsgs' messages behind the overflow policy applies,
+   * 'Block' waits for the sink while the drop policies drop batches for this sink only.
+   */
+  auto push(MessageBatch batch) noexcept -> void {
+    {
+      std::unique_lock<std::mutex> lk(m_mutex);
+      switch (m_overflowPolicy) {
+      case OverflowPolicy::Block:
+        m_pushCondVar.wait(lk, [this]() { return m_pendingMsgs < m_maxPendingMsgs; });
+        break;
+      case OverflowPolicy::DropNewest:
+        if (m_pendingMsgs >= m_maxPendingMsgs) {
+          countDropped(*batch);
+          return;
+        }
+        break;
+      case OverflowPolicy::DropOldest:
+        // Note: The batch that is being written also counts, it cannot be dropped anymore.
+        while (m_pendingMsgs >= m_maxPendingMsgs && !m_pending.empty()) {
+          countDropped(*m_pending.front());
+          m_pendingMsgs -= m_pending.front()->size();
+          m_pending.pop_front();
+        }
+        break;
+      }
+      m_pendingMsgs += batch->size();
+      m_pending.push_back(std::move(batch));
+    }
+    m_popCondVar.notify_one();
+  }
+
+private:
+  Sink* m_sink;
+  SinkMetrics* m_metrics;
+  OverflowPolicy m_overflowPolicy;
+  size_t m_maxPendingMsgs;
+  size_t m_pendingMsgs;
+  bool m_shutdown;
+  std::deque<MessageBatch> m_pending;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_pushCondVar;
+  std::condition_variable m_popCondVar;
+
+  auto countDropped(const std::vector<Message>& batch) noexcept -> void {
+    auto count = uint64_t{0U};
+    for (const auto& msg : batch) {
+      count += isInMask(m_sink->getMask(), msg.getMeta()->getLevel()) ? 1U : 0U;
+    }
+    m_metrics->dropped.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  auto loop() noexcept -> void {
+    pal::setThreadName("tria_log_sink");
+
+    auto idleTime = std::chrono::steady_clock::time_point::max();
+    while (true) {
+      auto batch = MessageBatch{};
+      {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        const auto wakeup = [this]() { return !m_pending.empty() || m_shutdown; };
+        if (idleTime != std::chrono::steady_clock::time_point::max()) {
+          m_popCondVar.wait_until(lk, idleTime, wakeup);
+        } else {
+          m_popCondVar.wait(lk, wakeup);
+        }
+        if (!m_pending.empty()) {
+          batch = std::move(m_pending.front());
+          m_pending.pop_front();
+        } else if (m_shutdown) {
+          return; // Only stop when all pending batches have been written.
+        }
+      }
+
+      if (batch) {
+        writeToSink(m_sink, m_metrics, batch->data(), batch->data() + batch->size());
+        {
+          std::lock_guard<std::mutex> lk(m_mutex);
+          m_pendingMsgs -= batch->size();
+        }
+        m_pushCondVar.notify_one();
+      }
+      idleTime = m_sink->idle(std::chrono::steady_clock::now());
+    }
+  }
+};
+
+} // namespace
+
 class Logger::Impl final {
 public:
-  explicit Impl(std::vector<SinkUnique> sinks) :
-      m_sinks{std::move(sinks)}, m_threadShutdown{false} {
+  Impl(LoggerConfig config, std::vector<SinkUnique> sinks) :
+      m_sinks{std::move(sinks)},
+      m_sinkMetrics{std::make_unique<SinkMetrics[]>(m_sinks.size())},
+      m_threadShutdown{false},
+      m_threadSleeping{false},
+      m_overflowPolicy{config.overflowPolicy},
+      m_msgsInput{getQueueCapacity(config)},
+      m_queueHighWaterMark{0U},
+      m_dropped{},
+      m_processed{},
+      m_statsLogInterval{config.statsLogInterval},
+      m_statsLogTime{std::chrono::steady_clock::now() + config.statsLogInterval},
+      m_statsLogProcessed{0U},
+      m_rateSummaryInterval{config.rateSummaryInterval},
+      m_rateSummaryTime{std::chrono::steady_clock::now() + config.rateSummaryInterval} {
     // Validate input sinks.
-    for (const auto& sink : sinks) {
+    for (const auto& sink : m_sinks) {
       if (!sink) {
         throw std::invalid_argument{"Null sink pointer is not supported"};
       }
     }
 
+    // Calibrate the tick counter up front, instead of on the first message.
+    if (config.timeSource == TimeSource::Ticks) {
+      m_tickConverter.emplace();
+    }
+
+    // Start the sink threads.
+    if (config.sinkDispatch == SinkDispatch::Parallel) {
+      const auto maxPendingMsgs = m_msgsInput.getCapacity() * g_sinkWorkerBacklog;
+      for (auto i = 0U; i != m_sinks.size(); ++i) {
+        m_sinkWorkers.push_back(std::make_unique<SinkWorker>(
+            m_sinks[i].get(), &m_sinkMetrics[i], config.overflowPolicy, maxPendingMsgs));
+      }
+    }
+
     // Start the logging thread.
     m_thread = std::thread(&Impl::logLoop, this);
   }
@@ -29,71 +251,422 @@ public:
     }
     {
       std::lock_guard<std::mutex> lk(m_mutex);
-      m_threadShutdown = true;
+      m_threadShutdown.store(true, std::memory_order_relaxed);
     }
     m_logCondVar.notify_one();
     m_thread.join();
+
+    // Wait for the sink threads to write their remaining batches.
+    m_sinkWorkers.clear();
+
+    // Allow other loggers to track the rate limiters, their call-sites can outlive this logger.
+    for (const auto& tracked : m_rateLimiters) {
+      tracked.limiter->releaseTracking();
+    }
   }
 
   auto publish(Message msg) noexcept {
+    // Fast path: claim a slot in the queue, only contends with other producers on a single atomic.
+    while (!m_msgsInput.tryPush(msg)) {
+      // Queue is full.
+      m_queueHighWaterMark.store(m_msgsInput.getCapacity(), std::memory_order_relaxed);
+      switch (m_overflowPolicy) {
+      case OverflowPolicy::Block:
+        // Make sure the log thread is awake and give it time to catch up.
+        wakeLogThread();
+        std::this_thread::yield();
+        break;
+      case OverflowPolicy::DropNewest:
+        countDropped(msg);
+        wakeLogThread();
+        return;
+      case OverflowPolicy::DropOldest:
+        // Make room by dropping the oldest message, races with the log thread (and other producers)
+        // which is fine as the queue supports concurrent consumers.
+        m_msgsInput.tryPop([this](Message&& oldest) { countDropped(oldest); });
+        break;
+      }
+    }
+
+    // Only take the lock if the log thread went to sleep, while the log thread is busy processing
+    // messages publishing does not need to touch the mutex or the condition variable.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_threadSleeping.load(std::memory_order_relaxed)) {
+      wakeLogThread();
+    }
+  }
+
+  auto trackRateLimiter(RateLimiter* limiter, const MetaData* meta, const MetaData* summaryMeta)
+      -> void {
+    if (m_rateSummaryInterval.count() == 0) {
+      limiter->releaseTracking(); // Leave it to a logger that reports summaries.
+      return;
+    }
     {
-      std::lock_guard<std::mutex> lk(m_mutex);
-      m_msgsInput.push_back(std::move(msg));
+      std::lock_guard<std::mutex> lk(m_rateLimitersMutex);
+      m_rateLimiters.push_back(TrackedRateLimiter{limiter, meta, summaryMeta});
     }
-    m_logCondVar.notify_one();
+    // Wake the log thread so it starts waking up for the summaries, even if nothing else is logged.
+    wakeLogThread();
+  }
+
+  [[nodiscard]] auto getStats() const noexcept -> LoggerStats {
+    const auto getDropped = [this](Level lvl) {
+      return m_dropped[getLevelIndex(lvl)].load(std::memory_order_relaxed);
+    };
+    const auto getProcessed = [this](Level lvl) {
+      return m_processed[getLevelIndex(lvl)].load(std::memory_order_relaxed);
+    };
+    auto result               = LoggerStats{};
+    result.queueCapacity      = m_msgsInput.getCapacity();
+    result.queueDepth         = m_msgsInput.getSize();
+    result.queueHighWaterMark = m_queueHighWaterMark.load(std::memory_order_relaxed);
+    result.droppedDebug       = getDropped(Level::Debug);
+    result.droppedInfo        = getDropped(Level::Info);
+    result.droppedWarn        = getDropped(Level::Warn);
+    result.droppedError       = getDropped(Level::Error);
+    result.processedDebug     = getProcessed(Level::Debug);
+    result.processedInfo      = getProcessed(Level::Info);
+    result.processedWarn      = getProcessed(Level::Warn);
+    result.processedError     = getProcessed(Level::Error);
+    result.batchSize          = m_batchSize.getSnapshot();
+    result.sinks.reserve(m_sinks.size());
+    for (auto i = 0U; i != m_sinks.size(); ++i) {
+      result.sinks.push_back(LoggerSinkStats{
+          m_sinkMetrics[i].writeTime.getSnapshot(),
+          m_sinkMetrics[i].latency.getSnapshot(),
+          m_sinkMetrics[i].dropped.load(std::memory_order_relaxed)});
+    }
+    return result;
   }
 
 private:
   std::vector<SinkUnique> m_sinks;
+  std::unique_ptr<SinkMetrics[]> m_sinkMetrics; // Same order as the sinks.
+  std::vector<std::unique_ptr<SinkWorker>> m_sinkWorkers; // Empty for sequential dispatch.
   std::thread m_thread;
-  bool m_threadShutdown;
+  std::atomic<bool> m_threadShutdown;
+  std::atomic<bool> m_threadSleeping;
+  OverflowPolicy m_overflowPolicy;
 
-  std::vector<Message> m_msgsInput;
+  internal::MpmcQueue<Message> m_msgsInput;
   std::vector<Message> m_msgsProcess;
+  std::optional<internal::TickConverter> m_tickConverter; // Only for 'TimeSource::Ticks'.
+
+  std::atomic<size_t> m_queueHighWaterMark;
+  std::array<std::atomic<uint64_t>, 4> m_dropped;   // Dropped messages per level.
+  std::array<std::atomic<uint64_t>, 4> m_processed; // Only written by the log thread.
+  internal::AtomicHistogram m_batchSize;
+
+  std::chrono::milliseconds m_statsLogInterval;
+  std::chrono::steady_clock::time_point m_statsLogTime; // When to log the stats next.
+  uint64_t m_statsLogProcessed;                         // Processed count at the last stats log.
+
+  struct TrackedRateLimiter final {
+    RateLimiter* limiter;
+    const MetaData* meta;
+    const MetaData* summaryMeta;
+  };
+
+  std::chrono::milliseconds m_rateSummaryInterval;
+  std::chrono::steady_clock::time_point m_rateSummaryTime; // When to report suppressed messages.
+  std::mutex m_rateLimitersMutex;
+  std::vector<TrackedRateLimiter> m_rateLimiters;
 
   std::mutex m_mutex;
   std::condition_variable m_logCondVar;
 
+  auto wakeLogThread() noexcept -> void {
+    if (m_threadSleeping.exchange(false, std::memory_order_relaxed)) {
+      // Acquire the lock before notifying to avoid a lost wakeup when the log thread is in-between
+      // checking its predicate and starting to wait.
+      { std::lock_guard<std::mutex> lk(m_mutex); }
+      m_logCondVar.notify_one();
+    }
+  }
+
+  auto countDropped(const Message& msg) noexcept -> void {
+    m_dropped[getLevelIndex(msg.getMeta()->getLevel())].fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  auto updateHighWaterMark() noexcept -> void {
+    // Only the log thread updates the high-water mark (apart from producers that find the queue
+    // full), sampling the depth before draining catches the peaks while the log thread is busy.
+    const auto depth = m_msgsInput.getSize();
+    if (depth > m_queueHighWaterMark.load(std::memory_order_relaxed)) {
+      m_queueHighWaterMark.store(depth, std::memory_order_relaxed);
+    }
+  }
+
   auto logLoop() noexcept -> void {
     pal::setThreadName("tria_log_thread");
 
     auto running = true;
     while (running) {
 
-      // Wait for a message to be logged.
-      {
+      updateHighWaterMark();
+
+      // Move the available messages into our process buffer.
+      // Note: Batch is limited to the queue capacity, otherwise busy producers could keep growing
+      // it forever.
+      const auto pushToProcess = [this](Message&& msg) { m_msgsProcess.push_back(std::move(msg)); };
+      while (m_msgsProcess.size() != m_msgsInput.getCapacity() &&
+             m_msgsInput.tryPop(pushToProcess)) {
+      }
+
+      if (m_statsLogInterval.count() != 0) {
+        logStats();
+      }
+      logSuppressed(false);
+
+      if (m_msgsProcess.empty()) {
+        // No messages available: wait for a message to be published.
+        const auto wakeTime = std::min(idleSinks(), getWakeTime());
         std::unique_lock<std::mutex> lk(m_mutex);
-        m_logCondVar.wait(lk, [this]() { return !m_msgsInput.empty() || m_threadShutdown; });
+        m_threadSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto wakeup = [this]() {
+          return !m_threadSleeping.load(std::memory_order_relaxed) || !m_msgsInput.empty() ||
+              m_threadShutdown.load(std::memory_order_relaxed);
+        };
+        if (wakeTime != std::chrono::steady_clock::time_point::max()) {
+          m_logCondVar.wait_until(lk, wakeTime, wakeup);
+        } else {
+          m_logCondVar.wait(lk, wakeup);
+        }
+        m_threadSleeping.store(false, std::memory_order_relaxed);
 
-        // Move the messages into our process buffer.
-        m_msgsInput.swap(m_msgsProcess);
+        // Only stop when all messages published before the shutdown have been processed.
+        running = !m_threadShutdown.load(std::memory_order_relaxed) || !m_msgsInput.empty();
+        if (!running) {
+          // Report the remaining suppressed messages, keep running until they are written.
+          logSuppressed(true);
+          running = !m_msgsProcess.empty();
+        }
+        continue;
+      }
+
+      convertTickTimes();
+      countProcessed();
 
-        if (m_threadShutdown) {
-          running = false;
+      // Process all messages, every sink receives the whole batch.
+      if (m_sinkWorkers.empty()) {
+        const auto* batchBegin = m_msgsProcess.data();
+        const auto* batchEnd   = batchBegin + m_msgsProcess.size();
+        for (auto i = 0U; i != m_sinks.size(); ++i) {
+          writeToSink(m_sinks[i].get(), &m_sinkMetrics[i], batchBegin, batchEnd);
         }
+        m_msgsProcess.clear();
+      } else {
+        dispatchToWorkers();
       }
+    }
+  }
 
-      // Process all messages.
-      for (const auto& msg : m_msgsProcess) {
-        processMsg(msg);
+  auto convertTickTimes() noexcept -> void {
+    if (!m_tickConverter) {
+      return;
+    }
+    // Re-anchor once per batch, the messages in a batch were published shortly before.
+    m_tickConverter->update();
+    for (auto& msg : m_msgsProcess) {
+      if (msg.hasTickTime()) {
+        msg.setTime(m_tickConverter->toTime(msg.getTicks()));
       }
-      m_msgsProcess.clear();
     }
   }
 
-  auto processMsg(const Message& msg) noexcept -> void {
-    for (const auto& sink : m_sinks) {
-      if (isInMask(sink->getMask(), msg.getMeta()->getLevel())) {
-        sink->write(msg);
+  auto countProcessed() noexcept -> void {
+    auto counts = std::array<uint64_t, 4>{};
+    for (const auto& msg : m_msgsProcess) {
+      ++counts[getLevelIndex(msg.getMeta()->getLevel())];
+    }
+    for (auto i = 0U; i != counts.size(); ++i) {
+      const auto cur = m_processed[i].load(std::memory_order_relaxed);
+      m_processed[i].store(cur + counts[i], std::memory_order_relaxed);
+    }
+    m_batchSize.record(m_msgsProcess.size());
+  }
+
+  [[nodiscard]] auto getTotalProcessed() const noexcept {
+    auto result = uint64_t{0U};
+    for (const auto& count : m_processed) {
+      result += count.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /* Add a message with the logger statistics to the batch, if the interval has elapsed.
+   * Skipped when no messages were logged since the last stats message.
+   */
+  auto logStats() noexcept -> void {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_statsLogTime) {
+      return;
+    }
+    m_statsLogTime = now + m_statsLogInterval;
+
+    const auto processed = getTotalProcessed() + m_msgsProcess.size();
+    if (processed == m_statsLogProcessed) {
+      return;
+    }
+    m_statsLogProcessed = processed + 1U; // Include the stats message itself.
+
+    const auto toDuration = [](uint64_t nanos) {
+      return std::chrono::duration_cast<Duration>(std::chrono::nanoseconds{nanos});
+    };
+    const auto stats  = getStats();
+    auto latencyP99   = std::vector<Duration>{};
+    auto writeTimeP99 = std::vector<Duration>{};
+    auto sinkDropped  = std::vector<uint64_t>{};
+    for (const auto& sink : stats.sinks) {
+      latencyP99.push_back(toDuration(sink.latency.getPercentile(0.99)));
+      writeTimeP99.push_back(toDuration(sink.writeTime.getPercentile(0.99)));
+      sinkDropped.push_back(sink.dropped);
+    }
+    m_msgsProcess.push_back(Message{
+        &g_statsMeta,
+        {{"processed", processed},
+         {"dropped", stats.getTotalDropped()},
+         {"queueHighWaterMark", stats.queueHighWaterMark},
+         {"batchSizeMean", stats.batchSize.getMean()},
+         {"latencyP99", std::move(latencyP99)},
+         {"writeTimeP99", std::move(writeTimeP99)},
+         {"sinkDropped", std::move(sinkDropped)}}});
+  }
+
+  /* Add a summary message to the batch for every tracked rate limiter that suppressed messages, if
+   * the interval has elapsed (or 'force' is true).
+   */
+  auto logSuppressed(bool force) noexcept -> void {
+    if (m_rateSummaryInterval.count() == 0) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_rateSummaryTime && !force) {
+      return;
+    }
+    m_rateSummaryTime = now + m_rateSummaryInterval;
+
+    std::lock_guard<std::mutex> lk(m_rateLimitersMutex);
+    for (const auto& tracked : m_rateLimiters) {
+      const auto suppressed = tracked.limiter->takeSuppressed();
+      if (suppressed) {
+        m_msgsProcess.push_back(Message{
+            tracked.summaryMeta,
+            {{"message", tracked.meta->getTxt()}, {"suppressed", suppressed}}});
+      }
+    }
+  }
+
+  /* Let the sinks finish their deferred work, returns the time they want to be called again at.
+   * Note: Sink threads do this themselves for parallel dispatch.
+   */
+  auto idleSinks() noexcept -> std::chrono::steady_clock::time_point {
+    auto result = std::chrono::steady_clock::time_point::max();
+    if (m_sinkWorkers.empty()) {
+      const auto now = std::chrono::steady_clock::now();
+      for (const auto& sink : m_sinks) {
+        result = std::min(result, sink->idle(now));
+      }
+    }
+    return result;
+  }
+
+  /* Time at which the log thread has to wake up to log the periodic messages, 'max()' if there are
+   * none.
+   */
+  [[nodiscard]] auto getWakeTime() noexcept -> std::chrono::steady_clock::time_point {
+    auto result = std::chrono::steady_clock::time_point::max();
+    if (m_statsLogInterval.count() != 0) {
+      result = m_statsLogTime;
+    }
+    if (m_rateSummaryInterval.count() != 0) {
+      std::lock_guard<std::mutex> lk(m_rateLimitersMutex);
+      if (!m_rateLimiters.empty()) {
+        result = std::min(result, m_rateSummaryTime);
       }
     }
+    return result;
+  }
+
+  auto dispatchToWorkers() noexcept -> void {
+    // Share the batch with all sink threads, from here on the batch is immutable and is freed when
+    // the last sink has written it.
+    auto batch = std::make_shared<const std::vector<Message>>(std::move(m_msgsProcess));
+    m_msgsProcess.clear();
+    m_msgsProcess.reserve(batch->size());
+    for (const auto& worker : m_sinkWorkers) {
+      worker->push(batch);
+    }
   }
 };
 
-Logger::Logger(std::vector<SinkUnique> sinks) : m_impl{std::make_unique<Impl>(std::move(sinks))} {}
+auto LoggerHistogram::getPercentile(double fraction) const noexcept -> uint64_t {
+  if (count == 0U) {
+    return 0U;
+  }
+  const auto target = static_cast<uint64_t>(static_cast<double>(count) * fraction);
+  auto seen         = uint64_t{0U};
+  for (auto i = 0U; i != s_bucketCount; ++i) {
+    seen += buckets[i];
+    if (seen > target || seen == count) {
+      // Upper bound of the bucket, the last bucket has no upper bound so use the max.
+      const auto upper = i == 0U ? 0U : (uint64_t{1U} << i) - 1U;
+      return i == s_bucketCount - 1U ? max : std::min(upper, max);
+    }
+  }
+  return max;
+}
+
+namespace {
+
+[[nodiscard]] auto getSinksMask(const std::vector<SinkUnique>& sinks) noexcept {
+  auto mask = noneLevelMask();
+  for (const auto& sink : sinks) {
+    if (sink) {
+      mask |= sink->getMask();
+    }
+  }
+  return mask;
+}
+
+} // namespace
+
+Logger::Logger(std::vector<SinkUnique> sinks) : Logger(LoggerConfig{}, std::move(sinks)) {}
+
+Logger::Logger(LoggerConfig config, std::vector<SinkUnique> sinks) :
+    m_mask{getSinksMask(sinks)},
+    m_timeSource{config.timeSource},
+    m_rateSummaries{config.rateSummaryInterval.count() != 0},
+    m_impl{std::make_unique<Impl>(config, std::move(sinks))} {}
+
+Logger::Logger(Logger&& rhs) noexcept :
+    m_mask{rhs.m_mask.exchange(noneLevelMask(), std::memory_order_relaxed)},
+    m_timeSource{rhs.m_timeSource},
+    m_rateSummaries{rhs.m_rateSummaries},
+    m_impl{std::move(rhs.m_impl)} {}
 
 Logger::~Logger() = default;
 
+auto Logger::operator=(Logger&& rhs) noexcept -> Logger& {
+  if (this != &rhs) {
+    m_mask.store(
+        rhs.m_mask.exchange(noneLevelMask(), std::memory_order_relaxed), std::memory_order_relaxed);
+    m_timeSource    = rhs.m_timeSource;
+    m_rateSummaries = rhs.m_rateSummaries;
+    m_impl          = std::move(rhs.m_impl);
+  }
+  return *this;
+}
+
 auto Logger::publish(Message msg) noexcept -> void { m_impl->publish(std::move(msg)); }
 
+auto Logger::trackRateLimiter(
+    RateLimiter* limiter, const MetaData* meta, const MetaData* summaryMeta) -> void {
+  m_impl->trackRateLimiter(limiter, meta, summaryMeta);
+}
+
+auto Logger::getStats() const noexcept -> LoggerStats { return m_impl->getStats(); }
+
 } // namespace tria::log
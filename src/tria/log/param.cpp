@@ -1,18 +1,65 @@
 #include "tria/log/param.hpp"
+#include "internal/bin_format.hpp"
+#include "internal/intern_pool.hpp"
 #include "internal/str_write.hpp"
+#include <array>
 #include <cassert>
+#include <functional>
 
 namespace tria::log {
 
 template <typename>
 constexpr bool falseValue = false;
 
+namespace {
+
+constexpr size_t g_pathPoolMaxBytes = 1024U * 1024U;
+
+[[nodiscard]] auto getPathPool() noexcept -> internal::InternPool& {
+  // Intentionally never destroyed: messages referencing interned paths can still be in flight
+  // during static destruction (for example in the queue of a static logger).
+  static auto* pool = new internal::InternPool{g_pathPoolMaxBytes};
+  return *pool;
+}
+
+[[nodiscard]] auto makePathStr(std::string_view path) noexcept -> InlineStr {
+  if (path.size() <= InlineStr::s_inlineCapacity) {
+    return InlineStr{path}; // Short paths fit inline, no need to intern them.
+  }
+  // Small per-thread cache of recently interned paths, avoids locking the pool for paths that are
+  // logged repeatedly from the same thread.
+  thread_local auto cache = std::array<std::string_view, 64>{};
+  auto& cached            = cache[std::hash<std::string_view>{}(path) % cache.size()];
+  if (cached == path) {
+    return InlineStr::borrow(cached);
+  }
+  if (const auto interned = getPathPool().intern(path)) {
+    cached = *interned;
+    return InlineStr::borrow(*interned);
+  }
+  return InlineStr{path};
+}
+
+} // namespace
+
+PathStr::PathStr(const fs::path& path) noexcept {
+  if constexpr (std::is_same_v<fs::path::value_type, char>) {
+    m_str = makePathStr(path.native());
+  } else {
+    m_str = makePathStr(path.string());
+  }
+}
+
 auto Value::operator==(const Value& rhs) const noexcept -> bool { return m_val == rhs.m_val; }
 
 auto Value::operator!=(const Value& rhs) const noexcept -> bool { return !Value::operator==(rhs); }
 
 auto Value::write(std::string* tgtStr, ParamWriteMode mode) const noexcept -> void {
   assert(tgtStr);
+  if (mode == ParamWriteMode::Binary) {
+    writeBinary(tgtStr);
+    return;
+  }
   std::visit(
       [tgtStr, mode](auto&& arg) {
         using T = std::decay_t<decltype(arg)>;
@@ -21,29 +68,29 @@ auto Value::write(std::string* tgtStr, ParamWriteMode mode) const noexcept -> vo
           internal::writeInt(tgtStr, arg);
         }
         // NOLINTNEXTLINE(bugprone-branch-clone)
-        else if constexpr (std::is_same_v<T, double>) {
-          internal::writeDouble(tgtStr, arg);
+        else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+          internal::writeFloat(tgtStr, arg);
         }
         // NOLINTNEXTLINE(bugprone-branch-clone)
         else if constexpr (std::is_same_v<T, bool>) {
           tgtStr->append(arg ? "true" : "false");
         }
         // NOLINTNEXTLINE(bugprone-branch-clone)
-        else if constexpr (std::is_same_v<T, std::string>) {
+        else if constexpr (std::is_same_v<T, InlineStr>) {
           if (mode == ParamWriteMode::Json) {
             tgtStr->append("\"");
           }
-          internal::writeStrEscaped(tgtStr, arg);
+          internal::writeStrEscaped(tgtStr, arg.view());
           if (mode == ParamWriteMode::Json) {
             tgtStr->append("\"");
           }
         }
         // NOLINTNEXTLINE(bugprone-branch-clone)
-        else if constexpr (std::is_same_v<T, fs::path>) {
+        else if constexpr (std::is_same_v<T, PathStr>) {
           if (mode == ParamWriteMode::Json) {
             tgtStr->append("\"");
           }
-          internal::writePathNormalized(tgtStr, arg.c_str());
+          internal::writePathNormalized(tgtStr, arg.view());
           if (mode == ParamWriteMode::Json) {
             tgtStr->append("\"");
           }
@@ -59,6 +106,8 @@ auto Value::write(std::string* tgtStr, ParamWriteMode mode) const noexcept -> vo
           case ParamWriteMode::Pretty:
             internal::writePrettyDuration(tgtStr, arg);
             break;
+          case ParamWriteMode::Binary:
+            break; // Handled by 'writeBinary'.
           }
         } else if constexpr (std::is_same_v<T, TimePoint>) {
           if (mode == ParamWriteMode::Json) {
@@ -79,6 +128,8 @@ auto Value::write(std::string* tgtStr, ParamWriteMode mode) const noexcept -> vo
           case ParamWriteMode::Pretty:
             internal::writePrettyMemSize(tgtStr, arg.getSize());
             break;
+          case ParamWriteMode::Binary:
+            break; // Handled by 'writeBinary'.
           }
         else {
           static_assert(falseValue<T>, "Non exhaustive write-value routine");
@@ -87,6 +138,49 @@ auto Value::write(std::string* tgtStr, ParamWriteMode mode) const noexcept -> vo
       m_val);
 }
 
+auto Value::writeBinary(std::string* tgtStr) const noexcept -> void {
+  std::visit(
+      [tgtStr](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, int64_t>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Int));
+          internal::writeBinVarInt(tgtStr, arg);
+        } else if constexpr (std::is_same_v<T, uint64_t>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::UInt));
+          internal::writeBinVarUInt(tgtStr, arg);
+        } else if constexpr (std::is_same_v<T, double>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Double));
+          internal::writeBinFixed(tgtStr, arg);
+        } else if constexpr (std::is_same_v<T, float>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Float));
+          internal::writeBinFixed(tgtStr, arg);
+        } else if constexpr (std::is_same_v<T, bool>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Bool));
+          internal::writeBinByte(tgtStr, arg ? 1U : 0U);
+        } else if constexpr (std::is_same_v<T, InlineStr>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Str));
+          internal::writeBinStr(tgtStr, arg.view());
+        } else if constexpr (std::is_same_v<T, PathStr>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Path));
+          internal::writeBinStr(tgtStr, arg.view());
+        } else if constexpr (std::is_same_v<T, Duration>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::Duration));
+          internal::writeBinFixed(tgtStr, arg.count());
+        } else if constexpr (std::is_same_v<T, TimePoint>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::TimePoint));
+          internal::writeBinFixed<int64_t>(
+              tgtStr,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(arg.time_since_epoch()).count());
+        } else if constexpr (std::is_same_v<T, MemSize>) {
+          internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::MemSize));
+          internal::writeBinVarUInt(tgtStr, arg.getSize());
+        } else {
+          static_assert(falseValue<T>, "Non exhaustive write-binary routine");
+        }
+      },
+      m_val);
+}
+
 auto Param::operator==(const Param& rhs) const noexcept -> bool {
   return m_key == rhs.m_key && m_value == rhs.m_value;
 }
@@ -104,6 +198,14 @@ auto Param::writeValue(std::string* tgtStr, ParamWriteMode mode) const noexcept
 
         } else if constexpr (std::is_same_v<T, std::vector<Value>>) {
 
+          if (mode == ParamWriteMode::Binary) {
+            internal::writeBinByte(tgtStr, static_cast<uint8_t>(internal::BinValueKind::List));
+            internal::writeBinVarUInt(tgtStr, arg.size());
+            for (const auto& val : arg) {
+              val.write(tgtStr, mode);
+            }
+            return;
+          }
           if (mode == ParamWriteMode::Json) {
             tgtStr->append("[");
           }
@@ -1,4 +1,5 @@
 #include "internal/file_sink.hpp"
+#include "internal/meta_cache.hpp"
 #include "internal/str_write.hpp"
 #include "tria/log/metadata.hpp"
 #include "tria/log/sink.hpp"
@@ -28,50 +29,26 @@ constexpr auto ansiFgGrayColor() noexcept { return "\x1B[90m"; }
 
 class PrettySink final : public internal::FileSink {
 public:
-  PrettySink(std::FILE* fileHandle, bool closeFile, LevelMask mask, bool styleOutput) :
-      FileSink{fileHandle, closeFile, mask}, m_styleOutput{styleOutput} {
-
-    // Preallocate a buffer.
-    constexpr auto startingBufferSize = 1024;
-    m_buffer.reserve(startingBufferSize);
-  }
+  PrettySink(
+      std::FILE* fileHandle,
+      bool closeFile,
+      LevelMask mask,
+      FlushPolicy flushPolicy,
+      bool styleOutput) :
+      FileSink{fileHandle, closeFile, mask, flushPolicy}, m_styleOutput{styleOutput} {}
 
   ~PrettySink() override = default;
 
-  auto write(const Message& msg) noexcept -> void override {
+protected:
+  auto format(const Message& msg, std::string* out) noexcept -> void override {
     // Write time.
-    appendStyle(ansiFgGrayColor());
-    internal::writeIsoTime(&m_buffer, msg.getTime());
-    m_buffer.append(" ");
+    appendStyle(out, ansiFgGrayColor());
+    m_timeWriter.write(out, msg.getTime());
+    out->append(" ");
 
-    // Write level.
-    switch (msg.getMeta()->getLevel()) {
-    case Level::Debug:
-      appendStyle(ansiFgBlackColor());
-      appendStyle(ansiBgBlueColor());
-      break;
-    case Level::Info:
-      appendStyle(ansiFgBlackColor());
-      appendStyle(ansiBgGreenColor());
-      break;
-    case Level::Warn:
-      appendStyle(ansiFgBlackColor());
-      appendStyle(ansiBgYellowColor());
-      break;
-    case Level::Error:
-      appendStyle(ansiFgWhiteColor());
-      appendStyle(ansiBgRedColor());
-      break;
-    }
-    m_buffer.append("[");
-    m_buffer.append(getName(msg.getMeta()->getLevel()));
-    m_buffer.append("]");
-    appendStyle(ansiReset());
-
-    // Write text.
-    m_buffer.append(" ");
-    m_buffer.append(msg.getMeta()->getTxt());
-    m_buffer.append("\n");
+    // Write level and text.
+    out->append(m_metaCache.get(
+        msg.getMeta(), [this](const MetaData& meta) { return buildMetaLine(meta); }));
 
     if (msg.hasParams()) {
 
@@ -86,47 +63,77 @@ public:
       // Write parameters.
       for (const auto& param : msg) {
 
-        m_buffer.append("  ");
-        m_buffer.append(param.getKey());
-        m_buffer.append(": ");
+        out->append("  ");
+        out->append(param.getKey());
+        out->append(": ");
 
         // Pad all the parameters to align to the longest parameter.
         // Note this assumes that each character is the same size, so input has to be ascii.
-        writeSpaces(maxKeySize - param.getKey().size());
+        writeSpaces(out, maxKeySize - param.getKey().size());
 
-        appendStyle(ansiBold());
+        appendStyle(out, ansiBold());
 
-        param.writeValue(&m_buffer, ParamWriteMode::Pretty);
-        m_buffer.append("\n");
+        param.writeValue(out, ParamWriteMode::Pretty);
+        out->append("\n");
 
-        appendStyle(ansiReset());
+        appendStyle(out, ansiReset());
       }
     }
-
-    writeBuffer();
   }
 
 private:
-  std::string m_buffer;
   bool m_styleOutput;
+  internal::IsoTimeWriter m_timeWriter;
+  internal::MetaCache<std::string> m_metaCache; // Pre-formatted level and text per call-site.
+
+  [[nodiscard]] auto buildMetaLine(const MetaData& meta) const noexcept -> std::string {
+    auto result      = std::string{};
+    const auto style = [&](std::string_view styleStr) {
+      if (m_styleOutput) {
+        result.append(styleStr);
+      }
+    };
+    switch (meta.getLevel()) {
+    case Level::Debug:
+      style(ansiFgBlackColor());
+      style(ansiBgBlueColor());
+      break;
+    case Level::Info:
+      style(ansiFgBlackColor());
+      style(ansiBgGreenColor());
+      break;
+    case Level::Warn:
+      style(ansiFgBlackColor());
+      style(ansiBgYellowColor());
+      break;
+    case Level::Error:
+      style(ansiFgWhiteColor());
+      style(ansiBgRedColor());
+      break;
+    }
+    result.append("[");
+    result.append(getName(meta.getLevel()));
+    result.append("]");
+    style(ansiReset());
+
+    result.append(" ");
+    result.append(meta.getTxt());
+    result.append("\n");
+    return result;
+  }
 
   template <typename IntT>
-  auto writeSpaces(IntT amount) -> void {
+  auto writeSpaces(std::string* out, IntT amount) -> void {
     for (auto i = 0; i < static_cast<int>(amount); ++i) {
-      m_buffer.append(" ");
+      out->append(" ");
     }
   }
 
-  auto appendStyle(std::string_view styleStr) noexcept -> void {
+  auto appendStyle(std::string* out, std::string_view styleStr) noexcept -> void {
     if (m_styleOutput) {
-      m_buffer.append(styleStr);
+      out->append(styleStr);
     }
   }
-
-  auto writeBuffer() noexcept -> void {
-    writeToFile(m_buffer.data(), m_buffer.size());
-    m_buffer.clear();
-  }
 };
 
 auto makeConsolePrettySink(LevelMask mask) -> SinkUnique {
@@ -134,8 +141,14 @@ auto makeConsolePrettySink(LevelMask mask) -> SinkUnique {
   return internal::makeConsoleSink<PrettySink>(mask, isConsole);
 }
 
-auto makeFilePrettySink(fs::path path, LevelMask mask) -> SinkUnique {
-  return internal::makeFileSink<PrettySink>(std::move(path), mask, false);
+auto makeFilePrettySink(
+    fs::path path,
+    LevelMask mask,
+    FlushPolicy flushPolicy,
+    RotationPolicy rotationPolicy,
+    Compression compression) -> SinkUnique {
+  return internal::makeFileSink<PrettySink>(
+      std::move(path), false, mask, flushPolicy, rotationPolicy, compression, false);
 }
 
 } // namespace tria::log
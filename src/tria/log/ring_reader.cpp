@@ -0,0 +1,188 @@
+#include "tria/log/ring_reader.hpp"
+#include "internal/bin_decoder.hpp"
+#include "internal/ring_format.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include "tria/pal/mapped_file.hpp"
+#include <atomic>
+#include <cassert>
+
+namespace tria::log {
+
+class RingReader::Impl final {
+public:
+  explicit Impl(const fs::path& path) : m_tableRead{0U}, m_nextSeq{1U}, m_lost{0U} {
+    try {
+      m_file = pal::MappedFile::open(path, pal::MapMode::ReadOnly);
+    } catch (const pal::err::PlatformErr& e) {
+      throw err::LogDecodeErr{e.what()};
+    }
+    if (m_file.getSize() < sizeof(internal::RingHeader)) {
+      throw err::LogDecodeErr{"Not a shared ring log (file too small)"};
+    }
+    m_header = reinterpret_cast<const internal::RingHeader*>(m_file.getData());
+    if (m_header->magic != internal::g_ringMagic) {
+      throw err::LogDecodeErr{"Not a shared ring log (magic mismatch)"};
+    }
+    if (m_header->version != internal::g_ringVersion) {
+      throw err::LogDecodeErr{"Unsupported version: " + std::to_string(m_header->version)};
+    }
+    if (m_header->binVersion == 0U || m_header->binVersion > internal::g_binVersion) {
+      throw err::LogDecodeErr{
+          "Unsupported binary log version: " + std::to_string(m_header->binVersion)};
+    }
+    m_tableCapacity = m_header->tableCapacity;
+    m_ringCapacity  = m_header->ringCapacity;
+    if (m_ringCapacity == 0U || m_ringCapacity % internal::g_ringAlignment != 0U ||
+        sizeof(internal::RingHeader) + m_tableCapacity + m_ringCapacity != m_file.getSize()) {
+      throw err::LogDecodeErr{"Corrupt shared ring log header"};
+    }
+    m_table = m_file.getData() + sizeof(internal::RingHeader);
+    m_ring  = m_table + m_tableCapacity;
+    m_pos   = m_header->tail.load(std::memory_order_acquire);
+  }
+
+  auto poll(Sink* sink) -> size_t {
+    auto count = size_t{0};
+    while (true) {
+      const auto end = m_header->writeEnd.load(std::memory_order_acquire);
+      if (m_pos == end) {
+        return count;
+      }
+      if (end < m_pos) {
+        throw err::LogDecodeErr{"Corrupt shared ring log (sequence went backwards)"};
+      }
+      if (end - m_pos > m_ringCapacity) {
+        resync(); // Fell behind, the data at our position has been overwritten.
+        continue;
+      }
+      // The writer publishes the static data before the messages that reference it.
+      readTable();
+
+      const auto offset = m_pos % m_ringCapacity;
+      const auto header =
+          internal::readRingRecordHeader(m_ring + offset, m_ringCapacity - offset);
+      if (header.seq == 0U) {
+        // Padding marker: the next record starts at the beginning of the ring.
+        if (!validate()) {
+          resync();
+          continue;
+        }
+        m_pos += m_ringCapacity - offset;
+        continue;
+      }
+
+      const auto res = decodeRecord(offset, header);
+      if (!validate()) {
+        resync(); // Record was overwritten while decoding it, the result cannot be trusted.
+        continue;
+      }
+      if (!res) {
+        throw err::LogDecodeErr{"Corrupt shared ring log record"};
+      }
+      if (header.seq < m_nextSeq) {
+        throw err::LogDecodeErr{"Corrupt shared ring log (message sequence went backwards)"};
+      }
+      m_lost += header.seq - m_nextSeq;
+      m_nextSeq = header.seq + 1U;
+      m_pos += internal::ringRecordSize(header.size);
+
+      if (isInMask(sink->getMask(), m_msg.getMeta()->getLevel())) {
+        sink->write(m_msg);
+        ++count;
+      }
+    }
+  }
+
+  [[nodiscard]] auto getLostCount() const noexcept { return m_lost; }
+
+  [[nodiscard]] auto isWriterClosed() const noexcept {
+    return m_header->closed.load(std::memory_order_acquire) != 0U;
+  }
+
+private:
+  pal::MappedFile m_file;
+  const internal::RingHeader* m_header;
+  const uint8_t* m_table;
+  const uint8_t* m_ring;
+  uint64_t m_tableCapacity;
+  uint64_t m_ringCapacity;
+  uint64_t m_tableRead;
+  uint64_t m_pos;
+  uint64_t m_nextSeq;
+  uint64_t m_lost;
+  internal::BinDecoder m_decoder;
+  Message m_msg;
+
+  /* Decode the static records that were added to the table since the last read.
+   */
+  auto readTable() -> void {
+    const auto tableSize = m_header->tableSize.load(std::memory_order_acquire);
+    if (tableSize > m_tableCapacity) {
+      throw err::LogDecodeErr{"Corrupt shared ring log (table size out of bounds)"};
+    }
+    auto cursor = internal::BinCursor{m_table + m_tableRead, m_table + tableSize};
+    while (cursor.getRemaining() != 0U) {
+      // Table is append-only and the size is only published after the records are complete.
+      if (m_decoder.decodeRecord(&cursor, &m_msg) != internal::BinDecodeResult::Record) {
+        throw err::LogDecodeErr{"Corrupt shared ring log table"};
+      }
+    }
+    m_tableRead = tableSize;
+  }
+
+  /* Decode the message record into 'm_msg'.
+   * Returns false if the record is invalid, which is expected when it was overwritten while it was
+   * being decoded (so the result has to be validated afterwards).
+   */
+  auto decodeRecord(uint64_t offset, internal::RingRecordHeader header) noexcept -> bool {
+    if (header.size == 0U || offset + internal::ringRecordSize(header.size) > m_ringCapacity) {
+      return false;
+    }
+    const auto* data = m_ring + offset + internal::g_ringRecordHeaderSize;
+    if (*data != static_cast<uint8_t>(internal::BinRecordKind::Message)) {
+      return false; // Static records are not allowed in the ring.
+    }
+    auto cursor = internal::BinCursor{data, data + header.size};
+    try {
+      return m_decoder.decodeRecord(&cursor, &m_msg) == internal::BinDecodeResult::Message &&
+          cursor.getRemaining() == 0U;
+    } catch (const err::LogDecodeErr&) {
+      return false;
+    } catch (const std::bad_alloc&) {
+      return false;
+    }
+  }
+
+  /* Check that the record at the current position was not overwritten while reading it.
+   */
+  [[nodiscard]] auto validate() const noexcept -> bool {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto writeBegin = m_header->writeBegin.load(std::memory_order_relaxed);
+    return writeBegin - m_pos <= m_ringCapacity;
+  }
+
+  /* Continue at the oldest record that is still in the ring.
+   */
+  auto resync() noexcept -> void {
+    const auto tail = m_header->tail.load(std::memory_order_acquire);
+    if (tail > m_pos) {
+      m_pos = tail;
+    }
+  }
+};
+
+RingReader::RingReader(const fs::path& path) : m_impl{std::make_unique<Impl>(path)} {}
+
+RingReader::~RingReader() = default;
+
+auto RingReader::poll(Sink* sink) -> size_t {
+  assert(sink);
+  return m_impl->poll(sink);
+}
+
+auto RingReader::getLostCount() const noexcept -> uint64_t { return m_impl->getLostCount(); }
+
+auto RingReader::isWriterClosed() const noexcept -> bool { return m_impl->isWriterClosed(); }
+
+} // namespace tria::log
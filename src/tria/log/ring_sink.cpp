@@ -0,0 +1,144 @@
+#include "internal/bin_encoder.hpp"
+#include "internal/ring_format.hpp"
+#include "tria/log/err/log_file_err.hpp"
+#include "tria/log/sink.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include "tria/pal/mapped_file.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace tria::log {
+
+namespace {
+
+// Smallest supported ring, the largest message is limited to a quarter of the ring.
+constexpr size_t g_minRingCapacity   = 4U * 1024U;
+constexpr size_t g_maxRecordFraction = 4U;
+
+} // namespace
+
+/*
+ * Sink that publishes messages into a shared ring buffer file (see 'internal/ring_format.hpp').
+ * Messages are encoded in the binary log format, the static data goes into the (append-only)
+ * metadata table and the message records into the ring.
+ * Publishing a message does not involve any system calls, it is a copy into the mapping and a few
+ * atomic stores, the os writes the mapping back to the file in the background.
+ *
+ * Messages that do not fit (static data that exceeds the remaining table space or messages larger
+ * than a quarter of the ring) are dropped, readers see them as lost messages.
+ */
+class RingSink final : public Sink {
+public:
+  RingSink(pal::MappedFile file, LevelMask mask, size_t tableCapacity, size_t ringCapacity) :
+      Sink{mask},
+      m_file{std::move(file)},
+      m_header{new (m_file.getData()) internal::RingHeader{}},
+      m_table{m_file.getData() + sizeof(internal::RingHeader)},
+      m_ring{m_table + tableCapacity},
+      m_tableCapacity{tableCapacity},
+      m_ringCapacity{ringCapacity},
+      m_tableSize{0U},
+      m_writePos{0U},
+      m_tail{0U},
+      m_seq{0U} {
+    m_header->magic         = internal::g_ringMagic;
+    m_header->version       = internal::g_ringVersion;
+    m_header->binVersion    = internal::g_binVersion;
+    m_header->tableCapacity = tableCapacity;
+    m_header->ringCapacity  = ringCapacity;
+  }
+  ~RingSink() override { m_header->closed.store(1U, std::memory_order_release); }
+
+  auto write(const Message& msg) noexcept -> void override {
+    ++m_seq;
+
+    m_staticBuffer.clear();
+    m_msgBuffer.clear();
+    const auto mark = m_encoder.getMark();
+    m_encoder.encodeStatic(msg, &m_staticBuffer);
+    m_encoder.encodeMessage(msg, &m_msgBuffer);
+
+    const auto recordSize = internal::ringRecordSize(m_msgBuffer.size());
+    if (m_staticBuffer.size() > m_tableCapacity - m_tableSize ||
+        recordSize > m_ringCapacity / g_maxRecordFraction) {
+      // Message is dropped, the static data has to be written again when it is used next time.
+      m_encoder.rollback(mark);
+      return;
+    }
+
+    if (!m_staticBuffer.empty()) {
+      std::memcpy(m_table + m_tableSize, m_staticBuffer.data(), m_staticBuffer.size());
+      m_tableSize += m_staticBuffer.size();
+      m_header->tableSize.store(m_tableSize, std::memory_order_release);
+    }
+
+    // Records do not wrap, pad to the end of the ring if the record does not fit before it.
+    const auto offset  = m_writePos % m_ringCapacity;
+    const auto padding = offset + recordSize > m_ringCapacity ? m_ringCapacity - offset : 0U;
+    const auto end     = m_writePos + padding + recordSize;
+
+    // Move the tail past the records that are about to be overwritten.
+    while (end - m_tail > m_ringCapacity) {
+      m_tail += getRecordSpan(m_tail);
+    }
+    m_header->tail.store(m_tail, std::memory_order_release);
+
+    // Announce the region that is going to be overwritten before touching it, readers use this to
+    // detect records that were overwritten while they were reading them.
+    m_header->writeBegin.store(end, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (padding != 0U) {
+      const auto paddingSeq = uint64_t{0U};
+      std::memcpy(m_ring + offset, &paddingSeq, sizeof(paddingSeq));
+    }
+    auto* record = m_ring + (m_writePos + padding) % m_ringCapacity;
+    internal::writeRingRecordHeader(record, {m_seq, static_cast<uint32_t>(m_msgBuffer.size())});
+    std::memcpy(
+        record + internal::g_ringRecordHeaderSize, m_msgBuffer.data(), m_msgBuffer.size());
+
+    m_writePos = end;
+    m_header->writeEnd.store(end, std::memory_order_release);
+  }
+
+private:
+  pal::MappedFile m_file;
+  internal::RingHeader* m_header;
+  uint8_t* m_table;
+  uint8_t* m_ring;
+  uint64_t m_tableCapacity;
+  uint64_t m_ringCapacity;
+  uint64_t m_tableSize;
+  uint64_t m_writePos;
+  uint64_t m_tail;
+  uint64_t m_seq;
+  internal::BinEncoder m_encoder;
+  std::string m_staticBuffer;
+  std::string m_msgBuffer;
+
+  /* Amount of ring bytes that the record (or padding) at the given position takes up.
+   */
+  [[nodiscard]] auto getRecordSpan(uint64_t pos) const noexcept -> uint64_t {
+    const auto offset = pos % m_ringCapacity;
+    const auto header = internal::readRingRecordHeader(m_ring + offset, m_ringCapacity - offset);
+    return header.seq == 0U ? m_ringCapacity - offset : internal::ringRecordSize(header.size);
+  }
+};
+
+auto makeSharedRingSink(fs::path path, LevelMask mask, size_t ringSize, size_t tableSize)
+    -> SinkUnique {
+  const auto ringCapacity  = internal::ringAlign(std::max(ringSize, g_minRingCapacity));
+  const auto tableCapacity = internal::ringAlign(tableSize);
+  const auto fileSize      = sizeof(internal::RingHeader) + tableCapacity + ringCapacity;
+  try {
+    auto file = pal::MappedFile::create(path, fileSize);
+    return std::make_unique<RingSink>(std::move(file), mask, tableCapacity, ringCapacity);
+  } catch (const pal::err::PlatformErr& e) {
+    throw err::LogFileErr{path, e.what()};
+  }
+}
+
+} // namespace tria::log
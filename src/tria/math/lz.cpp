@@ -0,0 +1,258 @@
+#include "tria/math/lz.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace tria::math {
+
+/*
+ * LZ4 block format, a block is a series of sequences:
+ * - Token byte: high 4 bits literal count, low 4 bits match length (minus 'g_minMatch'). A value
+ *   of 15 means the length continues in the next bytes (each byte is added, until a byte != 255).
+ * - Literal bytes.
+ * - Match offset (2 bytes, little-endian) and the length continuation bytes.
+ * The last sequence only contains literals. To allow for fast decoding the last 5 bytes of a block
+ * are always literals and the last match has to start atleast 12 bytes before the end.
+ */
+
+namespace {
+
+constexpr auto g_hashBits     = 13U;
+constexpr size_t g_minMatch   = 4U;
+constexpr size_t g_lastLits   = 5U;  // Last bytes of a block are always literals.
+constexpr size_t g_matchLimit = 12U; // No matches can start in the last bytes of a block.
+constexpr size_t g_maxOffset  = 65535U;
+constexpr auto g_skipTrigger  = 6U; // Skip faster after '2 ^ g_skipTrigger' failed searches.
+
+[[nodiscard]] auto read32(const uint8_t* ptr) noexcept -> uint32_t {
+  uint32_t result;
+  std::memcpy(&result, ptr, sizeof(result));
+  return result;
+}
+
+[[nodiscard]] auto read64(const uint8_t* ptr) noexcept -> uint64_t {
+  uint64_t result;
+  std::memcpy(&result, ptr, sizeof(result));
+  return result;
+}
+
+[[nodiscard]] auto hash(uint32_t value) noexcept -> uint32_t {
+  // Knuth's multiplicative hash, the high bits are the best mixed.
+  return (value * 2654435761U) >> (32U - g_hashBits);
+}
+
+/* Count the amount of equal bytes, comparing 8 bytes at a time.
+ */
+[[nodiscard]] auto countMatch(const uint8_t* a, const uint8_t* b, const uint8_t* aEnd) noexcept
+    -> size_t {
+  const auto* start = a;
+  while (a + sizeof(uint64_t) <= aEnd && read64(a) == read64(b)) {
+    a += sizeof(uint64_t);
+    b += sizeof(uint64_t);
+  }
+  while (a != aEnd && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return static_cast<size_t>(a - start);
+}
+
+auto writeLength(uint8_t** out, size_t length) noexcept {
+  for (; length >= 255U; length -= 255U) {
+    *(*out)++ = 255U;
+  }
+  *(*out)++ = static_cast<uint8_t>(length);
+}
+
+/* Write a sequence, a 'matchLength' of 0 writes a literals only sequence (end of the block).
+ */
+auto writeSequence(
+    uint8_t** out, const uint8_t* lits, size_t litCount, size_t offset, size_t matchLength) {
+  auto* token = (*out)++;
+  if (litCount >= 15U) {
+    *token = 15U << 4U;
+    writeLength(out, litCount - 15U);
+  } else {
+    *token = static_cast<uint8_t>(litCount << 4U);
+  }
+  if (litCount != 0U) {
+    std::memcpy(*out, lits, litCount);
+    *out += litCount;
+  }
+
+  if (matchLength == 0U) {
+    return;
+  }
+  *(*out)++ = static_cast<uint8_t>(offset);
+  *(*out)++ = static_cast<uint8_t>(offset >> 8U);
+  const auto length = matchLength - g_minMatch;
+  if (length >= 15U) {
+    *token |= 15U;
+    writeLength(out, length - 15U);
+  } else {
+    *token |= static_cast<uint8_t>(length);
+  }
+}
+
+[[nodiscard]] auto readLength(const uint8_t** in, const uint8_t* inEnd, size_t* length) noexcept
+    -> bool {
+  uint8_t byte;
+  do {
+    if (*in == inEnd) {
+      return false;
+    }
+    byte = *(*in)++;
+    *length += byte;
+  } while (byte == 255U);
+  return true;
+}
+
+} // namespace
+
+LzCompressor::LzCompressor() : m_table(size_t{1U} << g_hashBits) {
+  m_window.reserve(g_lzWindowSize * 2U);
+}
+
+auto LzCompressor::reset() noexcept -> void {
+  m_window.clear();
+  std::fill(m_table.begin(), m_table.end(), 0U);
+}
+
+auto LzCompressor::compress(const uint8_t* data, size_t size, uint8_t* out) noexcept -> size_t {
+  // Only keep the previous data that matches can still reference.
+  if (m_window.size() > g_lzWindowSize) {
+    const auto shift = static_cast<uint32_t>(m_window.size() - g_lzWindowSize);
+    m_window.erase(m_window.begin(), m_window.begin() + shift);
+    for (auto& entry : m_table) {
+      // Positions that are no longer in the window are reset to the start, they are validated
+      // before they are used anyway.
+      entry = entry >= shift ? entry - shift : 0U;
+    }
+  }
+  const auto blockStart = m_window.size();
+  m_window.insert(m_window.end(), data, data + size);
+
+  const auto* base   = m_window.data();
+  const auto* in     = base + blockStart;
+  const auto* inEnd  = in + size;
+  const auto* anchor = in; // Start of the literals that have not been written yet.
+  auto* outItr       = out;
+
+  if (size > g_matchLimit) {
+    const auto* searchLimit = inEnd - g_matchLimit;
+    const auto* matchLimit  = inEnd - g_lastLits;
+    auto misses             = 0U;
+    while (in < searchLimit) {
+      const auto seq   = read32(in);
+      auto& entry      = m_table[hash(seq)];
+      const auto* ref  = base + entry;
+      entry            = static_cast<uint32_t>(in - base);
+      const auto found = ref < in && static_cast<size_t>(in - ref) <= g_maxOffset &&
+          read32(ref) == seq;
+      if (!found) {
+        // Data is not compressing well, move ahead faster the longer this takes.
+        in += 1U + (misses++ >> g_skipTrigger);
+        continue;
+      }
+      // Extend the match backwards into the pending literals.
+      while (in > anchor && ref > base && in[-1] == ref[-1]) {
+        --in;
+        --ref;
+      }
+      const auto length = g_minMatch + countMatch(in + g_minMatch, ref + g_minMatch, matchLimit);
+      writeSequence(&outItr, anchor, in - anchor, in - ref, length);
+
+      in += length;
+      anchor = in;
+      misses = 0U;
+      if (in < searchLimit) {
+        // Register a position inside the match, improves matching repeating data.
+        m_table[hash(read32(in - 2U))] = static_cast<uint32_t>(in - 2U - base);
+      }
+    }
+  }
+  writeSequence(&outItr, anchor, inEnd - anchor, 0U, 0U);
+  return static_cast<size_t>(outItr - out);
+}
+
+auto LzDecompressor::reset() noexcept -> void { m_window.clear(); }
+
+auto LzDecompressor::decompress(const uint8_t* data, size_t size, size_t rawSize) noexcept
+    -> const uint8_t* {
+  if (rawSize == 0U) {
+    // Empty block: only a token without literals, does not add anything to the window.
+    if (size != 1U || data[0] != 0U) {
+      m_window.clear();
+      return nullptr;
+    }
+    return data;
+  }
+  // Only keep the previous data that matches can still reference.
+  if (m_window.size() > g_lzWindowSize) {
+    m_window.erase(m_window.begin(), m_window.end() - g_lzWindowSize);
+  }
+  const auto blockStart = m_window.size();
+  m_window.resize(blockStart + rawSize);
+
+  auto* base        = m_window.data();
+  auto* out         = base + blockStart;
+  auto* outEnd      = out + rawSize;
+  const auto* in    = data;
+  const auto* inEnd = data + size;
+  const auto fail   = [this]() {
+    m_window.clear();
+    return nullptr;
+  };
+  while (true) {
+    if (in == inEnd) {
+      return fail();
+    }
+    const auto token = *in++;
+    auto litCount    = static_cast<size_t>(token >> 4U);
+    if (litCount == 15U && !readLength(&in, inEnd, &litCount)) {
+      return fail();
+    }
+    if (litCount > static_cast<size_t>(inEnd - in) ||
+        litCount > static_cast<size_t>(outEnd - out)) {
+      return fail();
+    }
+    if (litCount != 0U) {
+      std::memcpy(out, in, litCount);
+      in += litCount;
+      out += litCount;
+    }
+    if (in == inEnd) {
+      break; // Last sequence only contains literals.
+    }
+
+    if (inEnd - in < 2) {
+      return fail();
+    }
+    const auto offset = static_cast<size_t>(in[0]) | static_cast<size_t>(in[1]) << 8U;
+    in += 2;
+    auto length = static_cast<size_t>(token & 15U);
+    if (length == 15U && !readLength(&in, inEnd, &length)) {
+      return fail();
+    }
+    length += g_minMatch;
+    if (offset == 0U || offset > static_cast<size_t>(out - base) ||
+        length > static_cast<size_t>(outEnd - out)) {
+      return fail();
+    }
+    const auto* match = out - offset;
+    if (offset >= length) {
+      std::memcpy(out, match, length);
+    } else {
+      // Overlapping match (repeating pattern), has to be copied front to back.
+      for (auto i = 0U; i != length; ++i) {
+        out[i] = match[i];
+      }
+    }
+    out += length;
+  }
+  if (out != outEnd) {
+    return fail();
+  }
+  return base + blockStart;
+}
+
+} // namespace tria::math
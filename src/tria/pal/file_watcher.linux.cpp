@@ -0,0 +1,157 @@
+#include "tria/pal/file_watcher.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace tria::pal {
+
+namespace {
+
+// Files are reported once they are closed after writing or moved into place (which is how most
+// editors save), sub-directories are reported when they are created so they can be watched too.
+constexpr uint32_t g_watchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+[[noreturn]] auto throwPlatformErr(std::string_view action, const fs::path& path) {
+  const auto errNum = errno;
+  throw err::PlatformErr{static_cast<unsigned long>(errNum),
+                         std::string{action} + " '" + path.string() + "': " +
+                             std::strerror(errNum)};
+}
+
+} // namespace
+
+/*
+ * Inotify based file watcher.
+ * Inotify does not support watching recursively, so every sub-directory gets its own watch.
+ */
+class NativeFileWatcher final {
+public:
+  explicit NativeFileWatcher(fs::path rootPath) : m_rootPath{std::move(rootPath)} {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+      throwPlatformErr("Failed to create file watcher", m_rootPath);
+    }
+    try {
+      watchDir({}, nullptr);
+    } catch (...) {
+      close(m_fd);
+      throw;
+    }
+  }
+  NativeFileWatcher(const NativeFileWatcher& rhs) = delete;
+  NativeFileWatcher(NativeFileWatcher&& rhs)      = delete;
+  ~NativeFileWatcher() { close(m_fd); }
+
+  auto operator=(const NativeFileWatcher& rhs) -> NativeFileWatcher& = delete;
+  auto operator=(NativeFileWatcher&& rhs) -> NativeFileWatcher& = delete;
+
+  [[nodiscard]] auto poll(bool* overflowed) -> std::vector<fs::path> {
+    auto result = std::vector<fs::path>{};
+    *overflowed = false;
+
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    while (true) {
+      const auto size = read(m_fd, buffer.data(), buffer.size());
+      if (size < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          break; // No more events queued.
+        }
+        throwPlatformErr("Failed to read file changes", m_rootPath);
+      }
+      for (auto offset = 0; offset < size;) {
+        const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+        offset += static_cast<int>(sizeof(inotify_event) + event->len);
+        if (event->mask & IN_Q_OVERFLOW) {
+          *overflowed = true;
+        } else {
+          handleEvent(*event, &result);
+        }
+      }
+    }
+
+    if (*overflowed) {
+      // Changes were lost: report all files, also watches directories that were created meanwhile.
+      // Note: Watching an already watched directory returns the existing watch.
+      result.clear();
+      watchDir({}, &result);
+    }
+
+    // Saving a file can produce multiple events, report each file only once.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+private:
+  int m_fd;
+  fs::path m_rootPath;
+  std::unordered_map<int, fs::path> m_dirs; // Watch descriptor to directory (relative to root).
+
+  /* Watch a directory and all its sub-directories.
+   * Existing files are added to 'files' (if provided), used for directories that were created
+   * after watching started as their files could have been written before the watch was added.
+   */
+  auto watchDir(const fs::path& dir, std::vector<fs::path>* files) -> void {
+    const auto absDir = m_rootPath / dir;
+    const auto wd     = inotify_add_watch(m_fd, absDir.c_str(), g_watchMask);
+    if (wd < 0) {
+      if (dir.empty()) {
+        throwPlatformErr("Failed to watch directory", absDir);
+      }
+      return; // Sub-directory was removed in the mean time.
+    }
+    m_dirs[wd] = dir;
+
+    auto err = std::error_code{};
+    for (auto itr = fs::directory_iterator{absDir, err}; !err && itr != fs::directory_iterator{};
+         itr.increment(err)) {
+      const auto path = dir / itr->path().filename();
+      if (itr->is_directory(err)) {
+        watchDir(path, files);
+      } else if (files) {
+        files->push_back(path);
+      }
+    }
+  }
+
+  auto handleEvent(const inotify_event& event, std::vector<fs::path>* files) -> void {
+    if (event.mask & IN_IGNORED) {
+      m_dirs.erase(event.wd); // Watched directory was removed.
+      return;
+    }
+    const auto dirItr = m_dirs.find(event.wd);
+    if (dirItr == m_dirs.end() || event.len == 0U) {
+      return;
+    }
+    const auto path = dirItr->second / event.name;
+    if (event.mask & IN_ISDIR) {
+      if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+        watchDir(path, files);
+      }
+      return;
+    }
+    if (event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+      files->push_back(path);
+    }
+  }
+};
+
+FileWatcher::FileWatcher(const fs::path& rootPath) :
+    m_native{std::make_unique<NativeFileWatcher>(rootPath)} {}
+
+FileWatcher::~FileWatcher() = default;
+
+auto FileWatcher::poll(bool* overflowed) -> std::vector<fs::path> {
+  return m_native->poll(overflowed);
+}
+
+} // namespace tria::pal
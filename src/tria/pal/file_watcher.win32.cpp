@@ -0,0 +1,150 @@
+#include "tria/pal/file_watcher.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <windows.h>
+
+namespace tria::pal {
+
+namespace {
+
+// Files are reported when they are written, created or renamed (which is how most editors save).
+constexpr DWORD g_notifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+[[noreturn]] auto throwPlatformErr(std::string_view action, const fs::path& path) {
+  const auto errCode = GetLastError();
+  throw err::PlatformErr{errCode,
+                         std::string{action} + " '" + path.string() +
+                             "' (error: " + std::to_string(errCode) + ")"};
+}
+
+} // namespace
+
+/*
+ * File watcher based on overlapped 'ReadDirectoryChangesW' calls.
+ * A read is always outstanding, the os fills the buffer with changes until it is polled.
+ */
+class NativeFileWatcher final {
+public:
+  explicit NativeFileWatcher(fs::path rootPath) : m_rootPath{std::move(rootPath)}, m_overlapped{} {
+    const auto share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    m_dir            = CreateFileW(
+        m_rootPath.c_str(),
+        FILE_LIST_DIRECTORY,
+        share,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr);
+    if (m_dir == INVALID_HANDLE_VALUE) {
+      throwPlatformErr("Failed to open directory", m_rootPath);
+    }
+    m_overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!m_overlapped.hEvent) {
+      CloseHandle(m_dir);
+      throwPlatformErr("Failed to create file watcher", m_rootPath);
+    }
+    if (!beginRead()) {
+      CloseHandle(m_overlapped.hEvent);
+      CloseHandle(m_dir);
+      throwPlatformErr("Failed to watch directory", m_rootPath);
+    }
+  }
+  NativeFileWatcher(const NativeFileWatcher& rhs) = delete;
+  NativeFileWatcher(NativeFileWatcher&& rhs)      = delete;
+  ~NativeFileWatcher() {
+    // Wait for the outstanding read to be cancelled, the os could otherwise still write to it.
+    CancelIo(m_dir);
+    DWORD bytes;
+    GetOverlappedResult(m_dir, &m_overlapped, &bytes, TRUE);
+    CloseHandle(m_overlapped.hEvent);
+    CloseHandle(m_dir);
+  }
+
+  auto operator=(const NativeFileWatcher& rhs) -> NativeFileWatcher& = delete;
+  auto operator=(NativeFileWatcher&& rhs) -> NativeFileWatcher& = delete;
+
+  [[nodiscard]] auto poll(bool* overflowed) -> std::vector<fs::path> {
+    auto result = std::vector<fs::path>{};
+    *overflowed = false;
+
+    DWORD bytes;
+    while (GetOverlappedResult(m_dir, &m_overlapped, &bytes, FALSE)) {
+      // Note: Zero bytes means the buffer overflowed, the changes in it are lost.
+      *overflowed |= bytes == 0U;
+      for (auto offset = DWORD{0}; bytes != 0U;) {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(
+            m_buffer.data() + offset);
+        if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+            info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+          const auto path = fs::path{std::wstring{
+              info->FileName, info->FileName + info->FileNameLength / sizeof(WCHAR)}};
+          // Directories are watched recursively, changes to them are not interesting.
+          auto err = std::error_code{};
+          if (fs::is_regular_file(m_rootPath / path, err)) {
+            result.push_back(path);
+          }
+        }
+        if (info->NextEntryOffset == 0U) {
+          break;
+        }
+        offset += info->NextEntryOffset;
+      }
+      ResetEvent(m_overlapped.hEvent);
+      if (!beginRead()) {
+        throwPlatformErr("Failed to watch directory", m_rootPath);
+      }
+    }
+    if (GetLastError() != ERROR_IO_INCOMPLETE) {
+      throwPlatformErr("Failed to read file changes", m_rootPath);
+    }
+
+    if (*overflowed) {
+      // Changes were lost: report all files.
+      result.clear();
+      auto err = std::error_code{};
+      for (auto itr = fs::recursive_directory_iterator{m_rootPath, err};
+           !err && itr != fs::recursive_directory_iterator{};
+           itr.increment(err)) {
+        if (itr->is_regular_file(err)) {
+          result.push_back(fs::relative(itr->path(), m_rootPath, err));
+        }
+      }
+    }
+
+    // Saving a file can produce multiple notifications, report each file only once.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+private:
+  fs::path m_rootPath;
+  HANDLE m_dir;
+  OVERLAPPED m_overlapped;
+  alignas(DWORD) std::array<uint8_t, 64 * 1024> m_buffer;
+
+  [[nodiscard]] auto beginRead() noexcept -> bool {
+    return ReadDirectoryChangesW(
+               m_dir,
+               m_buffer.data(),
+               static_cast<DWORD>(m_buffer.size()),
+               TRUE,
+               g_notifyFilter,
+               nullptr,
+               &m_overlapped,
+               nullptr) != 0;
+  }
+};
+
+FileWatcher::FileWatcher(const fs::path& rootPath) :
+    m_native{std::make_unique<NativeFileWatcher>(rootPath)} {}
+
+FileWatcher::~FileWatcher() = default;
+
+auto FileWatcher::poll(bool* overflowed) -> std::vector<fs::path> {
+  return m_native->poll(overflowed);
+}
+
+} // namespace tria::pal
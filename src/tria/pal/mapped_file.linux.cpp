@@ -0,0 +1,101 @@
+#include "tria/pal/mapped_file.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tria::pal {
+
+namespace {
+
+/* Throw an error for the current 'errno', closes the given file descriptor (if any) afterwards as
+ * closing can overwrite 'errno'.
+ */
+[[noreturn]] auto throwPlatformErr(std::string_view action, const fs::path& path, int fd = -1) {
+  const auto errNum = errno;
+  if (fd >= 0) {
+    close(fd);
+  }
+  throw err::PlatformErr{static_cast<unsigned long>(errNum),
+                         std::string{action} + " '" + path.string() + "': " +
+                             std::strerror(errNum)};
+}
+
+[[nodiscard]] auto mapFd(int fd, size_t size, MapMode mode, const fs::path& path) -> uint8_t* {
+  if (size == 0U) {
+    return nullptr; // Empty files cannot be mapped.
+  }
+  const auto prot = mode == MapMode::ReadWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+  auto* data      = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    throwPlatformErr("Failed to map file", path, fd);
+  }
+  // The mapping keeps a reference to the file, so the descriptor is no longer needed.
+  close(fd);
+  return static_cast<uint8_t*>(data);
+}
+
+} // namespace
+
+auto MappedFile::open(const fs::path& path, MapMode mode) -> MappedFile {
+  const auto fd = ::open(path.c_str(), mode == MapMode::ReadWrite ? O_RDWR : O_RDONLY);
+  if (fd < 0) {
+    throwPlatformErr("Failed to open file", path);
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    throwPlatformErr("Failed to query file", path, fd);
+  }
+  const auto size = static_cast<size_t>(fileStat.st_size);
+  if (size == 0U) {
+    close(fd);
+    return MappedFile{};
+  }
+  return MappedFile{mapFd(fd, size, mode, path), size};
+}
+
+auto MappedFile::create(const fs::path& path, size_t size) -> MappedFile {
+  // Unlink instead of truncating, other processes can still be mapping the old file.
+  unlink(path.c_str());
+
+  const auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    throwPlatformErr("Failed to create file", path);
+  }
+  // Growing the file fills it with zeroes.
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    throwPlatformErr("Failed to resize file", path, fd);
+  }
+  if (size == 0U) {
+    close(fd);
+    return MappedFile{};
+  }
+  return MappedFile{mapFd(fd, size, MapMode::ReadWrite, path), size};
+}
+
+MappedFile::~MappedFile() noexcept { unmap(); }
+
+auto MappedFile::operator=(MappedFile&& rhs) noexcept -> MappedFile& {
+  if (this != &rhs) {
+    unmap();
+    m_data     = rhs.m_data;
+    m_size     = rhs.m_size;
+    rhs.m_data = nullptr;
+    rhs.m_size = 0U;
+  }
+  return *this;
+}
+
+auto MappedFile::unmap() noexcept -> void {
+  if (m_data) {
+    munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0U;
+  }
+}
+
+} // namespace tria::pal
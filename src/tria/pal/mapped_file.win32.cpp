@@ -0,0 +1,108 @@
+#include "tria/pal/mapped_file.hpp"
+#include "tria/pal/err/platform_err.hpp"
+#include <string>
+#include <windows.h>
+
+namespace tria::pal {
+
+namespace {
+
+[[noreturn]] auto throwPlatformErr(std::string_view action, const fs::path& path) {
+  const auto errCode = GetLastError();
+  throw err::PlatformErr{errCode,
+                         std::string{action} + " '" + path.string() +
+                             "' (error: " + std::to_string(errCode) + ")"};
+}
+
+[[nodiscard]] auto openFile(const fs::path& path, DWORD access, DWORD creation) -> HANDLE {
+  // Allow other processes to map (and this process to replace) the file while it is open.
+  const auto share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+  return CreateFileW(
+      path.c_str(), access, share, nullptr, creation, FILE_ATTRIBUTE_NORMAL, nullptr);
+}
+
+[[nodiscard]] auto mapHandle(HANDLE file, size_t size, MapMode mode, const fs::path& path)
+    -> uint8_t* {
+  const auto protect = mode == MapMode::ReadWrite ? PAGE_READWRITE : PAGE_READONLY;
+  auto mapping       = CreateFileMappingW(file, nullptr, protect, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    throwPlatformErr("Failed to map file", path);
+  }
+  const auto access = mode == MapMode::ReadWrite ? FILE_MAP_WRITE : FILE_MAP_READ;
+  auto* data        = MapViewOfFile(mapping, access, 0, 0, size);
+
+  // The view keeps a reference to the mapping (and file), so the handles are no longer needed.
+  CloseHandle(mapping);
+  CloseHandle(file);
+  if (!data) {
+    throwPlatformErr("Failed to map file", path);
+  }
+  return static_cast<uint8_t*>(data);
+}
+
+} // namespace
+
+auto MappedFile::open(const fs::path& path, MapMode mode) -> MappedFile {
+  const auto access = mode == MapMode::ReadWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+  auto file         = openFile(path, access, OPEN_EXISTING);
+  if (file == INVALID_HANDLE_VALUE) {
+    throwPlatformErr("Failed to open file", path);
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    CloseHandle(file);
+    throwPlatformErr("Failed to query file", path);
+  }
+  const auto size = static_cast<size_t>(fileSize.QuadPart);
+  if (size == 0U) {
+    CloseHandle(file);
+    return MappedFile{}; // Empty files cannot be mapped.
+  }
+  return MappedFile{mapHandle(file, size, mode, path), size};
+}
+
+auto MappedFile::create(const fs::path& path, size_t size) -> MappedFile {
+  // Delete instead of truncating, other processes can still be mapping the old file.
+  DeleteFileW(path.c_str());
+
+  auto file = openFile(path, GENERIC_READ | GENERIC_WRITE, CREATE_NEW);
+  if (file == INVALID_HANDLE_VALUE) {
+    throwPlatformErr("Failed to create file", path);
+  }
+  // Growing the file fills it with zeroes.
+  LARGE_INTEGER fileSize;
+  fileSize.QuadPart = static_cast<LONGLONG>(size);
+  if (!SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+    CloseHandle(file);
+    throwPlatformErr("Failed to resize file", path);
+  }
+  if (size == 0U) {
+    CloseHandle(file);
+    return MappedFile{};
+  }
+  return MappedFile{mapHandle(file, size, MapMode::ReadWrite, path), size};
+}
+
+MappedFile::~MappedFile() noexcept { unmap(); }
+
+auto MappedFile::operator=(MappedFile&& rhs) noexcept -> MappedFile& {
+  if (this != &rhs) {
+    unmap();
+    m_data     = rhs.m_data;
+    m_size     = rhs.m_size;
+    rhs.m_data = nullptr;
+    rhs.m_size = 0U;
+  }
+  return *this;
+}
+
+auto MappedFile::unmap() noexcept -> void {
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+    m_data = nullptr;
+    m_size = 0U;
+  }
+}
+
+} // namespace tria::pal
@@ -2,7 +2,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <pthread.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 namespace tria::pal {
@@ -59,4 +61,21 @@ auto setThreadName(std::string_view name) noexcept -> bool {
   return result;
 }
 
+auto preallocateFile(std::FILE* file, uint64_t size) noexcept -> bool {
+  // 'FALLOC_FL_KEEP_SIZE' allocates the blocks without moving the end of the file.
+  return fallocate(fileno(file), FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) == 0;
+}
+
+auto trimFile(std::FILE* file) noexcept -> bool {
+  if (std::fflush(file) != 0) {
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fileno(file), &fileStat) != 0) {
+    return false;
+  }
+  // Truncating to the current size releases the blocks that were reserved beyond the end.
+  return ftruncate(fileno(file), fileStat.st_size) == 0;
+}
+
 } // namespace tria::pal
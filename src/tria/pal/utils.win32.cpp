@@ -1,6 +1,7 @@
 #include "tria/pal/utils.hpp"
 #include <array>
 #include <codecvt>
+#include <io.h>
 #include <locale>
 #include <string_view>
 #include <windows.h>
@@ -96,4 +97,30 @@ auto setThreadName(std::string_view /*unused*/) noexcept -> bool { return false;
 
 #endif
 
+auto preallocateFile(std::FILE* file, uint64_t size) noexcept -> bool {
+  auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+  if (handle == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  // Setting the allocation size reserves the space without changing the end of the file.
+  FILE_ALLOCATION_INFO info;
+  info.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+  return SetFileInformationByHandle(handle, FileAllocationInfo, &info, sizeof(info));
+}
+
+auto trimFile(std::FILE* file) noexcept -> bool {
+  if (std::fflush(file) != 0) {
+    return false;
+  }
+  auto handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+  LARGE_INTEGER size;
+  if (handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(handle, &size)) {
+    return false;
+  }
+  // Shrinking the allocation size to the file size releases the reserved space.
+  FILE_ALLOCATION_INFO info;
+  info.AllocationSize = size;
+  return SetFileInformationByHandle(handle, FileAllocationInfo, &info, sizeof(info));
+}
+
 } // namespace tria::pal
@@ -0,0 +1,112 @@
+#include "catch2/catch.hpp"
+#include "tria/asset/archive.hpp"
+#include "tria/asset/database.hpp"
+#include "tria/asset/err/archive_err.hpp"
+#include "tria/asset/err/asset_load_err.hpp"
+#include "tria/asset/mesh.hpp"
+#include "tria/asset/raw_asset.hpp"
+#include "utils.hpp"
+#include <cstdint>
+#include <string>
+
+namespace tria::asset::tests {
+
+TEST_CASE("[asset] - Archive", "[asset]") {
+
+  SECTION("Assets are loaded from the archive") {
+    withTempDir([](const fs::path& dir) {
+      fs::create_directories(dir / "src" / "sub");
+      writeFile(dir / "src" / "a.tst", "Hello");
+      writeFile(dir / "src" / "sub" / "b.tst", "World");
+      writeFile(dir / "src" / "empty.tst", "");
+
+      const auto stats = packArchive(dir / "src", dir / "test.tpak", ArchiveCompression::None);
+      CHECK(stats.entryCount == 3U);
+      CHECK(stats.compressedCount == 0U);
+      CHECK(stats.srcSize == 10U);
+
+      // Source files are not needed anymore.
+      fs::remove_all(dir / "src");
+
+      auto db = Database{nullptr, dir / "test.tpak"};
+      CHECK_RAW_ASSET(db.get("a.tst"), "Hello");
+      CHECK_RAW_ASSET(db.get("sub/b.tst"), "World");
+      CHECK_RAW_ASSET(db.get("empty.tst"), "");
+
+      // Entries are mapped and aligned.
+      const auto& data = db.get("sub/b.tst")->downcast<RawAsset>()->getData();
+      CHECK(data.isMapped());
+      CHECK(reinterpret_cast<uintptr_t>(data.getBegin()) % 16U == 0U);
+    });
+  }
+
+  SECTION("Compressed entries are decompressed on load") {
+    withTempDir([](const fs::path& dir) {
+      fs::create_directories(dir / "src");
+      writeFile(dir / "src" / "a.tst", std::string(10'000, 'a'));
+      writeFile(dir / "src" / "b.tst", "Hello World");
+
+      // Only entries that benefit from compression are compressed.
+      const auto stats = packArchive(dir / "src", dir / "test.tpak", ArchiveCompression::Lz);
+      CHECK(stats.entryCount == 2U);
+      CHECK(stats.compressedCount == 1U);
+      CHECK(stats.archiveSize < stats.srcSize);
+
+      auto db = Database{nullptr, dir / "test.tpak"};
+      CHECK_RAW_ASSET(db.get("a.tst"), std::string(10'000, 'a'));
+      CHECK_RAW_ASSET(db.get("b.tst"), "Hello World");
+      CHECK(!db.get("a.tst")->downcast<RawAsset>()->getData().isMapped());
+      CHECK(db.get("b.tst")->downcast<RawAsset>()->getData().isMapped());
+    });
+  }
+
+  SECTION("Assets in an archive are processed the same as files") {
+    withTempDir([](const fs::path& dir) {
+      fs::create_directories(dir / "src");
+      writeFile(dir / "src" / "test.obj", "v 1.0 2.0 3.0\nf 1 1 1\n");
+      static_cast<void>(packArchive(dir / "src", dir / "test.tpak", ArchiveCompression::Lz));
+
+      auto db          = Database{nullptr, dir / "test.tpak"};
+      const auto* mesh = db.get("test.obj")->downcast<Mesh>();
+      REQUIRE(mesh->getVertexCount() == 1U);
+      CHECK(mesh->getVertexBegin()->position == math::Vec3f{1.f, 2.f, 3.f});
+    });
+  }
+
+  SECTION("Archives are not packed into themselves") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", "Hello");
+
+      CHECK(packArchive(dir, dir / "test.tpak", ArchiveCompression::None).entryCount == 1U);
+      CHECK(packArchive(dir, dir / "test.tpak", ArchiveCompression::None).entryCount == 1U);
+    });
+  }
+
+  SECTION("Loading an asset that is not in the archive throws") {
+    withTempDir([](const fs::path& dir) {
+      fs::create_directories(dir / "src");
+      writeFile(dir / "src" / "a.tst", "Hello");
+      static_cast<void>(packArchive(dir / "src", dir / "test.tpak", ArchiveCompression::None));
+
+      auto db = Database{nullptr, dir / "test.tpak"};
+      CHECK_THROWS_AS(db.get("b.tst"), err::AssetLoadErr);
+      CHECK_THROWS_AS(db.get("src/a.tst"), err::AssetLoadErr);
+    });
+  }
+
+  SECTION("Opening an invalid archive throws") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.tpak", "Hello World, this is not an archive");
+      CHECK_THROWS_AS(Database(nullptr, dir / "test.tpak"), err::ArchiveErr);
+    });
+  }
+
+  SECTION("Packing a non-existing directory throws") {
+    withTempDir([](const fs::path& dir) {
+      CHECK_THROWS_AS(
+          packArchive(dir / "src", dir / "test.tpak", ArchiveCompression::None), err::ArchiveErr);
+    });
+  }
+}
+
+} // namespace tria::asset::tests
@@ -0,0 +1,154 @@
+#include "catch2/catch.hpp"
+#include "tria/asset/archive.hpp"
+#include "tria/asset/database.hpp"
+#include "tria/asset/graphic.hpp"
+#include "tria/math/base64.hpp"
+#include "utils.hpp"
+#include <string>
+#include <vector>
+
+namespace tria::asset::tests {
+
+namespace {
+
+constexpr auto g_numTextures   = 4U;
+constexpr auto g_textureSize   = 256U;
+constexpr auto g_meshSize      = 128U;
+constexpr auto g_numSmallFiles = 500U;
+
+/* Dummy vertex and fragment shaders compiled to spir-v 1.3.
+ */
+auto writeShaders(const fs::path& dir) {
+  writeFile(
+      dir / "test.vert.spv",
+      math::base64Decode("AwIjBwADAQAIAA0ABgAAAAAAAAARAAIAAQAAAAsABgABAAAAR0xTTC5zdGQuNDUwAAAAAA"
+                         "4AAwAAAAAAAQAAAA8ABQAAAAAABAAAAG1haW4AAAAAEwACAAIAAAAhAAMAAwAAAAIAAAA2"
+                         "AAUAAgAAAAQAAAAAAAAAAwAAAPgAAgAFAAAA/QABADgAAQA="));
+  writeFile(
+      dir / "test.frag.spv",
+      math::base64Decode(
+          "AwIjBwADAQAIAA0ADAAAAAAAAAARAAIAAQAAAAsABgABAAAAR0xTTC5zdGQuNDUwAAAAAA4AAwAAAAAAAQAAAA"
+          "8ABgAEAAAABAAAAG1haW4AAAAACQAAABAAAwAEAAAABwAAAAMAAwACAAAAwgEAAAQACQBHTF9BUkJfc2VwYXJh"
+          "dGVfc2hhZGVyX29iamVjdHMAAAQACgBHTF9HT09HTEVfY3BwX3N0eWxlX2xpbmVfZGlyZWN0aXZlAAAEAAgAR0"
+          "xfR09PR0xFX2luY2x1ZGVfZGlyZWN0aXZlAAUABAAEAAAAbWFpbgAAAAAFAAUACQAAAG91dENvbG9yAAAAAEcA"
+          "BAAJAAAAHgAAAAAAAAATAAIAAgAAACEAAwADAAAAAgAAABYAAwAGAAAAIAAAABcABAAHAAAABgAAAAQAAAAgAA"
+          "QACAAAAAMAAAAHAAAAOwAEAAgAAAAJAAAAAwAAACsABAAGAAAACgAAAAAAgD8sAAcABwAAAAsAAAAKAAAACgAA"
+          "AAoAAAAKAAAANgAFAAIAAAAEAAAAAAAAAAMAAAD4AAIABQAAAD4AAwAJAAAACwAAAP0AAQA4AAEA"));
+}
+
+/* Text ppm texture, relatively expensive to parse.
+ */
+auto writeTexture(const fs::path& path) {
+  auto str = "P3 " + std::to_string(g_textureSize) + " " + std::to_string(g_textureSize) + " 255\n";
+  for (auto i = 0U; i != g_textureSize * g_textureSize; ++i) {
+    str += std::to_string(i % 256U) + " 42 137\n";
+  }
+  writeFile(path, str);
+}
+
+/* Grid of quads in the obj format.
+ */
+auto writeMesh(const fs::path& path) {
+  auto str = std::string{};
+  for (auto y = 0U; y != g_meshSize + 1U; ++y) {
+    for (auto x = 0U; x != g_meshSize + 1U; ++x) {
+      str += "v " + std::to_string(x) + " 0.0 " + std::to_string(y) + "\n";
+    }
+  }
+  for (auto y = 0U; y != g_meshSize; ++y) {
+    for (auto x = 0U; x != g_meshSize; ++x) {
+      const auto i = y * (g_meshSize + 1U) + x + 1U;
+      str += "f " + std::to_string(i) + " " + std::to_string(i + 1U) + " " +
+          std::to_string(i + g_meshSize + 2U) + " " + std::to_string(i + g_meshSize + 1U) + "\n";
+    }
+  }
+  writeFile(path, str);
+}
+
+} // namespace
+
+TEST_CASE("[asset] - Database benchmark", "[.][benchmark]") {
+
+  SECTION("Mesh cache") {
+    withTempDir([](const fs::path& dir) {
+      writeMesh(dir / "test.obj");
+
+      BENCHMARK("obj mesh (parse)") {
+        auto db = Database{nullptr, dir};
+        return db.get("test.obj");
+      };
+
+      // Populate the cache.
+      static_cast<void>(Database{nullptr, dir, 0U, dir / "cache"}.get("test.obj"));
+
+      BENCHMARK("obj mesh (cached)") {
+        auto db = Database{nullptr, dir, 0U, dir / "cache"};
+        return db.get("test.obj");
+      };
+    });
+  }
+
+  SECTION("Archive") {
+    withTempDir([](const fs::path& dir) {
+      auto ids = std::vector<AssetId>{};
+      for (auto i = 0U; i != g_numSmallFiles; ++i) {
+        ids.push_back("dir" + std::to_string(i % 10U) + "/file" + std::to_string(i) + ".tst");
+        fs::create_directories((dir / "src" / ids.back()).parent_path());
+        writeFile(dir / "src" / ids.back(), "Hello World " + std::to_string(i));
+      }
+      static_cast<void>(packArchive(dir / "src", dir / "test.tpak", ArchiveCompression::None));
+
+      BENCHMARK("small files (directory)") {
+        auto db = Database{nullptr, dir / "src"};
+        for (const auto& id : ids) {
+          static_cast<void>(db.get(id));
+        }
+        return db.getStats();
+      };
+      BENCHMARK("small files (archive)") {
+        auto db = Database{nullptr, dir / "test.tpak"};
+        for (const auto& id : ids) {
+          static_cast<void>(db.get(id));
+        }
+        return db.getStats();
+      };
+    });
+  }
+
+  SECTION("Graphic dependencies") {
+    withTempDir([](const fs::path& dir) {
+      auto deps = std::vector<AssetId>{"test.vert.spv", "test.frag.spv", "test.obj"};
+      writeShaders(dir);
+      writeMesh(dir / "test.obj");
+
+      auto samplers = std::string{};
+      for (auto i = 0U; i != g_numTextures; ++i) {
+        const auto texId = "test" + std::to_string(i) + ".ppm";
+        writeTexture(dir / texId);
+        deps.push_back(texId);
+        samplers += (i ? ", " : "") + ("{ \"texture\": \"" + texId + "\" }");
+      }
+      writeFile(
+          dir / "test.gfx",
+          "{ \"shaders\": [\"test.vert.spv\", \"test.frag.spv\"], \"mesh\": \"test.obj\", "
+          "\"samplers\": [" +
+              samplers + "] }");
+
+      // Reference: Load the dependencies one after the other (the previous behaviour).
+      BENCHMARK("sequential dependency loads") {
+        auto db = Database{nullptr, dir};
+        for (const auto& dep : deps) {
+          static_cast<void>(db.get(dep));
+        }
+        return db.getStats();
+      };
+      BENCHMARK("graphic (parallel dependency loads)") {
+        auto db = Database{nullptr, dir};
+        static_cast<void>(db.get("test.gfx"));
+        return db.getStats();
+      };
+    });
+  }
+}
+
+} // namespace tria::asset::tests
@@ -2,9 +2,13 @@
 #include "tria/asset/database.hpp"
 #include "tria/asset/err/asset_load_err.hpp"
 #include "tria/asset/err/asset_type_err.hpp"
+#include "tria/asset/raw_asset.hpp"
 #include "tria/asset/shader.hpp"
 #include "utils.hpp"
+#include <chrono>
+#include <future>
 #include <random>
+#include <string>
 #include <thread>
 #include <tuple>
 
@@ -24,6 +28,40 @@ TEST_CASE("[asset] - Database", "[asset]") {
     });
   }
 
+  SECTION("Large files are memory mapped") {
+    withTempDir([](const fs::path& dir) {
+      constexpr auto fileSize = 256U * 1024U + 42U;
+      auto content            = std::string(fileSize, 'a');
+      writeFile(dir / "test.tst", content);
+
+      auto db           = Database{nullptr, dir};
+      const auto* asset = db.get("test.tst")->downcast<RawAsset>();
+      CHECK(asset->getData().isMapped());
+      CHECK_RAW_ASSET(asset, content);
+
+      // Data is padded with zeroes.
+      for (auto i = 0U; i != g_fileDataPadding; ++i) {
+        CHECK(asset->getEnd()[i] == 0U);
+      }
+    });
+  }
+
+  SECTION("Large files without room for the padding in the last page are read into memory") {
+    withTempDir([](const fs::path& dir) {
+      constexpr auto fileSize = 256U * 1024U - 1U;
+      auto content            = std::string(fileSize, 'a');
+      writeFile(dir / "test.tst", content);
+
+      auto db           = Database{nullptr, dir};
+      const auto* asset = db.get("test.tst")->downcast<RawAsset>();
+      CHECK(!asset->getData().isMapped());
+      CHECK_RAW_ASSET(asset, content);
+      for (auto i = 0U; i != g_fileDataPadding; ++i) {
+        CHECK(asset->getEnd()[i] == 0U);
+      }
+    });
+  }
+
   SECTION("Downcasting to an incorrect type throws") {
     withTempDir([](const fs::path& dir) {
       writeFile(dir / "test.tst", "Hello World");
@@ -78,6 +116,243 @@ TEST_CASE("[asset] - Database", "[asset]") {
       for (auto& thread : threads) {
         thread.join();
       }
+
+      // Every asset is only loaded once.
+      CHECK(db.getStats().loadCount == numFiles);
+    });
+  }
+
+  SECTION("Concurrent requests for the same asset share a single load") {
+    constexpr static int numThreads = 8;
+
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.tst", std::string(1024U * 1024U, 'a'));
+
+      auto db      = Database{nullptr, dir};
+      auto results = std::vector<const Asset*>(numThreads);
+      auto threads = std::vector<std::thread>{};
+      for (auto threadNum = 0U; threadNum != numThreads; ++threadNum) {
+        threads.push_back(
+            std::thread{[&db, &results, threadNum]() { results[threadNum] = db.get("test.tst"); }});
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+
+      for (const auto* result : results) {
+        CHECK(result == results[0]);
+      }
+      const auto stats = db.getStats();
+      CHECK(stats.loadCount == 1U);
+      CHECK(stats.dedupCount <= numThreads - 1U);
+    });
+  }
+
+  SECTION("Assets that depend on themselves fail to load") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.gfx", "{ \"shaders\": [\"test.gfx\"] }");
+
+      auto db = Database{nullptr, dir};
+      CHECK_THROWS_AS(db.get("test.gfx"), err::AssetLoadErr);
+
+      // Failed loads are not cached, the next request tries again.
+      CHECK_THROWS_AS(db.get("test.gfx"), err::AssetLoadErr);
+      CHECK(db.getStats().loadCount == 0U);
+    });
+  }
+
+  SECTION("Assets can be loaded asynchronously") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.tst", "Hello World");
+
+      auto db     = Database{nullptr, dir, 2U};
+      auto future = db.getAsync("test.tst");
+      CHECK_RAW_ASSET(future.get(), "Hello World");
+
+      // Already loaded assets return a ready future.
+      auto loaded = db.getAsync("test.tst");
+      CHECK(loaded.wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+      CHECK(loaded.get() == future.get());
+      CHECK(db.get("test.tst") == future.get());
+    });
+  }
+
+  SECTION("Asynchronous load errors are stored in the future") {
+    withTempDir([](const fs::path& dir) {
+      auto db     = Database{nullptr, dir, 2U};
+      auto future = db.getAsync("nothing.txt");
+      CHECK_THROWS_AS(future.get(), err::AssetLoadErr);
+    });
+  }
+
+  SECTION("Batches of assets can be preloaded") {
+    constexpr static int numFiles = 100;
+
+    withTempDir([](const fs::path& dir) {
+      auto ids = std::vector<AssetId>{};
+      for (auto fileNum = 0U; fileNum != numFiles; ++fileNum) {
+        ids.push_back(std::to_string(fileNum) + ".tst");
+        writeFile(dir / ids.back(), "Hello " + std::to_string(fileNum));
+      }
+
+      auto db      = Database{nullptr, dir, 4U};
+      auto futures = db.preload(ids);
+      REQUIRE(futures.size() == numFiles);
+      for (auto fileNum = 0U; fileNum != numFiles; ++fileNum) {
+        CHECK_RAW_ASSET(futures[fileNum].get(), "Hello " + std::to_string(fileNum));
+        CHECK(db.get(ids[fileNum]) == futures[fileNum].get());
+      }
+    });
+  }
+
+  SECTION("Unreferenced assets are unloaded when exceeding the memory budget") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", std::string(100, 'a'));
+      writeFile(dir / "b.tst", std::string(100, 'b'));
+      writeFile(dir / "c.tst", std::string(100, 'c'));
+
+      auto db = Database{nullptr, dir};
+      db.setMemoryBudget(250U);
+      auto handleA = db.acquire("a.tst");
+      static_cast<void>(db.acquire("b.tst"));
+      auto handleC = db.acquire("c.tst");
+
+      auto stats = db.getStats();
+      CHECK(stats.evictCount == 1U);
+      CHECK(stats.memoryUsage == 200U);
+      CHECK(stats.getMemoryUsage(AssetKind::Raw) == 200U);
+      CHECK(stats.getMemoryUsage(AssetKind::Mesh) == 0U);
+
+      // Referenced assets stay loaded, unloaded assets are loaded again on request.
+      CHECK_RAW_ASSET(handleA, std::string(100, 'a'));
+      CHECK(db.acquire("a.tst") == handleA);
+      CHECK_RAW_ASSET(db.acquire("b.tst"), std::string(100, 'b'));
+      CHECK(db.getStats().loadCount == 4U);
+    });
+  }
+
+  SECTION("Least recently used assets are unloaded first") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", std::string(100, 'a'));
+      writeFile(dir / "b.tst", std::string(100, 'b'));
+
+      auto db = Database{nullptr, dir};
+      static_cast<void>(db.acquire("a.tst"));
+      static_cast<void>(db.acquire("b.tst"));
+      static_cast<void>(db.acquire("a.tst"));
+      db.setMemoryBudget(150U);
+      CHECK(db.getStats().evictCount == 1U);
+
+      static_cast<void>(db.acquire("a.tst"));
+      CHECK(db.getStats().loadCount == 2U);
+      static_cast<void>(db.acquire("b.tst"));
+      CHECK(db.getStats().loadCount == 3U);
+    });
+  }
+
+  SECTION("Assets returned as pointers are never unloaded") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", std::string(100, 'a'));
+
+      auto db           = Database{nullptr, dir};
+      const auto* asset = db.get("a.tst");
+      db.setMemoryBudget(1U);
+      CHECK(db.getStats().evictCount == 0U);
+      CHECK_RAW_ASSET(asset, std::string(100, 'a'));
+    });
+  }
+
+  SECTION("Changed assets are reloaded") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", "Hello");
+
+      auto db = Database{nullptr, dir, 2U};
+      db.enableHotReload();
+      const auto* oldAsset = db.get("a.tst");
+
+      writeFile(dir / "a.tst", "World");
+      const auto reloads = waitForReloads(db, 1U);
+      REQUIRE(reloads.size() == 1U);
+      CHECK(reloads[0].id == "a.tst");
+      CHECK(reloads[0].oldAsset == oldAsset);
+      CHECK_RAW_ASSET(reloads[0].newAsset, "World");
+      CHECK(db.get("a.tst") == reloads[0].newAsset);
+      CHECK(db.getStats().reloadCount == 1U);
+
+      // Pointers to the old version stay valid.
+      CHECK_RAW_ASSET(oldAsset, "Hello");
+    });
+  }
+
+  SECTION("Old versions of large assets stay intact when their file is truncated") {
+    withTempDir([](const fs::path& dir) {
+      constexpr auto fileSize = 256U * 1024U + 42U;
+      auto content            = std::string(fileSize, 'a');
+      writeFile(dir / "a.tst", content);
+
+      auto db = Database{nullptr, dir, 2U};
+      db.enableHotReload();
+      const auto* oldAsset = db.get("a.tst")->downcast<RawAsset>();
+      CHECK(!oldAsset->getData().isMapped());
+
+      // Rewrite the file in place with less data.
+      writeFile(dir / "a.tst", "Hello");
+      const auto reloads = waitForReloads(db, 1U);
+      REQUIRE(reloads.size() == 1U);
+      CHECK_RAW_ASSET(reloads[0].newAsset, "Hello");
+
+      CHECK_RAW_ASSET(oldAsset, content);
+      for (auto i = 0U; i != g_fileDataPadding; ++i) {
+        CHECK(oldAsset->getEnd()[i] == 0U);
+      }
+    });
+  }
+
+  SECTION("Assets that are not loaded are not reloaded") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", "Hello");
+      writeFile(dir / "b.tst", "Hello");
+
+      auto db = Database{nullptr, dir, 2U};
+      db.enableHotReload();
+      static_cast<void>(db.get("a.tst"));
+
+      writeFile(dir / "b.tst", "World");
+      CHECK(db.update().empty());
+      CHECK(db.getStats().reloadCount == 0U);
+      CHECK_RAW_ASSET(db.get("b.tst"), "World");
+    });
+  }
+
+  SECTION("Changes are ignored unless hot reload is enabled") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "a.tst", "Hello");
+
+      auto db = Database{nullptr, dir};
+      static_cast<void>(db.get("a.tst"));
+
+      writeFile(dir / "a.tst", "World");
+      CHECK(db.update().empty());
+      CHECK_RAW_ASSET(db.get("a.tst"), "Hello");
+    });
+  }
+
+  SECTION("Database can be destroyed while assets are loading") {
+    withTempDir([](const fs::path& dir) {
+      auto ids = std::vector<AssetId>{};
+      for (auto fileNum = 0U; fileNum != 100; ++fileNum) {
+        ids.push_back(std::to_string(fileNum) + ".tst");
+        writeFile(dir / ids.back(), "Hello World");
+      }
+      auto futures = std::vector<AssetFuture>{};
+      {
+        auto db = Database{nullptr, dir, 2U};
+        futures = db.preload(ids);
+      }
+      // Loads that did not start before the destruction are abandoned.
+      for (auto& future : futures) {
+        REQUIRE(future.wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+      }
     });
   }
 }
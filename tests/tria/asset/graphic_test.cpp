@@ -1,10 +1,15 @@
 #include "catch2/catch.hpp"
 #include "tria/asset/database.hpp"
+#include "tria/asset/err/asset_load_err.hpp"
 #include "tria/asset/err/graphic_err.hpp"
 #include "tria/asset/err/json_err.hpp"
 #include "tria/asset/graphic.hpp"
 #include "tria/math/base64.hpp"
 #include "utils.hpp"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace tria::asset::tests {
 
@@ -93,6 +98,174 @@ TEST_CASE("[asset] - Graphic", "[asset]") {
     });
   }
 
+  SECTION("Dependencies stay loaded as long as the graphic is referenced") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.vert.spv", getTestVertShader());
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      writeFile(dir / "test.obj", "v 0.0 0.0 0.0\nf 1 1 1\n");
+      writeFile(
+          dir / "test.gfx",
+          "{"
+          "\"shaders\": [\"test.vert.spv\", \"test.frag.spv\"],"
+          "\"mesh\": \"test.obj\""
+          "}");
+
+      auto db  = Database{nullptr, dir};
+      auto gfx = db.acquire("test.gfx");
+      db.setMemoryBudget(1U);
+      CHECK(db.getStats().evictCount == 0U);
+      CHECK(gfx->downcast<Graphic>()->getMesh()->getVertexCount() == 1U);
+
+      // Unloading the graphic also unloads the assets it depends on.
+      gfx = AssetHandle{};
+      db.setMemoryBudget(1U);
+      CHECK(db.getStats().evictCount == 4U);
+      CHECK(db.getStats().memoryUsage == 0U);
+    });
+  }
+
+  SECTION("Dependencies are not unloaded while the graphic is loading") {
+    withTempDir([](const fs::path& dir) {
+      constexpr auto numTextures = 16U;
+      writeFile(dir / "test.vert.spv", getTestVertShader());
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      auto gfxJson = std::string{
+          "{"
+          "\"shaders\": [\"test.vert.spv\", \"test.frag.spv\"],"
+          "\"samplers\": ["};
+      for (auto i = 0U; i != numTextures; ++i) {
+        const auto textureId = "test" + std::to_string(i) + ".ppm";
+        writeFile(dir / textureId, "P3 1 1 255 1 42 137");
+        gfxJson += (i ? ", {\"texture\": \"" : "{\"texture\": \"") + textureId + "\"}";
+      }
+      writeFile(dir / "test.gfx", gfxJson + "]}");
+
+      // Every dependency is loaded exactly once, even though the budget is exceeded by all of them.
+      auto db = Database{nullptr, dir, 4U};
+      db.setMemoryBudget(1U);
+      const auto gfx = db.acquire("test.gfx");
+      CHECK(gfx->downcast<Graphic>()->getSamplerCount() == numTextures);
+      CHECK(db.getStats().loadCount == numTextures + 3U);
+      CHECK(db.getStats().evictCount == 0U);
+    });
+  }
+
+  SECTION("Graphics that share dependencies can be loaded in parallel") {
+    withTempDir([](const fs::path& dir) {
+      constexpr auto numGraphics = 8U;
+      writeFile(dir / "test.vert.spv", getTestVertShader());
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      writeFile(dir / "test.obj", "v 0.0 0.0 0.0\nf 1 1 1\n");
+      auto ids = std::vector<AssetId>{};
+      for (auto i = 0U; i != numGraphics; ++i) {
+        const auto name = "test" + std::to_string(i);
+        writeFile(dir / (name + ".ppm"), "P3 1 1 255 1 42 " + std::to_string(i));
+        writeFile(
+            dir / (name + ".gfx"),
+            "{"
+            "\"shaders\": [\"test.vert.spv\", \"test.frag.spv\"],"
+            "\"mesh\": \"test.obj\","
+            "\"samplers\": [{ \"texture\": \"" + name + ".ppm\" }]"
+            "}");
+        ids.push_back(name + ".gfx");
+      }
+
+      for (const auto workerCount : {1U, 4U}) {
+        auto db      = Database{nullptr, dir, workerCount};
+        auto futures = db.preload(ids);
+        for (auto i = 0U; i != numGraphics; ++i) {
+          const auto* gfx = futures[i].get()->downcast<Graphic>();
+          REQUIRE(gfx->getSamplerCount() == 1);
+          const auto expectedPixel = Pixel{1, 42, static_cast<uint8_t>(i), 255};
+          CHECK(*gfx->getSamplerBegin()->getTexture()->getPixelBegin() == expectedPixel);
+        }
+        // Every graphic and every dependency is loaded exactly once.
+        CHECK(db.getStats().loadCount == numGraphics * 2U + 3U);
+      }
+    });
+  }
+
+  SECTION("Graphics are reloaded when a shader they use changes") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.vert.spv", getTestVertShader());
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      writeFile(dir / "test.obj", "v 0.0 0.0 0.0\nf 1 1 1\n");
+      writeFile(
+          dir / "test.gfx",
+          "{"
+          "\"shaders\": [\"test.vert.spv\", \"test.frag.spv\"],"
+          "\"mesh\": \"test.obj\""
+          "}");
+
+      auto db = Database{nullptr, dir, 2U};
+      db.enableHotReload();
+      const auto* oldGfx = db.get("test.gfx")->downcast<Graphic>();
+
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      const auto reloads = waitForReloads(db, 2U);
+      REQUIRE(reloads.size() == 2U);
+      CHECK(db.getStats().loadCount == 6U);
+
+      // Only the shader and the graphic are reloaded, the mesh is shared with the old version.
+      const auto* newGfx = db.get("test.gfx")->downcast<Graphic>();
+      CHECK(newGfx != oldGfx);
+      CHECK(newGfx->getShaderBegin()[0] == oldGfx->getShaderBegin()[0]);
+      CHECK(newGfx->getShaderBegin()[1] != oldGfx->getShaderBegin()[1]);
+      CHECK(newGfx->getMesh() == oldGfx->getMesh());
+    });
+  }
+
+  SECTION("Graphics that fail to reload keep the old version") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.vert.spv", getTestVertShader());
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      writeFile(dir / "test.obj", "v 0.0 0.0 0.0\nf 1 1 1\n");
+      const auto gfxJson = std::string{"{"
+                                       "\"shaders\": [\"test.vert.spv\", \"test.frag.spv\"],"
+                                       "\"mesh\": \"test.obj\""
+                                       "}"};
+      writeFile(dir / "test.gfx", gfxJson);
+
+      auto db = Database{nullptr, dir, 2U};
+      db.enableHotReload();
+      const auto* oldGfx = db.get("test.gfx");
+
+      // The old version is put back once the reload has failed.
+      writeFile(dir / "test.gfx", "{ \"shaders\": [");
+      const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+      do {
+        CHECK(db.update().empty());
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      } while (db.getStats().getMemoryUsage(AssetKind::Graphic) == 0U &&
+               std::chrono::steady_clock::now() < timeout);
+      CHECK(db.get("test.gfx") == oldGfx);
+      CHECK(db.getStats().reloadCount == 0U);
+
+      // Fixing the file reloads the graphic.
+      writeFile(dir / "test.gfx", gfxJson);
+      const auto reloads = waitForReloads(db, 1U);
+      REQUIRE(reloads.size() == 1U);
+      CHECK(reloads[0].oldAsset == oldGfx);
+      CHECK(db.get("test.gfx") == reloads[0].newAsset);
+    });
+  }
+
+  SECTION("Loading a graphic with a missing dependency throws") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(dir / "test.vert.spv", getTestVertShader());
+      writeFile(dir / "test.frag.spv", getTestFragShader());
+      writeFile(
+          dir / "test.gfx",
+          "{"
+          "\"shaders\": [\"test.vert.spv\", \"test.frag.spv\"],"
+          "\"mesh\": \"test.obj\""
+          "}");
+
+      auto db = Database{nullptr, dir};
+      CHECK_THROWS_AS(db.get("test.gfx"), err::AssetLoadErr);
+    });
+  }
+
   SECTION("Loading a graphic with invalid json throws") {
     withTempDir([](const fs::path& dir) {
       writeFile(
@@ -5,6 +5,7 @@
 #include "tria/math/box_io.hpp"
 #include "utils.hpp"
 #include <sstream>
+#include <vector>
 
 namespace tria::asset {
 
@@ -320,6 +321,67 @@ TEST_CASE("[asset] - Mesh Wavefront Obj", "[asset]") {
     });
   }
 
+  SECTION("Meshes are loaded from the cache on subsequent loads") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(
+          dir / "test.obj",
+          "v 1.0 4.0 7.0\n"
+          "v 2.0 5.0 8.0\n"
+          "v 3.0 6.0 9.0\n"
+          "vt 0.1 0.5\n"
+          "vt 0.3 0.5\n"
+          "vt 0.5 0.5\n"
+          "f 1/1 2/2 3/3\n");
+
+      auto expected = std::vector<Vertex>{};
+      {
+        auto db         = Database{nullptr, dir, 0U, dir / "cache"};
+        const auto mesh = db.get("test.obj")->downcast<Mesh>();
+        CHECK(!mesh->isFileBacked());
+        CHECK(db.getStats().cacheHitCount == 0U);
+        expected = std::vector<Vertex>(mesh->getVertexBegin(), mesh->getVertexEnd());
+      }
+
+      auto db         = Database{nullptr, dir, 0U, dir / "cache"};
+      const auto mesh = db.get("test.obj")->downcast<Mesh>();
+      CHECK(mesh->isFileBacked());
+      CHECK(db.getStats().cacheHitCount == 1U);
+      auto vertices = std::vector<Vertex>(mesh->getVertexBegin(), mesh->getVertexEnd());
+      CHECK_THAT(vertices, VertexMatcher(expected));
+      auto indices = std::vector<IndexType>(mesh->getIndexBegin(), mesh->getIndexEnd());
+      CHECK(indices == std::vector<IndexType>{0, 1, 2});
+      CHECK(approx(mesh->getPosBounds(), math::Box3f{{1.f, 4.f, 7.f}, {3.f, 6.f, 9.f}}));
+      CHECK(approx(mesh->getTexBounds(), math::Box2f{{.1f, .5f}, {.5f, .5f}}));
+    });
+  }
+
+  SECTION("Cached meshes are invalidated when the source changes") {
+    withTempDir([](const fs::path& dir) {
+      writeFile(
+          dir / "test.obj",
+          "v 1.0 4.0 7.0\n"
+          "v 2.0 5.0 8.0\n"
+          "v 3.0 6.0 9.0\n"
+          "f 1 2 3\n");
+      {
+        auto db = Database{nullptr, dir, 0U, dir / "cache"};
+        static_cast<void>(db.get("test.obj"));
+      }
+      writeFile(
+          dir / "test.obj",
+          "v 1.0 4.0 7.0\n"
+          "v 2.0 5.0 8.0\n"
+          "v 3.0 6.0 42.0\n"
+          "f 1 2 3\n");
+
+      auto db         = Database{nullptr, dir, 0U, dir / "cache"};
+      const auto mesh = db.get("test.obj")->downcast<Mesh>();
+      CHECK(!mesh->isFileBacked());
+      CHECK(db.getStats().cacheHitCount == 0U);
+      CHECK(approx(mesh->getPosBounds(), math::Box3f{{1.f, 4.f, 7.f}, {3.f, 6.f, 42.f}}));
+    });
+  }
+
   SECTION("Loading a mesh without any faces throws") {
     withTempDir([](const fs::path& dir) {
       writeFile(
@@ -1,6 +1,8 @@
 #include "utils.hpp"
 #include "tria/fs.hpp"
+#include <chrono>
 #include <fstream>
+#include <thread>
 
 #if defined(__MINGW32__)
 #include <windows.h>
@@ -37,4 +39,16 @@ auto deleteDir(const fs::path& path) -> void {
 #endif
 }
 
+auto waitForReloads(Database& db, size_t count) -> std::vector<AssetReload> {
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  auto result        = std::vector<AssetReload>{};
+  while (result.size() < count && std::chrono::steady_clock::now() < timeout) {
+    for (auto& reload : db.update()) {
+      result.push_back(std::move(reload));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  return result;
+}
+
 } // namespace tria::asset::tests
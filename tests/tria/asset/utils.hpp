@@ -1,8 +1,10 @@
 #pragma once
+#include "tria/asset/database.hpp"
 #include "tria/asset/raw_asset.hpp"
 #include "tria/fs.hpp"
 #include "tria/pal/utils.hpp"
 #include <string>
+#include <vector>
 
 namespace tria::asset::tests {
 
@@ -10,6 +12,10 @@ auto writeFile(const fs::path& path, const std::string& data) -> void;
 auto writeFile(const fs::path& path, const math::RawData& data) -> void;
 auto deleteDir(const fs::path& path) -> void;
 
+/* Update the database until the given amount of assets have been reloaded (or a timeout is hit).
+ */
+auto waitForReloads(Database& db, size_t count) -> std::vector<AssetReload>;
+
 template <typename TestFunc>
 auto withTempDir(TestFunc func) {
   auto tmpDir = pal::getCurExecutablePath().parent_path() / "tria_asset_test";
@@ -25,7 +31,7 @@ auto withTempDir(TestFunc func) {
 
 #define CHECK_RAW_ASSET(asset, expected)                                                           \
   do {                                                                                             \
-    auto* assetPtr = asset;                                                                        \
+    const auto* assetPtr = &*(asset); /* Supports both pointers and handles. */                    \
     REQUIRE(assetPtr->getKind() == AssetKind::Raw);                                                \
     auto contentStr = std::string(                                                                 \
         reinterpret_cast<const char*>(assetPtr->downcast<RawAsset>()->getBegin()),                 \
@@ -0,0 +1,238 @@
+#include "catch2/catch.hpp"
+#include "tria/log/api.hpp"
+#include "tria/log/bin_reader.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include "tria/pal/utils.hpp"
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tria::log::tests {
+
+namespace {
+
+/* Copy of a decoded message, decoded messages reference data owned by the reader so they cannot be
+ * stored directly.
+ */
+struct DecodedMsg final {
+  Level lvl;
+  std::string txt;
+  std::string file;
+  uint32_t line;
+  TimePoint time;
+  std::vector<std::pair<std::string, std::string>> params; // Values written in json format.
+};
+
+[[nodiscard]] auto writeParams(const Param* begin, const Param* end) {
+  auto result = std::vector<std::pair<std::string, std::string>>{};
+  for (; begin != end; ++begin) {
+    auto val = std::string{};
+    begin->writeValue(&val, ParamWriteMode::Json);
+    result.emplace_back(std::string{begin->getKey()}, std::move(val));
+  }
+  return result;
+}
+
+class DecodedSink final : public Sink {
+public:
+  explicit DecodedSink(std::vector<DecodedMsg>* output, LevelMask mask = allLevelMask()) :
+      Sink{mask}, m_output{output} {}
+  ~DecodedSink() override = default;
+
+  auto write(const Message& msg) noexcept -> void override {
+    m_output->push_back(DecodedMsg{
+        msg.getMeta()->getLevel(),
+        std::string{msg.getMeta()->getTxt()},
+        std::string{msg.getMeta()->getFile()},
+        msg.getMeta()->getLine(),
+        msg.getTime(),
+        writeParams(msg.begin(), msg.end())});
+  }
+
+private:
+  std::vector<DecodedMsg>* m_output;
+};
+
+template <typename TestFunc>
+auto withTempFile(TestFunc func) {
+  const auto path = pal::getCurExecutablePath().parent_path() / "tria_log_binary_test.tlog";
+  try {
+    func(path);
+    fs::remove(path);
+  } catch (...) {
+    fs::remove(path);
+    throw;
+  }
+}
+
+[[nodiscard]] auto readFile(const fs::path& path) {
+  auto file = std::ifstream{path.string(), std::ios::binary};
+  return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+auto writeFile(const fs::path& path, const std::string& data) {
+  auto file = std::ofstream{path.string(), std::ios::binary};
+  file.write(data.data(), data.size());
+}
+
+} // namespace
+
+TEST_CASE("[log] - Binary sink", "[log]") {
+
+  SECTION("Messages and parameters survive a round-trip") {
+    withTempFile([](const fs::path& path) {
+      auto logged = std::vector<Message>{};
+      {
+        auto logger = Logger{makeFileBinarySink(path)};
+        for (auto i = 0; i != 3; ++i) {
+          LOG_W(
+              &logger,
+              "test_message",
+              {"int", -42 * i},
+              {"uint", 1337U},
+              {"double", 0.1},
+              {"float", 0.1F},
+              {"bool", true},
+              {"str", "Hello \"World\"\n"},
+              {"longStr", std::string(100, 'a')},
+              {"path", fs::path{"dir/file.txt"}},
+              {"duration", std::chrono::milliseconds{42}},
+              {"memSize", MemSize{1024}},
+              {"list", 1, 2, 3});
+        }
+        LOG_E(&logger, "other_message", {"int", 1});
+      }
+
+      auto decoded = std::vector<DecodedMsg>{};
+      auto sink    = DecodedSink{&decoded};
+      CHECK(readBinaryLog(path, &sink) == 4U);
+      REQUIRE(decoded.size() == 4U);
+
+      CHECK(decoded[0].lvl == Level::Warn);
+      CHECK(decoded[0].txt == "test_message");
+      CHECK_THAT(decoded[0].file, Catch::EndsWith("binary_sink_test.cpp"));
+      CHECK(decoded[0].line != 0U);
+      CHECK(decoded[3].lvl == Level::Error);
+      CHECK(decoded[3].txt == "other_message");
+      CHECK(decoded[0].time <= decoded[3].time);
+
+      const auto expectedParams = std::vector<Param>{
+          {"int", -42 * 2},
+          {"uint", 1337U},
+          {"double", 0.1},
+          {"float", 0.1F},
+          {"bool", true},
+          {"str", "Hello \"World\"\n"},
+          {"longStr", std::string(100, 'a')},
+          {"path", fs::path{"dir/file.txt"}},
+          {"duration", std::chrono::milliseconds{42}},
+          {"memSize", MemSize{1024}},
+          {"list", 1, 2, 3}};
+      CHECK(
+          decoded[2].params ==
+          writeParams(expectedParams.data(), expectedParams.data() + expectedParams.size()));
+    });
+  }
+
+  SECTION("Timestamps are preserved") {
+    withTempFile([](const fs::path& path) {
+      const auto now = std::chrono::system_clock::now();
+      {
+        auto logger = Logger{makeFileBinarySink(path)};
+        LOG_I(&logger, "test_message", {"time", now});
+      }
+      auto decoded = std::vector<DecodedMsg>{};
+      auto sink    = DecodedSink{&decoded};
+      REQUIRE(readBinaryLog(path, &sink) == 1U);
+
+      auto expectedTime = std::string{};
+      Value{now}.write(&expectedTime, ParamWriteMode::Json);
+      CHECK(decoded[0].params[0].second == expectedTime);
+      CHECK(decoded[0].time >= now);
+    });
+  }
+
+  SECTION("Decoding skips messages that are not in the sink mask") {
+    withTempFile([](const fs::path& path) {
+      {
+        auto logger = Logger{makeFileBinarySink(path)};
+        LOG_D(&logger, "debug_message");
+        LOG_E(&logger, "error_message");
+      }
+      auto decoded = std::vector<DecodedMsg>{};
+      auto sink    = DecodedSink{&decoded, levelMask(Level::Error)};
+      CHECK(readBinaryLog(path, &sink) == 1U);
+      REQUIRE(decoded.size() == 1U);
+      CHECK(decoded[0].txt == "error_message");
+    });
+  }
+
+  SECTION("Binary log is smaller than the equivalent json log") {
+    withTempFile([](const fs::path& path) {
+      const auto jsonPath = fs::path{path}.replace_extension("log");
+      {
+        auto logger = Logger{makeFileBinarySink(path), makeFileJsonSink(jsonPath)};
+        for (auto i = 0; i != 100; ++i) {
+          LOG_I(&logger, "test_message", {"index", i}, {"value", i * 0.5});
+        }
+      }
+      const auto jsonSize = fs::file_size(jsonPath);
+      fs::remove(jsonPath);
+      CHECK(fs::file_size(path) * 4U < jsonSize);
+    });
+  }
+
+  SECTION("Error messages are flushed while logging with the flush on error policy") {
+    withTempFile([](const fs::path& path) {
+      auto logger = Logger{makeFileBinarySink(path, allLevelMask(), flushOnError())};
+      LOG_E(&logger, "error_message");
+
+      // Wait for the log thread to write the message.
+      auto decoded = std::vector<DecodedMsg>{};
+      auto sink    = DecodedSink{&decoded};
+      for (auto i = 0; i != 5000 && decoded.empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        try {
+          decoded.clear();
+          readBinaryLog(path, &sink);
+        } catch (const err::LogDecodeErr&) {
+          // File could be (partially) written.
+        }
+      }
+      REQUIRE(decoded.size() == 1U);
+      CHECK(decoded[0].txt == "error_message");
+    });
+  }
+
+  SECTION("Decoding an invalid file throws") {
+    withTempFile([](const fs::path& path) {
+      writeFile(path, "Not a binary log");
+      auto decoded = std::vector<DecodedMsg>{};
+      auto sink    = DecodedSink{&decoded};
+      CHECK_THROWS_AS(readBinaryLog(path, &sink), err::LogDecodeErr);
+    });
+  }
+
+  SECTION("Decoding a truncated file throws after writing the complete messages") {
+    withTempFile([](const fs::path& path) {
+      {
+        auto logger = Logger{makeFileBinarySink(path)};
+        LOG_I(&logger, "message1");
+        LOG_I(&logger, "message2", {"str", "Hello World"});
+      }
+      const auto data = readFile(path);
+      writeFile(path, data.substr(0, data.size() - 2U));
+
+      auto decoded = std::vector<DecodedMsg>{};
+      auto sink    = DecodedSink{&decoded};
+      CHECK_THROWS_AS(readBinaryLog(path, &sink), err::LogDecodeErr);
+      REQUIRE(decoded.size() == 1U);
+      CHECK(decoded[0].txt == "message1");
+    });
+  }
+}
+
+} // namespace tria::log::tests
@@ -0,0 +1,320 @@
+#include "catch2/catch.hpp"
+#include "tria/log/api.hpp"
+#include "tria/log/bin_reader.hpp"
+#include "tria/log/decompress.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include "tria/pal/utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace tria::log::tests {
+
+namespace {
+
+constexpr static auto g_testMeta =
+    MetaData{Level::Info, "test_message", __FILE__, "testFunc", __LINE__};
+
+/* Sink that only counts the messages it receives.
+ */
+class CountingSink final : public Sink {
+public:
+  explicit CountingSink(size_t* count) : Sink{allLevelMask()}, m_count{count} {}
+  ~CountingSink() override = default;
+
+  auto write(const Message& /*unused*/) noexcept -> void override { ++(*m_count); }
+
+private:
+  size_t* m_count;
+};
+
+[[nodiscard]] auto getRotatedPath(const fs::path& path, uint32_t index) {
+  auto result = path;
+  result += "." + std::to_string(index);
+  return result;
+}
+
+template <typename TestFunc>
+auto withTempPath(TestFunc func) {
+  const auto path    = pal::getCurExecutablePath().parent_path() / "tria_log_rotation_test.log";
+  const auto cleanup = [&path]() {
+    fs::remove(path);
+    fs::remove(path.string() + ".rotating");
+    fs::remove(path.string() + ".next");
+    for (auto i = 1U; i != 10U; ++i) {
+      fs::remove(getRotatedPath(path, i));
+    }
+  };
+  cleanup();
+  try {
+    func(path);
+    cleanup();
+  } catch (...) {
+    cleanup();
+    throw;
+  }
+}
+
+[[nodiscard]] auto readFile(const fs::path& path) {
+  auto file = std::ifstream{path.string(), std::ios::binary};
+  return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+[[nodiscard]] auto countLines(const fs::path& path) {
+  const auto data = readFile(path);
+  return static_cast<size_t>(std::count(data.begin(), data.end(), '\n'));
+}
+
+[[nodiscard]] auto decompressFile(const fs::path& path) {
+  auto* tmpFile = std::tmpfile();
+  decompressLog(path, tmpFile);
+
+  auto result = std::string(static_cast<size_t>(std::ftell(tmpFile)), '\0');
+  std::rewind(tmpFile);
+  const auto read = std::fread(result.data(), 1U, result.size(), tmpFile);
+  std::fclose(tmpFile);
+  result.resize(read);
+  return result;
+}
+
+[[nodiscard]] auto stripTimestamps(std::string data) {
+  // Timestamps differ between the runs, replace them with a fixed value.
+  constexpr auto key = std::string_view{"\"timestamp\": \""};
+  for (auto pos = data.find(key); pos != std::string::npos; pos = data.find(key, pos)) {
+    pos += key.size();
+    data.replace(pos, data.find('"', pos) - pos, "x");
+  }
+  return data;
+}
+
+/* Wait (up to a generous timeout) for the file to contain the given text.
+ */
+[[nodiscard]] auto waitForContent(const fs::path& path, std::string_view text) {
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (readFile(path).find(text) == std::string::npos) {
+    if (std::chrono::steady_clock::now() > timeout) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("[log] - File flushing", "[log]") {
+
+  SECTION("Data held back by the interval policy is flushed when the sink is idle") {
+    withTempPath([](const fs::path& path) {
+      const auto interval = std::chrono::seconds{10};
+      auto sink = makeFileJsonSink(path, allLevelMask(), flushInterval(interval));
+      sink->write(Message{&g_testMeta, {}});
+      CHECK(readFile(path).empty());
+
+      const auto now = std::chrono::steady_clock::now();
+      CHECK(sink->idle(now) > now);
+      CHECK(readFile(path).empty());
+
+      CHECK(sink->idle(now + interval) == std::chrono::steady_clock::time_point::max());
+      CHECK(readFile(path).find("test_message") != std::string::npos);
+    });
+  }
+
+  SECTION("Logger flushes interval sinks while no messages are logged") {
+    for (const auto dispatch : {SinkDispatch::Sequential, SinkDispatch::Parallel}) {
+      withTempPath([dispatch](const fs::path& path) {
+        auto config         = LoggerConfig{};
+        config.sinkDispatch = dispatch;
+        auto logger         = Logger{
+            config,
+            makeFileJsonSink(path, allLevelMask(), flushInterval(std::chrono::milliseconds{10}))};
+        LOG_I(&logger, "test_message");
+        CHECK(waitForContent(path, "test_message"));
+      });
+    }
+  }
+}
+
+TEST_CASE("[log] - File rotation", "[log]") {
+
+  SECTION("Files are rotated by size and only the configured amount is kept") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink =
+            makeFileJsonSink(path, allLevelMask(), flushPerBatch(), rotateBySize(1024U, 2U));
+        for (auto i = 0; i != 100; ++i) {
+          sink->write(Message{&g_testMeta, {{"i", i}}});
+        }
+      }
+      CHECK(fs::exists(path));
+      CHECK(fs::exists(getRotatedPath(path, 1U)));
+      CHECK(fs::exists(getRotatedPath(path, 2U)));
+      CHECK(!fs::exists(getRotatedPath(path, 3U)));
+
+      // File that was prepared for the next rotation is removed.
+      CHECK(!fs::exists(path.string() + ".next"));
+
+      // Files only exceed the size by the last batch.
+      CHECK(fs::file_size(getRotatedPath(path, 1U)) >= 1024U);
+      CHECK(fs::file_size(getRotatedPath(path, 1U)) < 2048U);
+
+      // Newest messages are in the active file, the oldest were deleted.
+      const auto data = readFile(path);
+      CHECK(data.find("\"i\": 99 }") != std::string::npos);
+      CHECK(readFile(getRotatedPath(path, 2U)).find("\"i\": 0 }") == std::string::npos);
+    });
+  }
+
+  SECTION("Files are rotated by age") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink = makeFilePrettySink(
+            path, allLevelMask(), flushPerBatch(), rotateByAge(std::chrono::milliseconds{5}, 1U));
+        sink->write(Message{&g_testMeta, {}});
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        sink->write(Message{&g_testMeta, {}});
+      }
+      CHECK(countLines(path) == 1U);
+      CHECK(countLines(getRotatedPath(path, 1U)) == 1U);
+    });
+  }
+
+  SECTION("Rotated binary files can be decoded on their own") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink =
+            makeFileBinarySink(path, allLevelMask(), flushPerBatch(), rotateBySize(256U, 9U));
+        for (auto i = 0; i != 100; ++i) {
+          sink->write(Message{&g_testMeta, {{"i", i}, {"str", "Hello World"}}});
+        }
+      }
+      REQUIRE(fs::exists(getRotatedPath(path, 1U)));
+
+      auto count = size_t{0U};
+      auto sink  = CountingSink{&count};
+      auto total = readBinaryLog(path, &sink);
+      for (auto i = 1U; fs::exists(getRotatedPath(path, i)); ++i) {
+        total += readBinaryLog(getRotatedPath(path, i), &sink);
+      }
+      CHECK(total == count);
+      CHECK(count > 0U);
+      CHECK(count <= 100U);
+    });
+  }
+
+  SECTION("Failing to rotate keeps appending to the active file") {
+    withTempPath([](const fs::path& path) {
+      // A directory at the staging path makes moving the active file out of the way fail.
+      auto stagingPath = path;
+      stagingPath += ".rotating";
+      fs::create_directory(stagingPath);
+      {
+        auto sink =
+            makeFileJsonSink(path, allLevelMask(), flushPerBatch(), rotateBySize(256U, 2U));
+        for (auto i = 0; i != 100; ++i) {
+          sink->write(Message{&g_testMeta, {{"i", i}}});
+        }
+      }
+      CHECK(countLines(path) == 100U);
+      CHECK(!fs::exists(getRotatedPath(path, 1U)));
+    });
+  }
+
+  SECTION("Preallocation does not change the file contents") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink = makeFileJsonSink(
+            path, allLevelMask(), flushPerBatch(), rotateBySize(1024U, 1U, 1024U * 1024U));
+        for (auto i = 0; i != 20; ++i) {
+          sink->write(Message{&g_testMeta, {{"i", i}}});
+        }
+      }
+      for (const auto& file : {path, getRotatedPath(path, 1U)}) {
+        const auto data = readFile(file);
+        CHECK(fs::file_size(file) == data.size());
+        CHECK(data.find('\0') == std::string::npos);
+        CHECK(data.back() == '\n');
+      }
+    });
+  }
+}
+
+TEST_CASE("[log] - File compression", "[log]") {
+
+  SECTION("Compressed json logs decompress to the uncompressed log") {
+    withTempPath([](const fs::path& path) {
+      const auto rawPath = getRotatedPath(path, 1U);
+      {
+        auto sink = makeFileJsonSink(
+            path, allLevelMask(), flushPerBatch(), noRotation(), Compression::Lz);
+        auto rawSink = makeFileJsonSink(rawPath);
+        for (auto i = 0; i != 1000; ++i) {
+          const auto msg = Message{&g_testMeta, {{"i", i}, {"str", "Hello World"}}};
+          sink->write(msg);
+          rawSink->write(msg);
+        }
+      }
+      const auto raw = readFile(rawPath);
+      CHECK(stripTimestamps(decompressFile(path)) == stripTimestamps(raw));
+
+      // Repetitive logs compress well, even though every message is compressed as a block.
+      CHECK(fs::file_size(path) < raw.size() / 3U);
+    });
+  }
+
+  SECTION("Compressed binary logs can be decoded directly") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink = makeFileBinarySink(
+            path, allLevelMask(), flushPerBatch(), noRotation(), Compression::Lz);
+        for (auto i = 0; i != 100; ++i) {
+          sink->write(Message{&g_testMeta, {{"i", i}, {"str", "Hello World"}}});
+        }
+      }
+      auto count = size_t{0U};
+      auto sink  = CountingSink{&count};
+      CHECK(readBinaryLog(path, &sink) == 100U);
+      CHECK(count == 100U);
+    });
+  }
+
+  SECTION("Rotated compressed files can be decompressed on their own") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink = makeFileJsonSink(
+            path, allLevelMask(), flushPerBatch(), rotateBySize(256U, 9U), Compression::Lz);
+        for (auto i = 0; i != 100; ++i) {
+          sink->write(Message{&g_testMeta, {{"i", i}}});
+        }
+      }
+      REQUIRE(fs::exists(getRotatedPath(path, 1U)));
+
+      auto lines = size_t{0U};
+      for (const auto& file : {path, getRotatedPath(path, 1U), getRotatedPath(path, 2U)}) {
+        const auto data = decompressFile(file);
+        CHECK(data.back() == '\n');
+        lines += static_cast<size_t>(std::count(data.begin(), data.end(), '\n'));
+      }
+      CHECK(lines > 0U);
+    });
+  }
+
+  SECTION("Decompressing a file that is not compressed throws") {
+    withTempPath([](const fs::path& path) {
+      {
+        auto sink = makeFileJsonSink(path);
+        sink->write(Message{&g_testMeta, {}});
+      }
+      auto* tmpFile = std::tmpfile();
+      CHECK_THROWS_AS(decompressLog(path, tmpFile), err::LogDecodeErr);
+      std::fclose(tmpFile);
+    });
+  }
+}
+
+} // namespace tria::log::tests
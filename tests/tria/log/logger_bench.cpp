@@ -0,0 +1,180 @@
+#include "catch2/catch.hpp"
+#include "tria/log/api.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tria::log::tests {
+
+namespace {
+
+constexpr auto g_numProducers       = 4U;
+constexpr auto g_numMsgsPerProducer = 10'000U;
+
+/* Sink that ignores all messages, used to only measure the cost of getting messages to the sink.
+ */
+class NullSink final : public Sink {
+public:
+  explicit NullSink(LevelMask mask = allLevelMask()) : Sink{mask} {}
+  ~NullSink() override = default;
+
+  auto write(const Message& /*unused*/) noexcept -> void override {}
+};
+
+/* Sink that busy-waits for a fixed duration per message, simulates an expensive sink.
+ */
+class SpinSink final : public Sink {
+public:
+  explicit SpinSink(std::chrono::nanoseconds cost) : Sink{allLevelMask()}, m_cost{cost} {}
+  ~SpinSink() override = default;
+
+  auto write(const Message& /*unused*/) noexcept -> void override {
+    const auto end = std::chrono::steady_clock::now() + m_cost;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+  }
+
+private:
+  std::chrono::nanoseconds m_cost;
+};
+
+/* Reference implementation of the previous logger queue design: producers push into a vector
+ * under a mutex and notify a condition variable for every message, the log thread swaps the
+ * vector out and processes the batch.
+ */
+class SwapVectorQueue final {
+public:
+  SwapVectorQueue() : m_shutdown{false} { m_thread = std::thread(&SwapVectorQueue::loop, this); }
+  ~SwapVectorQueue() {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_shutdown = true;
+    }
+    m_condVar.notify_one();
+    m_thread.join();
+  }
+
+  [[nodiscard]] auto getMask() const noexcept { return allLevelMask(); }
+  [[nodiscard]] auto getTimeSource() const noexcept { return TimeSource::SystemClock; }
+
+  auto publish(Message msg) noexcept {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_input.push_back(std::move(msg));
+    }
+    m_condVar.notify_one();
+  }
+
+private:
+  std::thread m_thread;
+  bool m_shutdown;
+  std::vector<Message> m_input;
+  std::vector<Message> m_process;
+  std::mutex m_mutex;
+  std::condition_variable m_condVar;
+  NullSink m_sink;
+
+  auto loop() noexcept -> void {
+    auto running = true;
+    while (running) {
+      {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_condVar.wait(lk, [this]() { return !m_input.empty() || m_shutdown; });
+        m_input.swap(m_process);
+        running = !m_shutdown;
+      }
+      for (const auto& msg : m_process) {
+        m_sink.write(msg);
+      }
+      m_process.clear();
+    }
+  }
+};
+
+template <typename Publisher>
+auto publishFromProducers(Publisher* publisher) {
+  auto threads = std::vector<std::thread>{};
+  for (auto threadNum = 0U; threadNum != g_numProducers; ++threadNum) {
+    threads.push_back(std::thread{[threadNum, publisher]() {
+      for (auto msgNum = 0U; msgNum != g_numMsgsPerProducer; ++msgNum) {
+        LOG_I(publisher, "bench_message", {"threadNum", threadNum}, {"msgNum", msgNum});
+      }
+    }});
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+TEST_CASE("[log] - Logger benchmark", "[.][benchmark]") {
+
+  SECTION("Multi-producer publish throughput") {
+    auto swapVectorQueue = SwapVectorQueue{};
+    auto logger          = Logger{std::make_unique<NullSink>()};
+
+    BENCHMARK("swap-vector queue (" + std::to_string(g_numProducers) + " producers)") {
+      publishFromProducers(&swapVectorQueue);
+    };
+
+    BENCHMARK("logger (" + std::to_string(g_numProducers) + " producers)") {
+      publishFromProducers(&logger);
+    };
+  }
+
+  SECTION("Multiple expensive sinks") {
+    const auto publishAndFlush = [](SinkDispatch dispatch) {
+      auto logger = Logger{
+          LoggerConfig{4096U, OverflowPolicy::Block, dispatch},
+          std::make_unique<SpinSink>(std::chrono::microseconds{1}),
+          std::make_unique<SpinSink>(std::chrono::microseconds{1})};
+      for (auto i = 0U; i != g_numMsgsPerProducer; ++i) {
+        LOG_I(&logger, "bench_message", {"i", i});
+      }
+    };
+
+    BENCHMARK("sequential dispatch (2 sinks)") { publishAndFlush(SinkDispatch::Sequential); };
+    BENCHMARK("parallel dispatch (2 sinks)") { publishAndFlush(SinkDispatch::Parallel); };
+  }
+
+  SECTION("Timestamp capture") {
+    BENCHMARK("system_clock::now") { return std::chrono::system_clock::now(); };
+    BENCHMARK("readTicks") { return readTicks(); };
+
+    constexpr static auto meta = MetaData{Level::Info, "bench_message", "file", "func", 42U};
+    BENCHMARK("message with system clock time") {
+      return Message{&meta, TimeSource::SystemClock, {{"val", 42}}};
+    };
+    BENCHMARK("message with tick time") {
+      return Message{&meta, TimeSource::Ticks, {{"val", 42}}};
+    };
+  }
+
+  SECTION("String parameters") {
+    constexpr static auto meta = MetaData{Level::Info, "bench_message", "file", "func", 42U};
+    const auto longStr         = std::string{"assets/textures/environment/skybox_front_4k.png"};
+    const auto longPath        = fs::path{longStr};
+
+    BENCHMARK("message with a long string") { return Message{&meta, {{"str", longStr}}}; };
+    BENCHMARK("message with a long static string") {
+      return Message{&meta, {{"str", StaticStr{longStr}}}};
+    };
+    BENCHMARK("message with a long path") { return Message{&meta, {{"path", longPath}}}; };
+  }
+
+  SECTION("Disabled level") {
+    auto logger = Logger{std::make_unique<NullSink>(levelMask(Level::Error))};
+    auto str    = std::string{"dyn_string"};
+
+    BENCHMARK("disabled info message") {
+      LOG_I(&logger, "bench_message", {"str", str}, {"val", 42});
+    };
+  }
+}
+
+} // namespace tria::log::tests
@@ -5,6 +5,61 @@
 
 namespace tria::log::tests {
 
+namespace {
+
+/* Sink that blocks writing until it is released, used to simulate a stalled sink.
+ */
+class BlockingSink final : public Sink {
+public:
+  BlockingSink(std::vector<Message>* output, std::atomic<bool>* released) :
+      Sink{allLevelMask()}, m_output{output}, m_released{released} {}
+  ~BlockingSink() override = default;
+
+  auto write(const Message& msg) noexcept -> void override {
+    while (!m_released->load()) {
+      std::this_thread::yield();
+    }
+    m_output->push_back(msg);
+  }
+
+private:
+  std::vector<Message>* m_output;
+  std::atomic<bool>* m_released;
+};
+
+/* Sink that only counts the messages it receives, the count can be read from other threads.
+ */
+class CountingSink final : public Sink {
+public:
+  explicit CountingSink(std::atomic<size_t>* count) : Sink{allLevelMask()}, m_count{count} {}
+  ~CountingSink() override = default;
+
+  auto write(const Message& /*unused*/) noexcept -> void override { ++(*m_count); }
+
+private:
+  std::atomic<size_t>* m_count;
+};
+
+/* Sink that records the size of the batches it receives.
+ */
+class BatchSink final : public Sink {
+public:
+  explicit BatchSink(std::vector<size_t>* batchSizes) :
+      Sink{allLevelMask()}, m_batchSizes{batchSizes} {}
+  ~BatchSink() override = default;
+
+  auto write(const Message& /*unused*/) noexcept -> void override { m_batchSizes->push_back(1U); }
+
+  auto writeBatch(const Message* begin, const Message* end) noexcept -> void override {
+    m_batchSizes->push_back(static_cast<size_t>(end - begin));
+  }
+
+private:
+  std::vector<size_t>* m_batchSizes;
+};
+
+} // namespace
+
 TEST_CASE("[log] - Logger", "[log]") {
 
   SECTION("Published messages arrive to sink") {
@@ -38,6 +93,32 @@ TEST_CASE("[log] - Logger", "[log]") {
                                                   {"param4", std::string{"dyn_string"}}}));
   }
 
+  SECTION("Messages with more parameters than fit inline arrive to sink") {
+    auto output = std::vector<Message>{};
+    {
+      auto logger = Logger{makeMockSink(&output)};
+      LOG_I(
+          &logger,
+          "test_message",
+          {"param1", 1},
+          {"param2", 2},
+          {"param3", 3},
+          {"param4", 4},
+          {"param5", std::string(100, 'a')},
+          {"param6", 6});
+    }
+
+    REQUIRE(output.size() == 1);
+    CHECK_THAT(
+        std::vector<Param>(output[0].begin(), output[0].end()),
+        Catch::Equals(std::vector<Param>{{"param1", 1},
+                                         {"param2", 2},
+                                         {"param3", 3},
+                                         {"param4", 4},
+                                         {"param5", std::string(100, 'a')},
+                                         {"param6", 6}}));
+  }
+
   SECTION("Messages can be published in parallel") {
     constexpr static int numThreads          = 5;
     constexpr static int numMessagePerThread = 10'000;
@@ -64,6 +145,295 @@ TEST_CASE("[log] - Logger", "[log]") {
 
     CHECK(output.size() == numThreads * numMessagePerThread);
   }
+
+  SECTION("Logger mask is the union of the sink masks") {
+    auto output = std::vector<Message>{};
+    auto logger = Logger{
+        makeMockSink(&output, levelMask(Level::Error)),
+        makeMockSink(&output, levelMask(Level::Warn))};
+    CHECK(logger.getMask() == (Level::Error | Level::Warn));
+
+    auto moved = std::move(logger);
+    CHECK(moved.getMask() == (Level::Error | Level::Warn));
+  }
+
+  SECTION("Sinks receive messages in batches") {
+    auto batchSizes = std::vector<size_t>{};
+    {
+      auto logger = Logger{std::make_unique<BatchSink>(&batchSizes)};
+      for (auto i = 0; i != 1000; ++i) {
+        LOG_I(&logger, "test_message", {"i", i});
+      }
+    }
+    CHECK(std::accumulate(batchSizes.begin(), batchSizes.end(), size_t{0}) == 1000U);
+    CHECK(std::find(batchSizes.begin(), batchSizes.end(), 0U) == batchSizes.end());
+  }
+
+  SECTION("Queue capacity is rounded up to a power of two") {
+    auto output = std::vector<Message>{};
+    auto logger = Logger{LoggerConfig{100U, OverflowPolicy::Block}, makeMockSink(&output)};
+    CHECK(logger.getStats().queueCapacity == 128U);
+  }
+
+  SECTION("Blocking overflow policy does not lose messages") {
+    auto output   = std::vector<Message>{};
+    auto released = std::atomic<bool>{false};
+    {
+      auto logger = Logger{
+          LoggerConfig{4U, OverflowPolicy::Block},
+          std::make_unique<BlockingSink>(&output, &released)};
+      auto releaser = std::thread{[&released]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        released = true;
+      }};
+      for (auto i = 0; i != 100; ++i) {
+        LOG_I(&logger, "test_message", {"i", i});
+      }
+      releaser.join();
+      CHECK(logger.getStats().getTotalDropped() == 0U);
+    }
+    CHECK(output.size() == 100U);
+  }
+
+  SECTION("Drop newest overflow policy drops and counts new messages") {
+    auto output   = std::vector<Message>{};
+    auto released = std::atomic<bool>{false};
+    auto dropped  = uint64_t{0};
+    {
+      auto logger = Logger{
+          LoggerConfig{4U, OverflowPolicy::DropNewest},
+          std::make_unique<BlockingSink>(&output, &released)};
+      for (auto i = 0; i != 100; ++i) {
+        LOG_W(&logger, "test_message", {"i", i});
+      }
+      const auto stats = logger.getStats();
+      CHECK(stats.droppedWarn > 0U);
+      CHECK(stats.droppedInfo == 0U);
+      CHECK(stats.queueHighWaterMark == 4U);
+      dropped  = stats.getTotalDropped();
+      released = true;
+    }
+    REQUIRE(!output.empty());
+    CHECK(*output[0].begin() == Param{"i", 0}); // Oldest message is kept.
+    CHECK(output.size() + dropped == 100U);
+  }
+
+  SECTION("Drop oldest overflow policy drops and counts old messages") {
+    auto output   = std::vector<Message>{};
+    auto released = std::atomic<bool>{false};
+    auto dropped  = uint64_t{0};
+    {
+      auto logger = Logger{
+          LoggerConfig{4U, OverflowPolicy::DropOldest},
+          std::make_unique<BlockingSink>(&output, &released)};
+      for (auto i = 0; i != 100; ++i) {
+        LOG_E(&logger, "test_message", {"i", i});
+      }
+      const auto stats = logger.getStats();
+      CHECK(stats.droppedError > 0U);
+      CHECK(stats.droppedWarn == 0U);
+      dropped  = stats.getTotalDropped();
+      released = true;
+    }
+    REQUIRE(!output.empty());
+    CHECK(*output.back().begin() == Param{"i", 99}); // Newest message is kept.
+    CHECK(output.size() + dropped == 100U);
+  }
+
+  SECTION("Parallel sink dispatch delivers messages in order to all sinks") {
+    auto outputA = std::vector<Message>{};
+    auto outputB = std::vector<Message>{};
+    {
+      auto logger = Logger{
+          LoggerConfig{16U, OverflowPolicy::Block, SinkDispatch::Parallel},
+          makeMockSink(&outputA),
+          makeMockSink(&outputB)};
+      for (auto i = 0; i != 1000; ++i) {
+        LOG_I(&logger, "test_message", {"i", i});
+      }
+    }
+    REQUIRE(outputA.size() == 1000U);
+    REQUIRE(outputB.size() == 1000U);
+    for (auto i = 0; i != 1000; ++i) {
+      CHECK(*outputA[i].begin() == Param{"i", i});
+      CHECK(*outputB[i].begin() == Param{"i", i});
+    }
+  }
+
+  SECTION("Parallel sink dispatch does not hold back sinks for a stalled sink") {
+    auto output   = std::vector<Message>{};
+    auto released = std::atomic<bool>{false};
+    auto count    = std::atomic<size_t>{0U};
+    {
+      auto logger = Logger{
+          LoggerConfig{16U, OverflowPolicy::Block, SinkDispatch::Parallel},
+          std::make_unique<BlockingSink>(&output, &released),
+          std::make_unique<CountingSink>(&count)};
+      for (auto i = 0; i != 10; ++i) {
+        LOG_I(&logger, "test_message", {"i", i});
+      }
+      // Would never finish if the counting sink had to wait for the blocking sink.
+      while (count != 10U) {
+        std::this_thread::yield();
+      }
+      released = true;
+    }
+    CHECK(output.size() == 10U);
+  }
+
+  SECTION("Parallel sink dispatch drops messages for a sink that falls too far behind") {
+    auto output   = std::vector<Message>{};
+    auto released = std::atomic<bool>{false};
+    auto count    = std::atomic<size_t>{0U};
+    auto dropped  = uint64_t{0U};
+    {
+      auto logger = Logger{
+          LoggerConfig{16U, OverflowPolicy::DropNewest, SinkDispatch::Parallel},
+          std::make_unique<BlockingSink>(&output, &released),
+          std::make_unique<CountingSink>(&count)};
+      for (auto i = 0; i != 1000; ++i) {
+        LOG_I(&logger, "test_message", {"i", i});
+        // Would never finish if the log thread had to wait for the blocking sink.
+        while (count != static_cast<size_t>(i) + 1U) {
+          std::this_thread::yield();
+        }
+      }
+      const auto stats = logger.getStats();
+      CHECK(stats.sinks[1].dropped == 0U);
+      dropped  = stats.sinks[0].dropped;
+      released = true;
+    }
+    CHECK(dropped > 0U);
+    CHECK(output.size() + dropped == 1000U);
+  }
+
+  SECTION("Tick timestamps are converted to wall-clock time before reaching the sinks") {
+    auto output       = std::vector<Message>{};
+    auto config       = LoggerConfig{};
+    config.timeSource = TimeSource::Ticks;
+
+    const auto before = std::chrono::system_clock::now();
+    {
+      auto logger = Logger{config, makeMockSink(&output)};
+      CHECK(logger.getTimeSource() == TimeSource::Ticks);
+      LOG_I(&logger, "test_message");
+    }
+    const auto after = std::chrono::system_clock::now();
+
+    REQUIRE(output.size() == 1U);
+    CHECK(!output[0].hasTickTime());
+    // Allow for a small error in the tick calibration.
+    const auto tolerance = std::chrono::milliseconds{1};
+    CHECK(output[0].getTime() >= before - tolerance);
+    CHECK(output[0].getTime() <= after + tolerance);
+  }
+
+  SECTION("Stats count the processed messages per level") {
+    auto count  = std::atomic<size_t>{0U};
+    auto logger = Logger{std::make_unique<CountingSink>(&count)};
+    for (auto i = 0; i != 10; ++i) {
+      LOG_I(&logger, "info_message");
+    }
+    LOG_W(&logger, "warn_message");
+    LOG_E(&logger, "error_message");
+    while (count != 12U) {
+      std::this_thread::yield();
+    }
+
+    const auto stats = logger.getStats();
+    CHECK(stats.processedDebug == 0U);
+    CHECK(stats.processedInfo == 10U);
+    CHECK(stats.processedWarn == 1U);
+    CHECK(stats.processedError == 1U);
+    CHECK(stats.getTotalProcessed() == 12U);
+    CHECK(stats.batchSize.sum == 12U);
+    CHECK(stats.batchSize.count > 0U);
+    CHECK(stats.batchSize.max <= 12U);
+  }
+
+  SECTION("Stats record the latency and write time per sink") {
+    for (const auto dispatch : {SinkDispatch::Sequential, SinkDispatch::Parallel}) {
+      auto countA = std::atomic<size_t>{0U};
+      auto countB = std::atomic<size_t>{0U};
+      auto logger = Logger{
+          LoggerConfig{16U, OverflowPolicy::Block, dispatch},
+          std::make_unique<CountingSink>(&countA),
+          std::make_unique<CountingSink>(&countB)};
+      for (auto i = 0; i != 100; ++i) {
+        LOG_I(&logger, "test_message", {"i", i});
+      }
+      while (countA != 100U || countB != 100U) {
+        std::this_thread::yield();
+      }
+      // Write time is recorded after the sink returns, wait for the last batch to be recorded.
+      auto stats = logger.getStats();
+      while (stats.sinks[0].writeTime.count != stats.batchSize.count ||
+             stats.sinks[1].writeTime.count != stats.batchSize.count) {
+        std::this_thread::yield();
+        stats = logger.getStats();
+      }
+
+      REQUIRE(stats.sinks.size() == 2U);
+      for (const auto& sink : stats.sinks) {
+        CHECK(sink.latency.count == 100U);
+        CHECK(sink.latency.getPercentile(0.5) <= sink.latency.getPercentile(0.99));
+        CHECK(sink.latency.getPercentile(1.0) == sink.latency.max);
+      }
+    }
+  }
+
+  SECTION("Stats histograms report approximate percentiles") {
+    auto histogram        = LoggerHistogram{};
+    histogram.buckets[0U] = 1U; // 0.
+    histogram.buckets[4U] = 8U; // [8, 16).
+    histogram.buckets[7U] = 1U; // [64, 128).
+    histogram.count       = 10U;
+    histogram.sum         = 170U;
+    histogram.max         = 100U;
+
+    CHECK(histogram.getMean() == Approx(17.0));
+    CHECK(histogram.getPercentile(0.0) == 0U);
+    CHECK(histogram.getPercentile(0.5) == 15U);
+    CHECK(histogram.getPercentile(0.99) == 100U);
+    CHECK(LoggerHistogram{}.getPercentile(0.5) == 0U);
+  }
+
+  SECTION("Stats are logged periodically") {
+    auto output             = std::vector<Message>{};
+    auto config             = LoggerConfig{};
+    config.statsLogInterval = std::chrono::milliseconds{1};
+    {
+      auto logger = Logger{config, makeMockSink(&output)};
+      LOG_I(&logger, "test_message");
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+
+    // Only a single stats message as no other messages were logged in the mean time.
+    auto statsMessages = std::vector<Message>{};
+    for (const auto& msg : output) {
+      if (msg.getMeta()->getTxt() == std::string{"Logger stats"}) {
+        statsMessages.push_back(msg);
+      }
+    }
+    REQUIRE(statsMessages.size() == 1U);
+    CHECK(output.size() == 2U);
+    CHECK(*statsMessages[0].begin() == Param{"processed", uint64_t{1U}});
+  }
+
+  SECTION("Parameters are not evaluated for disabled levels") {
+    auto output     = std::vector<Message>{};
+    auto evalCount  = 0;
+    const auto eval = [&evalCount]() { return ++evalCount; };
+    {
+      auto logger = Logger{makeMockSink(&output, levelMask(Level::Error))};
+      LOG_I(&logger, "info_message", {"val", eval()});
+      LOG_E(&logger, "error_message", {"val", eval()});
+    }
+
+    CHECK(evalCount == 1);
+    REQUIRE(output.size() == 1);
+    CHECK(output[0].getMeta()->getTxt() == std::string{"error_message"});
+  }
 }
 
 } // namespace tria::log::tests
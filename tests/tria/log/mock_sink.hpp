@@ -21,8 +21,8 @@ private:
   std::vector<Message>* m_msgs;
 };
 
-[[nodiscard]] auto makeMockSink(std::vector<Message>* output, LevelMask mask = allLevelMask())
-    -> SinkUnique {
+[[nodiscard]] inline auto
+makeMockSink(std::vector<Message>* output, LevelMask mask = allLevelMask()) -> SinkUnique {
   return std::make_unique<MockSink>(output, mask);
 }
 
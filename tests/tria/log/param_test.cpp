@@ -1,8 +1,16 @@
 #include "catch2/catch.hpp"
 #include "tria/log/param.hpp"
 #include "tria/math/vec.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <limits>
+#include <random>
 #include <string>
+#include <type_traits>
 
 #if defined(_WIN32)
 #define timezone _timezone
@@ -24,6 +32,33 @@ auto toStringJson(const Param& param) {
   return str;
 }
 
+template <typename FloatType>
+auto toStringFloat(FloatType value) {
+  auto str = std::string{};
+  Value{value}.write(&str, ParamWriteMode::Json);
+  return str;
+}
+
+template <typename FloatType>
+auto getBits(FloatType value) {
+  using Bits = std::conditional_t<sizeof(FloatType) == 4U, uint32_t, uint64_t>;
+  Bits bits;
+  std::memcpy(&bits, &value, sizeof(Bits));
+  return bits;
+}
+
+/* Check that the written value parses back to the exact same value.
+ */
+auto roundTrips(float value) {
+  const auto str = toStringFloat(value);
+  return getBits(std::strtof(str.c_str(), nullptr)) == getBits(value);
+}
+
+auto roundTrips(double value) {
+  const auto str = toStringFloat(value);
+  return getBits(std::strtod(str.c_str(), nullptr)) == getBits(value);
+}
+
 auto getRefTimeT(int year, int month, int day, int hour, int min, int sec) -> TimePoint {
   tm t      = {};
   t.tm_year = year - 1900;
@@ -76,12 +111,16 @@ TEST_CASE("[log] - Log parameters", "[log]") {
     CHECK(toStringPretty({"key", 42}) == "42");
     CHECK(toStringPretty({"key", 100'000'000}) == "100000000");
 
-    CHECK_THAT(toStringPretty({"key", 1.337F}), Catch::StartsWith("1.337"));
-    CHECK_THAT(toStringPretty({"key", 1.333337}), Catch::StartsWith("1.333337"));
+    CHECK(toStringPretty({"key", 1.337F}) == "1.337");
+    CHECK(toStringPretty({"key", 1.333337}) == "1.333337");
 
     CHECK(toStringPretty({"key", "Hello World"}) == "Hello World");
     CHECK(toStringPretty({"key", std::string{"Hello World"}}) == "Hello World");
     CHECK(toStringPretty({"key", std::string{"Hello\tWorld\n"}}) == "Hello\\tWorld\\n");
+    CHECK(toStringPretty({"key", std::string(100, 'a')}) == std::string(100, 'a'));
+
+    CHECK(toStringPretty({"key", fs::path{"dir/file.txt"}}) == "dir/file.txt");
+    CHECK(toStringPretty({"key", fs::path{"dir\\file.txt"}}) == "dir/file.txt");
 
     CHECK(toStringPretty({"key", 137ns}) == "137 ns");
     CHECK(toStringPretty({"key", 1337ns}) == "1.3 us");
@@ -93,6 +132,9 @@ TEST_CASE("[log] - Log parameters", "[log]") {
     CHECK(toStringPretty({"key", 42us + 51ns}) == "42.1 us");
     CHECK(toStringPretty({"key", 42us + 49ns}) == "42 us");
     CHECK(toStringPretty({"key", 1s + 900ms}) == "1.9 sec");
+    CHECK(toStringPretty({"key", Duration{-2.5e-9}}) == "-2.5 ns");
+    CHECK(toStringPretty({"key", -42ms}) == "-42 ms");
+    CHECK(toStringPretty({"key", -1s - 900ms}) == "-1.9 sec");
 
     CHECK(
         toStringPretty({"key", getRefTimeT(2020, 7, 13, 12, 36, 42)}) ==
@@ -152,13 +194,15 @@ TEST_CASE("[log] - Log parameters", "[log]") {
     CHECK(toStringJson({"key", 42}) == "42");
     CHECK(toStringJson({"key", 100'000'000}) == "100000000");
 
-    CHECK_THAT(toStringJson({"key", 1.337F}), Catch::StartsWith("1.337"));
-    CHECK_THAT(toStringJson({"key", 1.333337}), Catch::StartsWith("1.333337"));
+    CHECK(toStringJson({"key", 1.337F}) == "1.337");
+    CHECK(toStringJson({"key", 1.333337}) == "1.333337");
 
     CHECK(toStringJson({"key", "Hello World"}) == "\"Hello World\"");
     CHECK(toStringJson({"key", std::string{"Hello World"}}) == "\"Hello World\"");
     CHECK(toStringJson({"key", std::string{"Hello\tWorld\n"}}) == "\"Hello\\tWorld\\n\"");
 
+    CHECK(toStringJson({"key", fs::path{"dir/file.txt"}}) == "\"dir/file.txt\"");
+
     CHECK(toStringJson({"key", 42ns}) == "42");
     CHECK(toStringJson({"key", 42us}) == "42000");
     CHECK(toStringJson({"key", 42ms}) == "42000000");
@@ -189,6 +233,197 @@ TEST_CASE("[log] - Log parameters", "[log]") {
   }
 }
 
+TEST_CASE("[log] - Inline string", "[log]") {
+
+  SECTION("Short strings are stored inline") {
+    const auto str = InlineStr{"Hello World"};
+    CHECK(str.isInline());
+    CHECK(str.view() == "Hello World");
+  }
+
+  SECTION("Long strings are stored on the heap") {
+    const auto longStr = std::string(100, 'a');
+    const auto str     = InlineStr{longStr};
+    CHECK(!str.isInline());
+    CHECK(str.view() == longStr);
+  }
+
+  SECTION("Strings can be copied and moved") {
+    const auto longStr = std::string(100, 'a');
+    for (const auto& input : {std::string{"Hello World"}, longStr}) {
+      auto str  = InlineStr{input};
+      auto copy = str;
+      CHECK(copy == str);
+
+      auto moved = std::move(str);
+      CHECK(moved.view() == input);
+
+      copy = InlineStr{"Other"};
+      CHECK(copy.view() == "Other");
+
+      copy = std::move(moved);
+      CHECK(copy.view() == input);
+    }
+  }
+}
+
+TEST_CASE("[log] - Borrowed strings", "[log]") {
+
+  SECTION("Borrowed strings reference the original string") {
+    const auto longStr = std::string(100, 'a');
+    const auto str     = InlineStr::borrow(longStr);
+    CHECK(str.isBorrowed());
+    CHECK(!str.isInline());
+    CHECK(str.view().data() == longStr.data());
+
+    // Copies reference the original string as well.
+    auto copy = str;
+    CHECK(copy.isBorrowed());
+    CHECK(copy.view().data() == longStr.data());
+
+    copy = InlineStr{"Other"};
+    CHECK(copy.isInline());
+    copy = str;
+    CHECK(copy.view().data() == longStr.data());
+  }
+
+  SECTION("Static strings are written the same as strings") {
+    const auto longStr = std::string(100, 'a');
+    for (const auto mode : {ParamWriteMode::Pretty, ParamWriteMode::Json, ParamWriteMode::Binary}) {
+      for (const auto& input : {std::string{"Hello \"World\""}, longStr}) {
+        auto expected = std::string{};
+        Value{input}.write(&expected, mode);
+        auto actual = std::string{};
+        Value{StaticStr{input}}.write(&actual, mode);
+        CHECK(actual == expected);
+      }
+    }
+    CHECK(Value{StaticStr{"Hello World"}} == Value{"Hello World"});
+  }
+
+  SECTION("Short paths are stored inline") {
+    const auto path = PathStr{fs::path{"a/b.txt"}};
+    CHECK(!path.isInterned());
+    CHECK(path.view() == "a/b.txt");
+  }
+
+  SECTION("Long paths are interned") {
+    const auto rawPath = std::string{"assets/textures/environment/skybox_front_4k.png"};
+    const auto pathA   = PathStr{fs::path{rawPath}};
+    const auto pathB   = PathStr{fs::path{rawPath}};
+    CHECK(pathA.isInterned());
+    CHECK(pathA.view() == rawPath);
+    CHECK(pathA.view().data() == pathB.view().data());
+
+    auto str = std::string{};
+    Value{fs::path{rawPath}}.write(&str, ParamWriteMode::Json);
+    CHECK(str == "\"" + rawPath + "\"");
+  }
+}
+
+TEST_CASE("[log] - Timestamp formatting", "[log]") {
+
+  auto toIsoStr = [](TimePoint time) {
+    auto str = std::string{};
+    Value{time}.write(&str, ParamWriteMode::Pretty);
+    return str;
+  };
+
+  SECTION("Calendar edge cases are formatted correctly") {
+    using namespace std::chrono;
+    CHECK(toIsoStr(TimePoint{}) == "1970-01-01T00:00:00.000000Z");
+    CHECK(toIsoStr(TimePoint{} - 1us) == "1969-12-31T23:59:59.999999Z");
+    CHECK(toIsoStr(getRefTimeT(2020, 2, 29, 23, 59, 59)) == "2020-02-29T23:59:59.000000Z");
+    CHECK(toIsoStr(getRefTimeT(2020, 12, 31, 23, 59, 59) + 1s) == "2021-01-01T00:00:00.000000Z");
+    CHECK(toIsoStr(getRefTimeT(2100, 3, 1, 0, 0, 0) - 1s) == "2100-02-28T23:59:59.000000Z");
+    CHECK(toIsoStr(getRefTimeT(2000, 2, 29, 12, 0, 0)) == "2000-02-29T12:00:00.000000Z");
+  }
+
+  SECTION("Formatting matches strftime for sampled timestamps") {
+    auto rng = std::mt19937_64{42};
+    // Note: Up to the year 2255 as the system clock is commonly 64 bit nanoseconds.
+    auto dis = std::uniform_int_distribution<int64_t>{0, 9'000'000'000};
+    for (auto i = 0; i != 10'000; ++i) {
+      const auto secs = static_cast<std::time_t>(dis(rng));
+
+      auto expected = std::array<char, 32>{};
+      std::strftime(expected.data(), expected.size(), "%Y-%m-%dT%H:%M:%S", std::gmtime(&secs));
+
+      const auto str = toIsoStr(std::chrono::system_clock::from_time_t(secs));
+      REQUIRE(str == std::string{expected.data()} + ".000000Z");
+    }
+  }
+}
+
+TEST_CASE("[log] - Floating point formatting", "[log]") {
+
+  SECTION("Values are written in the shortest representation") {
+    CHECK(toStringFloat(0.0) == "0");
+    CHECK(toStringFloat(-0.0) == "-0");
+    CHECK(toStringFloat(0.1) == "0.1");
+    CHECK(toStringFloat(0.1F) == "0.1");
+    CHECK(toStringFloat(-42.5) == "-42.5");
+    CHECK(toStringFloat(1337.0) == "1337");
+    CHECK(toStringFloat(1.0 / 3.0) == "0.3333333333333333");
+    CHECK(toStringFloat(1.0F / 3.0F) == "0.33333334");
+    CHECK(toStringFloat(0.001) == "0.001");
+    CHECK(toStringFloat(1e-5) == "1e-05");
+    CHECK(toStringFloat(123456789.0) == "123456789");
+    CHECK(toStringFloat(1e17) == "1e+17");
+    CHECK(toStringFloat(1.5e300) == "1.5e+300");
+    CHECK(toStringFloat(std::numeric_limits<double>::max()) == "1.7976931348623157e+308");
+    CHECK(toStringFloat(std::numeric_limits<double>::denorm_min()) == "5e-324");
+    CHECK(toStringFloat(std::numeric_limits<float>::max()) == "3.4028235e+38");
+    CHECK(toStringFloat(std::numeric_limits<float>::denorm_min()) == "1e-45");
+  }
+
+  SECTION("Non-finite values are written") {
+    CHECK(toStringFloat(std::numeric_limits<double>::quiet_NaN()) == "nan");
+    CHECK(toStringFloat(std::numeric_limits<double>::infinity()) == "inf");
+    CHECK(toStringFloat(-std::numeric_limits<float>::infinity()) == "-inf");
+  }
+
+  SECTION("Sampled doubles round-trip") {
+    auto rng = std::mt19937_64{42};
+    for (auto i = 0; i != 100'000; ++i) {
+      auto value      = double{};
+      const auto bits = rng();
+      std::memcpy(&value, &bits, sizeof(double));
+      if (std::isfinite(value)) {
+        REQUIRE(roundTrips(value));
+      }
+    }
+  }
+
+  SECTION("Sampled floats round-trip") {
+    auto rng = std::mt19937{42};
+    for (auto i = 0; i != 100'000; ++i) {
+      auto value      = float{};
+      const auto bits = static_cast<uint32_t>(rng());
+      std::memcpy(&value, &bits, sizeof(float));
+      if (std::isfinite(value)) {
+        REQUIRE(roundTrips(value));
+      }
+    }
+  }
+}
+
+/* Checks all 2^32 floats, hidden as it takes minutes to run:
+ * $ tria_tests [exhaustive]
+ */
+TEST_CASE("[log] - Floating point formatting exhaustive", "[.][exhaustive]") {
+  auto failures = 0U;
+  auto bits     = uint32_t{0U};
+  do {
+    auto value = float{};
+    std::memcpy(&value, &bits, sizeof(float));
+    if (std::isfinite(value) && !roundTrips(value)) {
+      ++failures;
+    }
+  } while (++bits != 0U);
+  CHECK(failures == 0U);
+}
+
 } // namespace tests
 
 } // namespace tria::log
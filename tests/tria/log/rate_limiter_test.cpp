@@ -0,0 +1,149 @@
+#include "catch2/catch.hpp"
+#include "mock_sink.hpp"
+#include "tria/log/api.hpp"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tria::log::tests {
+
+namespace {
+
+/* Rate limited call-site that is shared between loggers.
+ */
+auto logSharedCallSite(Logger* logger) {
+  for (auto i = 0; i != 5; ++i) {
+    LOG_W_RATE(logger, oneIn(100U), "test_message");
+  }
+}
+
+} // namespace
+
+TEST_CASE("[log] - Rate limiter", "[log]") {
+
+  SECTION("Sampling allows one in every n messages") {
+    auto limiter    = RateLimiter{oneIn(10U)};
+    auto allowed    = 0U;
+    auto suppressed = uint64_t{0};
+    for (auto i = 0U; i != 100U; ++i) {
+      if (limiter.tryAcquire(&suppressed)) {
+        CHECK(suppressed == (i == 0U ? 0U : 9U));
+        ++allowed;
+      }
+    }
+    CHECK(allowed == 10U);
+  }
+
+  SECTION("Per second limit allows up to n messages per second") {
+    auto limiter    = RateLimiter{perSecond(5U)};
+    auto allowed    = 0U;
+    auto suppressed = uint64_t{0};
+    for (auto i = 0U; i != 1000U; ++i) {
+      if (limiter.tryAcquire(&suppressed)) {
+        ++allowed;
+      }
+    }
+    // Note: Loop could cross a second boundary, in which case a new second starts.
+    CHECK(allowed >= 5U);
+    CHECK(allowed <= 10U);
+  }
+
+  SECTION("Rate limited log messages report the suppressed count") {
+    auto output = std::vector<Message>{};
+    {
+      auto logger = Logger{makeMockSink(&output)};
+      for (auto i = 0; i != 25; ++i) {
+        LOG_W_RATE(&logger, oneIn(10U), "test_message", {"i", i});
+      }
+    }
+
+    // Messages 0, 10 and 20 are allowed, 10 and 20 are preceded by a summary and the messages
+    // suppressed after 20 are reported when the logger shuts down.
+    REQUIRE(output.size() == 6U);
+    CHECK(output[0].getMeta()->getTxt() == std::string{"test_message"});
+    CHECK(output[1].getMeta()->getTxt() == std::string{"Suppressed log messages"});
+    CHECK(output[1].getMeta()->getLevel() == Level::Warn);
+    CHECK_THAT(
+        std::vector<Param>(output[1].begin(), output[1].end()),
+        Catch::Equals(std::vector<Param>{{"message", "test_message"}, {"suppressed", 9U}}));
+    CHECK(output[2].getMeta()->getTxt() == std::string{"test_message"});
+    CHECK(*output[2].begin() == Param{"i", 10});
+    CHECK(output[5].getMeta()->getTxt() == std::string{"Suppressed log messages"});
+    CHECK(*(output[5].begin() + 1) == Param{"suppressed", 4U});
+  }
+
+  SECTION("Suppressed messages are reported periodically when the call-site stays quiet") {
+    auto output                = std::vector<Message>{};
+    auto config                = LoggerConfig{};
+    config.rateSummaryInterval = std::chrono::milliseconds{1};
+    {
+      auto logger = Logger{config, makeMockSink(&output)};
+      for (auto i = 0; i != 5; ++i) {
+        LOG_W_RATE(&logger, oneIn(10U), "test_message");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      LOG_I(&logger, "other_message");
+    }
+
+    REQUIRE(output.size() == 3U);
+    CHECK(output[0].getMeta()->getTxt() == std::string{"test_message"});
+    CHECK(output[1].getMeta()->getTxt() == std::string{"Suppressed log messages"});
+    CHECK(*(output[1].begin() + 1) == Param{"suppressed", 4U});
+    CHECK(output[2].getMeta()->getTxt() == std::string{"other_message"});
+  }
+
+  SECTION("Suppressed messages are only reported before allowed messages without an interval") {
+    auto output                = std::vector<Message>{};
+    auto config                = LoggerConfig{};
+    config.rateSummaryInterval = std::chrono::milliseconds{0};
+    {
+      auto logger = Logger{config, makeMockSink(&output)};
+      for (auto i = 0; i != 25; ++i) {
+        LOG_W_RATE(&logger, oneIn(10U), "test_message");
+      }
+    }
+    CHECK(output.size() == 5U);
+  }
+
+  SECTION("Call-sites shared between loggers are reported by the next logger that tracks them") {
+    auto outputA = std::vector<Message>{};
+    auto outputB = std::vector<Message>{};
+    auto outputC = std::vector<Message>{};
+    {
+      auto config                = LoggerConfig{};
+      config.rateSummaryInterval = std::chrono::milliseconds{0};
+      auto logger                = Logger{config, makeMockSink(&outputA)};
+      logSharedCallSite(&logger);
+    }
+    {
+      auto logger = Logger{makeMockSink(&outputB)};
+      logSharedCallSite(&logger);
+    }
+    {
+      auto logger = Logger{makeMockSink(&outputC)};
+      logSharedCallSite(&logger);
+    }
+
+    // Logger without an interval does not track the call-site, suppressed counts belong to the
+    // call-site so the next logger that tracks it reports them.
+    CHECK(outputA.size() == 1U);
+    REQUIRE(outputB.size() == 1U);
+    CHECK(*(outputB[0].begin() + 1) == Param{"suppressed", 9U});
+    REQUIRE(outputC.size() == 1U);
+    CHECK(*(outputC[0].begin() + 1) == Param{"suppressed", 5U});
+  }
+
+  SECTION("Rate limited messages for disabled levels are not counted") {
+    auto output = std::vector<Message>{};
+    {
+      auto logger = Logger{makeMockSink(&output, levelMask(Level::Error))};
+      for (auto i = 0; i != 25; ++i) {
+        LOG_W_RATE(&logger, oneIn(10U), "test_message");
+      }
+    }
+    CHECK(output.empty());
+  }
+}
+
+} // namespace tria::log::tests
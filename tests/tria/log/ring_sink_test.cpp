@@ -0,0 +1,218 @@
+#include "catch2/catch.hpp"
+#include "tria/log/api.hpp"
+#include "tria/log/err/log_decode_err.hpp"
+#include "tria/log/ring_reader.hpp"
+#include "tria/pal/utils.hpp"
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tria::log::tests {
+
+namespace {
+
+constexpr static auto g_infoMeta =
+    MetaData{Level::Info, "info_message", __FILE__, "testFunc", __LINE__};
+constexpr static auto g_errorMeta =
+    MetaData{Level::Error, "error_message", __FILE__, "testFunc", __LINE__};
+
+/* Copy of a read message, read messages reference data owned by the reader so they cannot be
+ * stored directly.
+ */
+struct ReadMsg final {
+  Level lvl;
+  std::string txt;
+  std::string params; // Parameters written as 'key=value' pairs, values in json format.
+  int64_t index;      // Value of the 'i' parameter, -1 if missing.
+};
+
+class ReadSink final : public Sink {
+public:
+  explicit ReadSink(std::vector<ReadMsg>* output, LevelMask mask = allLevelMask()) :
+      Sink{mask}, m_output{output} {}
+  ~ReadSink() override = default;
+
+  auto write(const Message& msg) noexcept -> void override {
+    auto result = ReadMsg{
+        msg.getMeta()->getLevel(), std::string{msg.getMeta()->getTxt()}, std::string{}, -1};
+    for (const auto& param : msg) {
+      auto val = std::string{};
+      param.writeValue(&val, ParamWriteMode::Json);
+      if (param.getKey() == "i") {
+        result.index = std::stoll(val);
+      }
+      if (!result.params.empty()) {
+        result.params += ' ';
+      }
+      result.params += std::string{param.getKey()} + '=' + val;
+    }
+    m_output->push_back(std::move(result));
+  }
+
+private:
+  std::vector<ReadMsg>* m_output;
+};
+
+template <typename TestFunc>
+auto withTempFile(TestFunc func) {
+  const auto path = pal::getCurExecutablePath().parent_path() / "tria_log_ring_test.tring";
+  try {
+    func(path);
+    fs::remove(path);
+  } catch (...) {
+    fs::remove(path);
+    throw;
+  }
+}
+
+} // namespace
+
+TEST_CASE("[log] - Shared ring sink", "[log]") {
+
+  SECTION("Published messages can be read back") {
+    withTempFile([](const fs::path& path) {
+      auto sink = makeSharedRingSink(path);
+      sink->write(Message{&g_infoMeta, {{"i", 0}, {"str", "Hello World"}, {"flt", 0.5}}});
+      sink->write(Message{&g_errorMeta, {{"i", 1}, {"list", std::vector<int>{1, 2, 3}}}});
+
+      auto reader   = RingReader{path};
+      auto output   = std::vector<ReadMsg>{};
+      auto readSink = ReadSink{&output};
+      CHECK(reader.poll(&readSink) == 2U);
+      REQUIRE(output.size() == 2U);
+      CHECK(output[0].lvl == Level::Info);
+      CHECK(output[0].txt == "info_message");
+      CHECK(output[0].params == "i=0 str=\"Hello World\" flt=0.5");
+      CHECK(output[1].lvl == Level::Error);
+      CHECK(output[1].txt == "error_message");
+      CHECK(output[1].params == "i=1 list=[1, 2, 3]");
+      CHECK(reader.getLostCount() == 0U);
+    });
+  }
+
+  SECTION("Polling only returns newly published messages") {
+    withTempFile([](const fs::path& path) {
+      auto sink     = makeSharedRingSink(path);
+      auto reader   = RingReader{path};
+      auto output   = std::vector<ReadMsg>{};
+      auto readSink = ReadSink{&output};
+      CHECK(reader.poll(&readSink) == 0U);
+
+      sink->write(Message{&g_infoMeta, {{"i", 0}}});
+      CHECK(reader.poll(&readSink) == 1U);
+      CHECK(reader.poll(&readSink) == 0U);
+
+      sink->write(Message{&g_infoMeta, {{"i", 1}}});
+      sink->write(Message{&g_errorMeta, {{"i", 2}}});
+      CHECK(reader.poll(&readSink) == 2U);
+      REQUIRE(output.size() == 3U);
+      CHECK(output[2].index == 2);
+    });
+  }
+
+  SECTION("Messages that are not in the mask of the reading sink are skipped") {
+    withTempFile([](const fs::path& path) {
+      auto sink = makeSharedRingSink(path);
+      sink->write(Message{&g_infoMeta, {{"i", 0}}});
+      sink->write(Message{&g_errorMeta, {{"i", 1}}});
+
+      auto reader   = RingReader{path};
+      auto output   = std::vector<ReadMsg>{};
+      auto readSink = ReadSink{&output, levelMask(Level::Error)};
+      CHECK(reader.poll(&readSink) == 1U);
+      REQUIRE(output.size() == 1U);
+      CHECK(output[0].index == 1);
+    });
+  }
+
+  SECTION("Overwritten messages are counted as lost") {
+    withTempFile([](const fs::path& path) {
+      auto sink     = makeSharedRingSink(path, allLevelMask(), 4U * 1024U);
+      auto reader   = RingReader{path};
+      auto output   = std::vector<ReadMsg>{};
+      auto readSink = ReadSink{&output};
+      for (auto i = 0; i != 1000; ++i) {
+        sink->write(Message{&g_infoMeta, {{"i", i}, {"str", "Hello World"}}});
+      }
+      reader.poll(&readSink);
+
+      // Only the newest messages remain in the ring.
+      REQUIRE(!output.empty());
+      CHECK(output.size() < 1000U);
+      CHECK(output.back().index == 999);
+      CHECK(output.size() + reader.getLostCount() == 1000U);
+      for (auto i = 1U; i < output.size(); ++i) {
+        CHECK(output[i].index == output[i - 1U].index + 1);
+      }
+    });
+  }
+
+  SECTION("Messages that do not fit are dropped") {
+    withTempFile([](const fs::path& path) {
+      auto sink = makeSharedRingSink(path, allLevelMask(), 4U * 1024U, 128U);
+      sink->write(Message{&g_infoMeta, {{"i", 0}}});
+      sink->write(Message{&g_infoMeta, {{"i", 1}, {"str", std::string(2048U, 'a')}}});
+      sink->write(Message{&g_infoMeta, {{"i", 2}, {std::string(128U, 'k'), 42}}});
+      sink->write(Message{&g_infoMeta, {{"i", 3}}});
+
+      auto reader   = RingReader{path};
+      auto output   = std::vector<ReadMsg>{};
+      auto readSink = ReadSink{&output};
+      CHECK(reader.poll(&readSink) == 2U);
+      REQUIRE(output.size() == 2U);
+      CHECK(output[0].index == 0);
+      CHECK(output[1].index == 3);
+      CHECK(reader.getLostCount() == 2U);
+    });
+  }
+
+  SECTION("Messages can be followed while they are being published") {
+    withTempFile([](const fs::path& path) {
+      constexpr auto msgCount = 10'000;
+
+      auto sink     = makeSharedRingSink(path, allLevelMask(), 16U * 1024U);
+      auto reader   = RingReader{path};
+      auto output   = std::vector<ReadMsg>{};
+      auto readSink = ReadSink{&output};
+
+      auto writer = std::thread{[&sink]() {
+        for (auto i = 0; i != msgCount; ++i) {
+          sink->write(Message{&g_infoMeta, {{"i", i}, {"str", "Hello World"}}});
+        }
+        sink.reset();
+      }};
+      while (true) {
+        const auto closed = reader.isWriterClosed();
+        reader.poll(&readSink);
+        if (closed) {
+          break;
+        }
+        std::this_thread::yield();
+      }
+      writer.join();
+
+      REQUIRE(!output.empty());
+      CHECK(output.back().index == msgCount - 1);
+      CHECK(output.size() + reader.getLostCount() == msgCount);
+      auto inOrder = true;
+      for (auto i = 1U; i < output.size(); ++i) {
+        inOrder &= output[i].index > output[i - 1U].index;
+        inOrder &= output[i].params.find("str=\"Hello World\"") != std::string::npos;
+      }
+      CHECK(inOrder);
+    });
+  }
+
+  SECTION("Reading a file that is not a shared ring log throws") {
+    withTempFile([](const fs::path& path) {
+      {
+        auto file = std::ofstream{path.string(), std::ios::binary};
+        file << std::string(1024U, 'a');
+      }
+      CHECK_THROWS_AS(RingReader{path}, err::LogDecodeErr);
+    });
+  }
+}
+
+} // namespace tria::log::tests
@@ -0,0 +1,180 @@
+#include "catch2/catch.hpp"
+#include "tria/log/api.hpp"
+#include "tria/log/metadata.hpp"
+#include "tria/pal/utils.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace tria::log::tests {
+
+namespace {
+
+constexpr static auto g_benchMeta =
+    MetaData{Level::Info, "bench_message", __FILE__, "benchFunc", __LINE__};
+
+[[nodiscard]] auto makeBenchMsg() {
+  return Message{
+      &g_benchMeta,
+      {{"int", 42}, {"double", 1337.42}, {"str", "Hello World"}, {"path", fs::path{"a/b.txt"}}}};
+}
+
+/* Copy of the previous timestamp formatting (strftime based), used as a reference.
+ */
+auto writeIsoTimeLegacy(std::string* str, TimePoint value) noexcept {
+  using namespace std::chrono;
+
+  const auto time         = system_clock::to_time_t(value);
+  const auto remMicroSecs = duration_cast<microseconds>(value - system_clock::from_time_t(time));
+
+  constexpr auto bufferSize = 28;
+  auto buffer               = std::array<char, bufferSize>{};
+  std::strftime(buffer.data(), bufferSize, "%Y-%m-%dT%H:%M:%S.", std::gmtime(&time));
+  std::snprintf(
+      buffer.data() + 20, bufferSize - 20, "%06lld", static_cast<long long>(remMicroSecs.count()));
+  buffer[26] = 'Z';
+  str->append(buffer.data(), bufferSize - 1);
+}
+
+/* Copy of the previous floating point formatting (snprintf based), used as a reference.
+ */
+auto writeDoubleLegacy(std::string* str, double value) noexcept {
+  const auto size = std::snprintf(nullptr, 0, "%.10g", value);
+  auto buffer     = static_cast<char*>(alloca(size + 1));
+  std::snprintf(buffer, size + 1, "%.10g", value);
+  str->append(buffer, static_cast<size_t>(size));
+}
+
+} // namespace
+
+TEST_CASE("[log] - Sink benchmark", "[.][benchmark]") {
+
+  const auto dir        = pal::getCurExecutablePath().parent_path();
+  const auto jsonPath   = dir / "tria_log_bench.log";
+  const auto prettyPath = dir / "tria_log_bench_pretty.log";
+  const auto binaryPath = dir / "tria_log_bench.tlog";
+  const auto lzPath     = dir / "tria_log_bench_lz.log";
+  const auto msg        = makeBenchMsg();
+
+  SECTION("Per message write cost") {
+    {
+      auto jsonSink   = makeFileJsonSink(jsonPath);
+      auto prettySink = makeFilePrettySink(prettyPath);
+      auto binarySink = makeFileBinarySink(binaryPath);
+
+      BENCHMARK("json sink") { jsonSink->write(msg); };
+      BENCHMARK("pretty sink") { prettySink->write(msg); };
+      BENCHMARK("binary sink") { binarySink->write(msg); };
+    }
+  }
+
+  SECTION("Batch write cost") {
+    constexpr auto batchSize = 64U;
+    const auto batch         = std::vector<Message>(batchSize, msg);
+    {
+      auto jsonSink = makeFileJsonSink(jsonPath);
+
+      BENCHMARK("json sink (" + std::to_string(batchSize) + " individual writes)") {
+        for (const auto& batchMsg : batch) {
+          jsonSink->write(batchMsg);
+        }
+      };
+      BENCHMARK("json sink (batch of " + std::to_string(batchSize) + ")") {
+        jsonSink->writeBatch(batch.data(), batch.data() + batch.size());
+      };
+    }
+  }
+
+  SECTION("Timestamp formatting") {
+    auto str  = std::string{};
+    auto time = std::chrono::system_clock::now();
+
+    BENCHMARK("legacy strftime") {
+      str.clear();
+      time += std::chrono::microseconds{7};
+      writeIsoTimeLegacy(&str, time);
+      return str.size();
+    };
+
+    BENCHMARK("timepoint value") {
+      str.clear();
+      time += std::chrono::microseconds{7};
+      Value{time}.write(&str, ParamWriteMode::Json);
+      return str.size();
+    };
+  }
+
+  SECTION("Floating point formatting") {
+    auto str   = std::string{};
+    auto value = 1337.42;
+
+    BENCHMARK("legacy snprintf") {
+      str.clear();
+      value *= 1.0001;
+      writeDoubleLegacy(&str, value);
+      return str.size();
+    };
+
+    BENCHMARK("double value") {
+      str.clear();
+      value *= 1.0001;
+      Value{value}.write(&str, ParamWriteMode::Json);
+      return str.size();
+    };
+
+    BENCHMARK("float value") {
+      str.clear();
+      value *= 1.0001;
+      Value{static_cast<float>(value)}.write(&str, ParamWriteMode::Json);
+      return str.size();
+    };
+  }
+
+  SECTION("Bytes per message") {
+    constexpr auto msgCount = 1000U;
+    {
+      auto jsonSink   = makeFileJsonSink(jsonPath);
+      auto prettySink = makeFilePrettySink(prettyPath);
+      auto binarySink = makeFileBinarySink(binaryPath);
+      for (auto i = 0U; i != msgCount; ++i) {
+        jsonSink->write(msg);
+        prettySink->write(msg);
+        binarySink->write(msg);
+      }
+    }
+    WARN(
+        "bytes per message: json " + std::to_string(fs::file_size(jsonPath) / msgCount) +
+        ", pretty " + std::to_string(fs::file_size(prettyPath) / msgCount) + ", binary " +
+        std::to_string(fs::file_size(binaryPath) / msgCount));
+  }
+
+  SECTION("Compression") {
+    constexpr auto batchSize = 64U;
+    const auto batch         = std::vector<Message>(batchSize, msg);
+    {
+      auto jsonSink = makeFileJsonSink(jsonPath);
+      auto lzSink   = makeFileJsonSink(
+          lzPath, allLevelMask(), flushPerBatch(), noRotation(), Compression::Lz);
+
+      BENCHMARK("json sink (batch of " + std::to_string(batchSize) + ")") {
+        jsonSink->writeBatch(batch.data(), batch.data() + batch.size());
+      };
+      BENCHMARK("json sink lz (batch of " + std::to_string(batchSize) + ")") {
+        lzSink->writeBatch(batch.data(), batch.data() + batch.size());
+      };
+    }
+    WARN(
+        "bytes written: json " + std::to_string(fs::file_size(jsonPath)) + ", json lz " +
+        std::to_string(fs::file_size(lzPath)));
+  }
+
+  fs::remove(jsonPath);
+  fs::remove(prettyPath);
+  fs::remove(binaryPath);
+  fs::remove(lzPath);
+}
+
+} // namespace tria::log::tests
@@ -0,0 +1,145 @@
+#include "catch2/catch.hpp"
+#include "tria/math/lz.hpp"
+#include "tria/math/rnd.hpp"
+#include <string>
+#include <vector>
+
+namespace tria::math::tests {
+
+namespace {
+
+[[nodiscard]] auto compress(LzCompressor* compressor, const std::string& data) {
+  auto result = std::vector<uint8_t>(lzCompressBound(data.size()));
+  result.resize(compressor->compress(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size(), result.data()));
+  return result;
+}
+
+[[nodiscard]] auto decompress(
+    LzDecompressor* decompressor, const std::vector<uint8_t>& data, size_t rawSize) {
+  const auto* result = decompressor->decompress(data.data(), data.size(), rawSize);
+  return result ? std::string{reinterpret_cast<const char*>(result), rawSize} : std::string{};
+}
+
+[[nodiscard]] auto makeRandomData(size_t size) {
+  auto rng    = RngXorWow{42};
+  auto result = std::string(size, '\0');
+  for (auto& c : result) {
+    c = static_cast<char>(rndSample(rng, 0, 256));
+  }
+  return result;
+}
+
+[[nodiscard]] auto makeLogLine(int index) {
+  return "{ \"message\": \"Frame rendered\", \"level\": \"inf\", \"file\": \"/src/renderer.cpp\", "
+         "\"extra\": { \"frame\": " +
+      std::to_string(index) + " } }\n";
+}
+
+} // namespace
+
+TEST_CASE("[math] - Lz compression", "[math]") {
+
+  SECTION("Data round-trips") {
+    auto text = std::string{};
+    for (auto i = 0; i != 100; ++i) {
+      text += makeLogLine(i);
+    }
+    for (const auto& data :
+         {std::string{}, std::string{"a"}, std::string{"Hello World"}, std::string(1000U, 'a'),
+          text, makeRandomData(1000U)}) {
+      auto compressor   = LzCompressor{};
+      auto decompressor = LzDecompressor{};
+      CHECK(decompress(&decompressor, compress(&compressor, data), data.size()) == data);
+    }
+  }
+
+  SECTION("Empty blocks decompress") {
+    auto compressor   = LzCompressor{};
+    auto decompressor = LzDecompressor{};
+    const auto empty  = compress(&compressor, std::string{});
+    CHECK(empty.size() == 1U);
+    CHECK(decompressor.decompress(empty.data(), empty.size(), 0U) != nullptr);
+
+    // Empty blocks do not disturb the stream.
+    const auto line = makeLogLine(0);
+    CHECK(decompress(&decompressor, compress(&compressor, line), line.size()) == line);
+    const auto emptyAgain = compress(&compressor, std::string{});
+    CHECK(decompressor.decompress(emptyAgain.data(), emptyAgain.size(), 0U) != nullptr);
+    CHECK(decompress(&decompressor, compress(&compressor, line), line.size()) == line);
+  }
+
+  SECTION("Repetitive data is compressed") {
+    auto text = std::string{};
+    for (auto i = 0; i != 100; ++i) {
+      text += makeLogLine(i);
+    }
+    auto compressor = LzCompressor{};
+    CHECK(compress(&compressor, std::string(1000U, 'a')).size() < 20U);
+    CHECK(compress(&compressor, text).size() < text.size() / 4U);
+  }
+
+  SECTION("Random data only grows by the bound") {
+    const auto data = makeRandomData(10'000U);
+    auto compressor = LzCompressor{};
+    CHECK(compress(&compressor, data).size() <= lzCompressBound(data.size()));
+  }
+
+  SECTION("Blocks reference the data of previous blocks") {
+    auto compressor   = LzCompressor{};
+    auto decompressor = LzDecompressor{};
+    auto totalSize    = size_t{0U};
+    auto totalRaw     = size_t{0U};
+    for (auto i = 0; i != 2000; ++i) {
+      const auto line       = makeLogLine(i);
+      const auto compressed = compress(&compressor, line);
+      totalSize += compressed.size();
+      totalRaw += line.size();
+      REQUIRE(decompress(&decompressor, compressed, line.size()) == line);
+    }
+    // Lines compressed on their own do not get smaller, as part of a stream they do.
+    CHECK(totalSize < totalRaw / 3U);
+  }
+
+  SECTION("Streams can span more than the window size") {
+    auto compressor   = LzCompressor{};
+    auto decompressor = LzDecompressor{};
+    const auto random = makeRandomData(g_lzWindowSize / 2U);
+    for (auto i = 0; i != 10; ++i) {
+      const auto block = random + std::to_string(i) + random;
+      REQUIRE(decompress(&decompressor, compress(&compressor, block), block.size()) == block);
+    }
+  }
+
+  SECTION("Reset starts a new stream") {
+    auto compressor   = LzCompressor{};
+    auto decompressor = LzDecompressor{};
+    const auto line   = makeLogLine(0);
+    CHECK(decompress(&decompressor, compress(&compressor, line), line.size()) == line);
+
+    compressor.reset();
+    auto newDecompressor = LzDecompressor{};
+    CHECK(decompress(&newDecompressor, compress(&compressor, line), line.size()) == line);
+  }
+
+  SECTION("Corrupt data fails to decompress") {
+    const auto data   = std::string(1000U, 'a') + "Hello World";
+    auto compressor   = LzCompressor{};
+    const auto valid  = compress(&compressor, data);
+    auto decompressor = LzDecompressor{};
+
+    // Wrong size.
+    CHECK(decompressor.decompress(valid.data(), valid.size(), data.size() + 1U) == nullptr);
+    CHECK(decompressor.decompress(valid.data(), valid.size(), data.size() - 1U) == nullptr);
+
+    // Truncated.
+    CHECK(decompressor.decompress(valid.data(), valid.size() - 1U, data.size()) == nullptr);
+    CHECK(decompressor.decompress(valid.data(), 0U, data.size()) == nullptr);
+
+    // Offset beyond the start of the stream.
+    const auto invalidOffset = std::vector<uint8_t>{0x10, 'a', 0xFF, 0x00, 0x00};
+    CHECK(decompressor.decompress(invalidOffset.data(), invalidOffset.size(), 5U) == nullptr);
+  }
+}
+
+} // namespace tria::math::tests